@@ -99,6 +99,8 @@ void Maze::printConfig(){
 		config << "<blockList color=\"255,255,255\" size=\"1,1,1\" blockSize=\"71,71,65\" > \n";
 
 		config << "</blockList> \n";
+		// Wireless signals are attenuated by 12 dB per wall they cross
+		config << "<wireless wallAttenuation=\"12\"/> \n";
 		config << "<obstacleList color=\"255,0,0\" > \n";
 		config.close();
 	}
@@ -6,6 +6,7 @@
 #include "scheduler.h"
 #include "network.h"
 #include "lattice.h"
+#include "checkpoint.h"
 
 #include "MRMazeBlockCode.h"
 
@@ -86,6 +87,11 @@ void MRMazeBlockCode::processLocalEvent(EventPtr pev) {
 	}
 }
 
+bool MRMazeBlockCode::checkpoint(CheckpointArchive &a) {
+	a & currentLocalDate;
+	return true;
+}
+
 BlockCode* MRMazeBlockCode::buildNewBlockCode(BuildingBlock *host) {
 	return(new MRMazeBlockCode((MultiRobotsBlock*)host));
 }
@@ -17,6 +17,7 @@ class MRMazeBlockCode : public MultiRobots::MultiRobotsBlockCode {
 	void init();
 	void processLocalEvent(EventPtr pev);
 	void setCurrentLocalDate(Time t) {currentLocalDate = t;}
+	bool checkpoint(CheckpointArchive &a);
 	static BlockCode *buildNewBlockCode(BuildingBlock *host);
 };
 
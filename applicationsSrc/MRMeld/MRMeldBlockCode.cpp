@@ -241,7 +241,7 @@ void MRMeldBlockCode::processLocalEvent(EventPtr pev) {
 		BaseSimulator::BuildingBlock* target =
 			(std::static_pointer_cast<VMSendMessageEvent2>(pev))->target;
         target->scheduleLocalEvent(
-			EventPtr(new VMReceiveMessageEvent2(BaseSimulator::getScheduler()->now(), hostBlock, message)));
+			makeEventPtr(new VMReceiveMessageEvent2(BaseSimulator::getScheduler()->now(), hostBlock, message)));
 	}
 	break;
 	case EVENT_RECEIVE_MESSAGE_FROM_BLOCK: /*EVENT_NI_RECEIVE: */
@@ -6,6 +6,7 @@
 #include "scheduler.h"
 #include "network.h"
 #include "lattice.h"
+#include "checkpoint.h"
 
 #include "MRWirelessBlockCode.h"
 
@@ -86,6 +87,11 @@ void MRWirelessBlockCode::processLocalEvent(EventPtr pev) {
 	}
 }
 
+bool MRWirelessBlockCode::checkpoint(CheckpointArchive &a) {
+	a & currentLocalDate;
+	return true;
+}
+
 BlockCode* MRWirelessBlockCode::buildNewBlockCode(BuildingBlock *host) {
 	return(new MRWirelessBlockCode((MultiRobotsBlock*)host));
 }
@@ -16,6 +16,7 @@
 #include "bbCycleEvents.h"
 #include "trace.h"
 #include "lattice.h"
+#include "checkpoint.h"
 
 using namespace std;
 using namespace BlinkyBlocks;
@@ -130,6 +131,20 @@ void BbCycleBlockCode::processLocalEvent(EventPtr pev) {
   getScheduler()->trace(info.str(),hostBlock->blockId);
 }
 
+bool BbCycleBlockCode::saveState(StateSnapshot &s) {
+  s.save(block2Answer);
+  s.save(received, sizeof(received));
+  s.save(cycle);
+  s.save(delay);
+  s.save(idMessage);
+  return true;
+}
+
+bool BbCycleBlockCode::checkpoint(CheckpointArchive &a) {
+  a & block2Answer & received & cycle & delay & idMessage;
+  return true;
+}
+
 BlockCode* BbCycleBlockCode::buildNewBlockCode(BuildingBlock *host) {
   return(new BbCycleBlockCode((BlinkyBlocksBlock*)host));
 }
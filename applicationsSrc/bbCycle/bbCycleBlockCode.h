@@ -31,6 +31,8 @@ class BbCycleBlockCode : public BlinkyBlocks::BlinkyBlocksBlockCode {
 	void startup();
 	void init();
 	void processLocalEvent(EventPtr pev);
+	bool saveState(StateSnapshot &s);
+	bool checkpoint(CheckpointArchive &a);
 	Color getColor(Time time);
 	
 	void sendClockToNeighbors (P2PNetworkInterface *except, int hop, Time clock, int id);	
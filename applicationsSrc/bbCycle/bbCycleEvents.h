@@ -28,7 +28,7 @@ class SynchronizeEvent : public BlockEvent {
         ~SynchronizeEvent() {};
 
         void consumeBlockEvent() {
-                concernedBlock->scheduleLocalEvent(EventPtr(new SynchronizeEvent(this)));
+                concernedBlock->scheduleLocalEvent(makeEventPtr(new SynchronizeEvent(this)));
         }
 
         const string getEventName() { return "SYNC EVENT"; }
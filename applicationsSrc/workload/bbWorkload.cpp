@@ -0,0 +1,28 @@
+/*! @file bbWorkload.cpp
+ * @brief Synthetic workload of the end-to-end benchmarks on Blinky Blocks (see utilities/generateWorkload.py)
+ * @date 17/10/2026
+ */
+
+#include <iostream>
+#include <trace.h>
+
+#include "blinkyBlocksBlock.h"
+#include "blinkyBlocksSimulator.h"
+#include "blinkyBlocksBlockCode.h"
+#include "workloadBlockCode.h"
+
+using namespace std;
+using namespace BlinkyBlocks;
+
+typedef RandomWalkBlockCode<BlinkyBlocksBlockCode, BlinkyBlocksBlock> BbWorkloadBlockCode;
+
+int main(int argc, char **argv) {
+	OUTPUT << "\033[1;33m" << "Starting Blinky Blocks workload simulation (main) ..." << "\033[0m" << endl;
+
+	Workload::registerCheckpointers();
+	createSimulator(argc, argv, BbWorkloadBlockCode::buildNewBlockCode);
+	deleteSimulator();
+
+	OUTPUT << "\033[1;33m" << "end (main)" << "\033[0m" << endl;
+	return(0);
+}
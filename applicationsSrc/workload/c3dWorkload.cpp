@@ -0,0 +1,28 @@
+/*! @file c3dWorkload.cpp
+ * @brief Synthetic workload of the end-to-end benchmarks on Catoms3D (see utilities/generateWorkload.py)
+ * @date 17/10/2026
+ */
+
+#include <iostream>
+#include <trace.h>
+
+#include "catoms3DBlock.h"
+#include "catoms3DSimulator.h"
+#include "catoms3DBlockCode.h"
+#include "workloadBlockCode.h"
+
+using namespace std;
+using namespace Catoms3D;
+
+typedef RandomWalkBlockCode<Catoms3DBlockCode, Catoms3DBlock> C3dWorkloadBlockCode;
+
+int main(int argc, char **argv) {
+	OUTPUT << "\033[1;33m" << "Starting Catoms3D workload simulation (main) ..." << "\033[0m" << endl;
+
+	Workload::registerCheckpointers();
+	createSimulator(argc, argv, C3dWorkloadBlockCode::buildNewBlockCode);
+	deleteSimulator();
+
+	OUTPUT << "\033[1;33m" << "end (main)" << "\033[0m" << endl;
+	return(0);
+}
@@ -0,0 +1,28 @@
+/*! @file mrWorkload.cpp
+ * @brief Synthetic workload of the end-to-end benchmarks on Multi Robots (see utilities/generateWorkload.py)
+ * @date 17/10/2026
+ */
+
+#include <iostream>
+#include <trace.h>
+
+#include "multiRobotsBlock.h"
+#include "multiRobotsSimulator.h"
+#include "multiRobotsBlockCode.h"
+#include "workloadBlockCode.h"
+
+using namespace std;
+using namespace MultiRobots;
+
+typedef WirelessRelayBlockCode<MultiRobotsBlockCode, MultiRobotsBlock> MrWorkloadBlockCode;
+
+int main(int argc, char **argv) {
+	OUTPUT << "\033[1;33m" << "Starting Multi Robots workload simulation (main) ..." << "\033[0m" << endl;
+
+	Workload::registerCheckpointers();
+	createSimulator(argc, argv, MrWorkloadBlockCode::buildNewBlockCode);
+	deleteSimulator();
+
+	OUTPUT << "\033[1;33m" << "end (main)" << "\033[0m" << endl;
+	return(0);
+}
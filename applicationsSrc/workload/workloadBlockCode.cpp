@@ -0,0 +1,60 @@
+/*! @file workloadBlockCode.cpp
+ * @brief Synthetic block codes of the end-to-end benchmarks, shared by the workloads of every module type
+ *  (see utilities/generateWorkload.py)
+ * @date 17/10/2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+
+#include "workloadBlockCode.h"
+#include "checkpoint.h"
+#include "trace.h"
+
+using namespace std;
+using namespace BaseSimulator;
+
+Workload &Workload::get() {
+	// Created by parse, on the thread that builds the world, before the other threads of the simulation read it
+	shared_ptr<void> &data = SimulationContext::current().userData;
+	if (!data) data = make_shared<Workload>();
+	return *static_cast<Workload*>(data.get());
+}
+
+void Workload::parse(TiXmlDocument *config) {
+	Workload &w = get();
+	TiXmlNode *node = config->FirstChild("world")->FirstChild("workload");
+	if (node) {
+		TiXmlElement *element = node->ToElement();
+		const char *attr = element->Attribute("rate");
+		if (attr) w.rate = atof(attr);
+		attr = element->Attribute("hops");
+		if (attr) w.hops = atoi(attr);
+	}
+	OUTPUT << "workload: " << w.rate << " message(s)/s per module, " << w.hops << " hop(s)" << endl;
+}
+
+void Workload::scheduleTimer(BuildingBlock *block) {
+	// Uniform in [0.5/rate, 1.5/rate]: emissions of the modules do not synchronize, and their mean rate is rate
+	Time period = (Time)(1000000.0 / get().rate);
+	Time delay = period / 2 + (period ? block->getRandomUint() % (period + 1) : 0);
+	getScheduler()->schedule(new WorkloadTimerEvent(getScheduler()->now() + max(delay, (Time)1), block));
+}
+
+void Workload::registerCheckpointers() {
+	Checkpoint::registerEvent(EVENT_WORKLOAD_TIMER, [](CheckpointArchive &a, Event *e) -> Event* {
+		BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+		a & bb;
+		return e ? e : new WorkloadTimerEvent(0, bb);
+	});
+	Checkpoint::registerMessage(WORKLOAD_MSG_ID, [](CheckpointArchive &a, Message *m) -> Message* {
+		int ttl = m ? static_cast<WorkloadMessage*>(m)->ttl : 0;
+		a & ttl;
+		return m ? m : new WorkloadMessage(ttl);
+	});
+	Checkpoint::registerWirelessMessage(WORKLOAD_MSG_ID, [](CheckpointArchive &a, WirelessMessage *m) -> WirelessMessage* {
+		int ttl = m ? static_cast<WorkloadWirelessMessage*>(m)->ttl : 0;
+		a & ttl;
+		return m ? m : new WorkloadWirelessMessage(0, ttl);
+	});
+}
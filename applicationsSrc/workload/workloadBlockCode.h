@@ -0,0 +1,186 @@
+/*! @file workloadBlockCode.h
+ * @brief Synthetic block codes of the end-to-end benchmarks, shared by the workloads of every module type: every
+ *  module emits messages at a tunable rate, which travel a tunable number of hops, along random walks between
+ *  neighbors (RandomWalkBlockCode), or relayed between random robots through the wireless interface
+ *  (WirelessRelayBlockCode). See utilities/generateWorkload.py
+ * @date 17/10/2026
+ */
+
+#ifndef WORKLOADBLOCKCODE_H_
+#define WORKLOADBLOCKCODE_H_
+
+#define WORKLOAD_MSG_ID			9100
+#define EVENT_WORKLOAD_TIMER	15100
+
+#define WORKLOAD_DEFAULT_RATE	1.0 //!< Messages emitted per module and per second of simulated time
+#define WORKLOAD_DEFAULT_HOPS	1 //!< Number of hops of each message
+
+#include <vector>
+
+#include "blockCode.h"
+#include "buildingBlock.h"
+#include "network.h"
+#include "scheduler.h"
+#include "events.h"
+#include "world.h"
+
+//!< Parameters of the workload, read from the workload element of config.xml, and the code common to its block codes
+class Workload {
+public:
+	double rate = WORKLOAD_DEFAULT_RATE; //!< Messages emitted per module and per second
+	int hops = WORKLOAD_DEFAULT_HOPS; //!< Number of hops of each message
+
+	//!< @brief Returns the parameters of the simulation of the calling thread, kept in its context (see SimulationContext::userData)
+	static Workload &get();
+	//!< @brief Reads the rate and hops attributes of the workload element of config
+	static void parse(TiXmlDocument *config);
+	//!< @brief Schedules the next emission of block, after a random delay of mean 1/rate
+	static void scheduleTimer(BaseSimulator::BuildingBlock *block);
+	/**
+	 * @brief Registers the messages and events of the workload, so that its simulations can be saved and resumed
+	 *  (see -K and -C). Must be called before the simulator is created
+	 */
+	static void registerCheckpointers();
+};
+
+class WorkloadMessage : public Message {
+public:
+	int ttl; //!< Remaining hops
+	WorkloadMessage(int t) : Message(), ttl(t) { type = WORKLOAD_MSG_ID; };
+	unsigned int size() { return(8); }
+};
+
+class WorkloadWirelessMessage : public WirelessMessage {
+public:
+	int ttl; //!< Remaining hops
+	WorkloadWirelessMessage(bID destId, int t) : WirelessMessage(destId), ttl(t) { type = WORKLOAD_MSG_ID; };
+	unsigned int size() { return(8); }
+	WirelessMessage* clone() {
+		WorkloadWirelessMessage *ptr = new WorkloadWirelessMessage(destinationId, ttl);
+		ptr->sourceInterface = sourceInterface;
+		return ptr;
+	}
+};
+
+//!< Emission timer of a module
+class WorkloadTimerEvent : public BlockEvent {
+public:
+	WorkloadTimerEvent(Time t, BaseSimulator::BuildingBlock *conBlock) : BlockEvent(t, conBlock) {
+		eventType = EVENT_WORKLOAD_TIMER;
+	}
+	WorkloadTimerEvent(WorkloadTimerEvent *ev) : BlockEvent(ev) {};
+	~WorkloadTimerEvent() {};
+
+	void consumeBlockEvent() {
+		concernedBlock->scheduleLocalEvent(makeEventPtr(new WorkloadTimerEvent(this)));
+	}
+	const string getEventName() { return "WORKLOAD TIMER EVENT"; }
+};
+
+/**
+ * @brief Workload of the modules connected to their neighbors (Blinky Blocks, Catoms3D...): every message is sent to
+ *  a random connected neighbor, which forwards it to one of its own until it has traveled Workload::hops hops
+ * @tparam ModuleBlockCode block code of the module type
+ * @tparam ModuleBlock block of the module type
+ */
+template<class ModuleBlockCode, class ModuleBlock> class RandomWalkBlockCode : public ModuleBlockCode {
+	//!< @brief Sends a message with ttl remaining hops to a random connected neighbor, if there is one
+	void sendToRandomNeighbor(int ttl) {
+		// Neighbors are not stored, they change when modules move and are not part of the checkpoints
+		std::vector<P2PNetworkInterface*> neighbors;
+		for (P2PNetworkInterface *ni : this->hostBlock->getP2PNetworkInterfaces()) {
+			if (ni->connectedInterface) neighbors.push_back(ni);
+		}
+		if (neighbors.empty()) return;
+		neighbors[this->hostBlock->getRandomUint() % neighbors.size()]->send(new WorkloadMessage(ttl));
+	}
+public:
+	RandomWalkBlockCode(ModuleBlock *host) : ModuleBlockCode(host) {};
+	~RandomWalkBlockCode() {};
+
+	void startup() {
+		if (Workload::get().rate > 0) Workload::scheduleTimer(this->hostBlock);
+	}
+
+	void processLocalEvent(EventPtr pev) {
+		switch (pev->eventType) {
+		case EVENT_WORKLOAD_TIMER:
+			sendToRandomNeighbor(Workload::get().hops);
+			Workload::scheduleTimer(this->hostBlock);
+			break;
+		case EVENT_NI_RECEIVE: {
+			MessagePtr message = (std::static_pointer_cast<NetworkInterfaceReceiveEvent>(pev))->message;
+			if (message->type == WORKLOAD_MSG_ID) {
+				int ttl = std::static_pointer_cast<WorkloadMessage>(message)->ttl;
+				if (ttl > 1) sendToRandomNeighbor(ttl - 1);
+			}
+		} break;
+		default:
+			break;
+		}
+	}
+
+	void parseUserElements(TiXmlDocument *config) { Workload::parse(config); }
+	// The block code has no variables
+	bool saveState(StateSnapshot &s) { return true; }
+	bool checkpoint(CheckpointArchive &a) { return true; }
+
+	static BlockCode *buildNewBlockCode(BuildingBlock *host) {
+		return(new RandomWalkBlockCode((ModuleBlock*)host));
+	}
+};
+
+/**
+ * @brief Workload of the modules communicating through their wireless interface (Multi Robots): every message is
+ *  sent to a random robot, which relays it to another random robot until it has traveled Workload::hops hops
+ * @tparam ModuleBlockCode block code of the module type
+ * @tparam ModuleBlock block of the module type
+ */
+template<class ModuleBlockCode, class ModuleBlock> class WirelessRelayBlockCode : public ModuleBlockCode {
+	//!< @brief Sends a message with ttl remaining hops to a random robot other than this one
+	void sendToRandomRobot(int ttl) {
+		// Identifiers are assigned in order, from 1 (see generateWorkload.py)
+		bID nbRobots = BaseSimulator::getWorld()->getNbBlocks();
+		bID dest = 1 + this->hostBlock->getRandomUint() % (nbRobots - 1);
+		if (dest >= this->hostBlock->blockId) dest++;
+		BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceEnqueueOutgoingEvent(
+			BaseSimulator::getScheduler()->now(), new WorkloadWirelessMessage(dest, ttl),
+			this->hostBlock->getWirelessNetworkInterface()));
+	}
+public:
+	WirelessRelayBlockCode(ModuleBlock *host) : ModuleBlockCode(host) {};
+	~WirelessRelayBlockCode() {};
+
+	void startup() {
+		if (Workload::get().rate > 0 && BaseSimulator::getWorld()->getNbBlocks() > 1) Workload::scheduleTimer(this->hostBlock);
+	}
+
+	void processLocalEvent(EventPtr pev) {
+		switch (pev->eventType) {
+		case EVENT_WORKLOAD_TIMER:
+			sendToRandomRobot(Workload::get().hops);
+			Workload::scheduleTimer(this->hostBlock);
+			break;
+		case EVENT_WNI_MESSAGE_RECEIVED: {
+			WirelessMessagePtr message = (std::static_pointer_cast<WirelessNetworkInterfaceMessageReceivedEvent>(pev))->message;
+			if (message->type == WORKLOAD_MSG_ID) {
+				int ttl = std::static_pointer_cast<WorkloadWirelessMessage>(message)->ttl;
+				if (ttl > 1) sendToRandomRobot(ttl - 1);
+			}
+		} break;
+		default:
+			break;
+		}
+	}
+
+	void parseUserElements(TiXmlDocument *config) { Workload::parse(config); }
+	// The block code has no variables
+	bool saveState(StateSnapshot &s) { return true; }
+	bool checkpoint(CheckpointArchive &a) { return true; }
+
+	static BlockCode *buildNewBlockCode(BuildingBlock *host) {
+		return(new WirelessRelayBlockCode((ModuleBlock*)host));
+	}
+};
+
+#endif /* WORKLOADBLOCKCODE_H_ */
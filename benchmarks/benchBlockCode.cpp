@@ -0,0 +1,41 @@
+/*! @file benchBlockCode.cpp
+ * @brief Block code of the fixtures of the microbenchmarks: forwards messages along a line of blocks
+ * @date 17/10/2026
+ */
+
+#include "benchBlockCode.h"
+
+#include "scheduler.h"
+#include "events.h"
+#include "network.h"
+
+using namespace BlinkyBlocks;
+
+int BenchBlockCode::chainMessages = 0;
+
+BenchBlockCode::BenchBlockCode(BlinkyBlocksBlock *host) : BlinkyBlocksBlockCode(host), next(NULL) {
+}
+
+void BenchBlockCode::startup() {
+	for (P2PNetworkInterface *ni : hostBlock->getP2PNetworkInterfaces()) {
+		if (ni->getConnectedBlockId() == (int)hostBlock->blockId + 1) {
+			next = ni;
+		}
+	}
+
+	if (hostBlock->blockId == 1 && next) {
+		for (int i = 0; i < chainMessages; i++) {
+			next->send(new Message());
+		}
+	}
+}
+
+void BenchBlockCode::processLocalEvent(EventPtr pev) {
+	if (pev->eventType == EVENT_NI_RECEIVE && next) {
+		next->send(new Message());
+	}
+}
+
+BlockCode* BenchBlockCode::buildNewBlockCode(BuildingBlock *host) {
+	return new BenchBlockCode((BlinkyBlocksBlock*)host);
+}
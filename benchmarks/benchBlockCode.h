@@ -0,0 +1,30 @@
+/*! @file benchBlockCode.h
+ * @brief Block code of the fixtures of the microbenchmarks: forwards messages along a line of blocks
+ * @date 17/10/2026
+ */
+
+#ifndef BENCHBLOCKCODE_H__
+#define BENCHBLOCKCODE_H__
+
+#include "blinkyBlocksBlockCode.h"
+#include "blinkyBlocksSimulator.h"
+
+/**
+ * @brief At startup, block 1 sends chainMessages messages to block 2, and every block forwards each message it
+ *  receives to the block whose identifier follows its own, if any. Blocks do nothing else.
+ */
+class BenchBlockCode : public BlinkyBlocks::BlinkyBlocksBlockCode {
+	P2PNetworkInterface *next; //!< Interface connected to the next block, NULL if none
+public:
+	static int chainMessages; //!< Number of messages sent by block 1 at startup
+
+	BenchBlockCode(BlinkyBlocks::BlinkyBlocksBlock *host);
+	~BenchBlockCode() {};
+
+	void startup();
+	void processLocalEvent(EventPtr pev);
+
+	static BlockCode *buildNewBlockCode(BuildingBlock *host);
+};
+
+#endif // BENCHBLOCKCODE_H__
@@ -0,0 +1,257 @@
+/*! @file benchmark.cpp
+ * @brief Minimal harness of the microbenchmarks of the simulator core: registration, timing, allocation counting
+ *  and comparison with a baseline
+ * @date 17/10/2026
+ */
+
+#include "benchmark.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+// Every memory allocation of the process goes through these operators, so that the benchmarks can report the
+// number of allocations of the code they measure. Events are allocated from their own pools (see eventPool.h),
+// only refills of the pools are counted for them.
+static std::atomic<uint64_t> allocationCount(0);
+
+void* operator new(size_t size) {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	void *p = malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+namespace Benchmarks {
+
+vector<Benchmark>& getBenchmarks() {
+	static vector<Benchmark> benchmarks;
+	return benchmarks;
+}
+
+void registerBenchmark(const string &name, function<uint64_t()> body,
+					   function<void()> setUp, function<void()> tearDown) {
+	getBenchmarks().push_back(Benchmark { name, setUp, body, tearDown });
+}
+
+uint64_t getAllocationCount() {
+	return allocationCount.load(std::memory_order_relaxed);
+}
+
+//!< Stream buffer discarding its output, replaces the buffers of cout and cerr while a benchmark runs
+class NullBuffer : public streambuf {
+protected:
+	int overflow(int c) { return c; }
+	streamsize xsputn(const char*, streamsize n) { return n; }
+};
+
+//!< @brief Runs the repetitions of a benchmark and returns the median of their measures
+static BenchmarkResult run(const Benchmark &b, int repetitions, bool verbose) {
+	static NullBuffer nullBuffer;
+	vector<double> times, allocs;
+	BenchmarkResult r;
+	r.name = b.name;
+
+	// The first repetition warms up caches and pools, it is not measured
+	for (int i = 0; i <= repetitions; i++) {
+		streambuf *coutBuffer = cout.rdbuf(verbose ? cout.rdbuf() : &nullBuffer);
+		streambuf *cerrBuffer = cerr.rdbuf(verbose ? cerr.rdbuf() : &nullBuffer);
+		if (b.setUp) b.setUp();
+		uint64_t allocStart = getAllocationCount();
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		uint64_t ops = b.body();
+		chrono::steady_clock::time_point end = chrono::steady_clock::now();
+		uint64_t allocEnd = getAllocationCount();
+		if (b.tearDown) b.tearDown();
+		cout.rdbuf(coutBuffer);
+		cerr.rdbuf(cerrBuffer);
+
+		if (i == 0) continue;
+		ops = max(ops, (uint64_t)1);
+		r.ops = ops;
+		times.push_back(chrono::duration<double, nano>(end - start).count() / ops);
+		allocs.push_back((double)(allocEnd - allocStart) / ops);
+	}
+
+	sort(times.begin(), times.end());
+	sort(allocs.begin(), allocs.end());
+	r.minNsPerOp = times.front();
+	r.nsPerOp = times[times.size() / 2];
+	r.allocsPerOp = allocs[allocs.size() / 2];
+	return r;
+}
+
+//!< @brief Reads the results of a previous run, written with -o, indexed by benchmark name
+static bool readResults(const string &path, map<string, BenchmarkResult> &results) {
+	ifstream in(path);
+	if (!in.is_open()) return false;
+	string line;
+	getline(in, line); // header
+	while (getline(in, line)) {
+		istringstream ss(line);
+		BenchmarkResult r;
+		string field;
+		if (!getline(ss, r.name, ',')) continue;
+		getline(ss, field, ','); r.ops = stoull(field);
+		getline(ss, field, ','); r.nsPerOp = stod(field);
+		getline(ss, field, ','); r.minNsPerOp = stod(field);
+		getline(ss, field, ','); r.allocsPerOp = stod(field);
+		results[r.name] = r;
+	}
+	return true;
+}
+
+//!< @brief Writes results to a CSV file, one line per benchmark
+static bool writeResults(const string &path, const vector<BenchmarkResult> &results) {
+	ofstream out(path);
+	if (!out.is_open()) return false;
+	out << "name,ops,ns_per_op,min_ns_per_op,allocs_per_op" << endl;
+	for (const BenchmarkResult &r : results) {
+		out << r.name << ',' << r.ops << ',' << fixed << setprecision(2) << r.nsPerOp << ','
+			<< r.minNsPerOp << ',' << r.allocsPerOp << defaultfloat << endl;
+	}
+	return out.good();
+}
+
+static void help() {
+	cerr << "Usage: vsbench [options] [<filter>]" << endl;
+	cerr << "Runs the microbenchmarks of the simulator core whose name contains <filter> (all by default)" << endl;
+	cerr << "\t-r <n>\t\tnumber of measured repetitions of each benchmark, the median is reported (default "
+		 << BENCH_DEFAULT_REPETITIONS << ")" << endl;
+	cerr << "\t-o <file.csv>\twrites the results to file.csv" << endl;
+	cerr << "\t-b <file.csv>\tcompares the results with a baseline written by -o, exits with status 1 on a regression"
+		 << endl;
+	cerr << "\t-t <percent>\tslowdown or increase of allocations relatively to the baseline considered as a regression "
+		 << "(default " << BENCH_DEFAULT_THRESHOLD << ")" << endl;
+	cerr << "\t-l\t\tlists the benchmarks and exits" << endl;
+	cerr << "\t-v\t\tkeeps the output of the simulator, discarded otherwise" << endl;
+	cerr << "\t-h\t\thelp" << endl;
+	exit(EXIT_FAILURE);
+}
+
+} // namespace Benchmarks
+
+using namespace Benchmarks;
+
+int main(int argc, char **argv) {
+	int repetitions = BENCH_DEFAULT_REPETITIONS;
+	double threshold = BENCH_DEFAULT_THRESHOLD;
+	string outFile, baselineFile, filter;
+	bool list = false, verbose = false;
+
+	argv++;
+	argc--;
+	while (argc > 0) {
+		if (argv[0][0] != '-') {
+			filter = argv[0];
+		} else {
+			switch(argv[0][1]) {
+				case 'r': case 'o': case 'b': case 't': {
+					if (argc < 2) help();
+					try {
+						if (argv[0][1] == 'r') repetitions = stoi(argv[1]);
+						if (argv[0][1] == 't') threshold = stod(argv[1]);
+					} catch (std::exception&) {
+						cerr << "error: " << argv[0] << " expects a number" << endl;
+						help();
+					}
+					if (argv[0][1] == 'o') outFile = argv[1];
+					if (argv[0][1] == 'b') baselineFile = argv[1];
+					argc--;
+					argv++;
+				} break;
+				case 'l': list = true; break;
+				case 'v': verbose = true; break;
+				default: help();
+			}
+		}
+		argc--;
+		argv++;
+	}
+	if (repetitions < 1) {
+		cerr << "error: the number of repetitions must be positive" << endl;
+		help();
+	}
+
+	registerCoreBenchmarks();
+
+	map<string, BenchmarkResult> baseline;
+	if (!baselineFile.empty() && !readResults(baselineFile, baseline)) {
+		cerr << "error: cannot read baseline " << baselineFile << endl;
+		return EXIT_FAILURE;
+	}
+
+	vector<BenchmarkResult> results;
+	int nbRegressions = 0;
+	cout << left << setw(36) << "benchmark" << right << setw(10) << "ops" << setw(14) << "ns/op"
+		 << setw(14) << "min ns/op" << setw(12) << "allocs/op";
+	if (!baseline.empty()) cout << setw(10) << "vs base";
+	cout << endl;
+
+	for (const Benchmark &b : getBenchmarks()) {
+		if (b.name.find(filter) == string::npos) continue;
+		if (list) {
+			cout << b.name << endl;
+			continue;
+		}
+
+		BenchmarkResult r = run(b, repetitions, verbose);
+		results.push_back(r);
+		cout << left << setw(36) << r.name << right << setw(10) << r.ops << fixed << setprecision(1)
+			 << setw(14) << r.nsPerOp << setw(14) << r.minNsPerOp << setprecision(2) << setw(12) << r.allocsPerOp;
+
+		auto it = baseline.find(r.name);
+		if (it != baseline.end()) {
+			const BenchmarkResult &base = it->second;
+			double change = base.nsPerOp > 0 ? (r.nsPerOp - base.nsPerOp) * 100 / base.nsPerOp : 0;
+			// An increase of allocations below one every hundred operations is noise of the warm up
+			bool slower = change > threshold;
+			bool allocates = r.allocsPerOp > base.allocsPerOp * (1 + threshold / 100) + 0.01;
+			cout << setprecision(1) << setw(9) << showpos << change << noshowpos << '%';
+			if (slower || allocates) {
+				cout << "  REGRESSION" << (allocates ? " (allocations)" : "");
+				nbRegressions++;
+			}
+		}
+		cout << defaultfloat << endl;
+	}
+
+	if (!outFile.empty() && !writeResults(outFile, results)) {
+		cerr << "error: cannot write " << outFile << endl;
+		return EXIT_FAILURE;
+	}
+	if (nbRegressions > 0) {
+		cerr << nbRegressions << " benchmark(s) regressed by more than " << threshold << "% relatively to "
+			 << baselineFile << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
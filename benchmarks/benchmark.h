@@ -0,0 +1,58 @@
+/*! @file benchmark.h
+ * @brief Minimal harness of the microbenchmarks of the simulator core: registration, timing, allocation counting
+ *  and comparison with a baseline
+ * @date 17/10/2026
+ */
+
+#ifndef BENCHMARK_H__
+#define BENCHMARK_H__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+#define BENCH_DEFAULT_REPETITIONS	5 //!< Number of measured repetitions of each benchmark, the median is reported
+#define BENCH_DEFAULT_THRESHOLD		10.0 //!< Slowdown (%) relatively to the baseline above which a benchmark has regressed
+
+namespace Benchmarks {
+
+/**
+ * @brief A microbenchmark
+ *
+ *  Each repetition calls setUp, then body, whose time and memory allocations are measured, then tearDown. body
+ *  returns the number of operations it performed, from which the time and allocations per operation are computed.
+ *  Workloads are deterministic (fixed seeds and configurations), so that successive runs are comparable.
+ */
+struct Benchmark {
+	std::string name; //!< Unique name, as "component/operation"
+	std::function<void()> setUp; //!< Prepares a repetition, not measured (optional)
+	std::function<uint64_t()> body; //!< Measured part of a repetition, returns the number of operations performed
+	std::function<void()> tearDown; //!< Releases what setUp and body created, not measured (optional)
+};
+
+//!< Measures of a benchmark, median of its repetitions
+struct BenchmarkResult {
+	std::string name; //!< Name of the benchmark
+	uint64_t ops = 0; //!< Number of operations of a repetition
+	double nsPerOp = 0; //!< Median time per operation (ns)
+	double minNsPerOp = 0; //!< Fastest repetition, time per operation (ns)
+	double allocsPerOp = 0; //!< Median number of memory allocations per operation
+};
+
+//!< @brief Adds a benchmark to the suite
+void registerBenchmark(const std::string &name, std::function<uint64_t()> body,
+					   std::function<void()> setUp = nullptr, std::function<void()> tearDown = nullptr);
+
+//!< @brief Returns the benchmarks of the suite, in registration order
+std::vector<Benchmark>& getBenchmarks();
+
+//!< @brief Returns the number of memory allocations (operator new) performed by the process so far
+uint64_t getAllocationCount();
+
+//!< @brief Registers the benchmarks of the simulator core (see coreBenchmarks.cpp)
+void registerCoreBenchmarks();
+
+} // namespace Benchmarks
+
+#endif // BENCHMARK_H__
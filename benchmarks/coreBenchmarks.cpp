@@ -0,0 +1,449 @@
+/*! @file coreBenchmarks.cpp
+ * @brief Microbenchmarks of the hot paths of the simulator core: event list, point-to-point and wireless messages,
+ *  lattice neighborhoods, Meld rules and configuration loading
+ * @date 17/10/2026
+ */
+
+#include <random>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "benchmark.h"
+#include "benchBlockCode.h"
+
+#include "blinkyBlocksSimulator.h"
+#include "scheduler.h"
+#include "events.h"
+#include "network.h"
+#include "world.h"
+#include "lattice.h"
+#include "meldInterpretVM.h"
+#include "simulationContext.h"
+
+#define BENCH_LINE_CONFIG		"line.xml" //!< 100 blocks on a line
+#define BENCH_CUBE_CONFIG		"cube.xml" //!< 1000 blocks in a 10x10x10 cube
+#define BENCH_MELD_PROGRAM		"../applicationsBin/MRMeld/program.bb" //!< Meld program run by the Meld benchmark
+
+#define BENCH_HOLD_EVENTS		1000 //!< Number of pending events of the hold model
+#define BENCH_HOLD_OPS			200000 //!< Number of events processed by a repetition of the hold model
+#define BENCH_HOLD_MEAN_DELAY	1000 //!< Mean delay (us) between an event and the one it schedules
+#define BENCH_WATCHDOG_DELAY	4000 //!< Delay (us) of the timeouts of the watchdog model, always cancelled before expiring
+#define BENCH_CHAIN_MESSAGES	200 //!< Number of messages forwarded along the line by the chain benchmark
+#define BENCH_CONTEXTS			2 //!< Number of simulations run concurrently by the contexts benchmark
+#define BENCH_BROADCASTS		50 //!< Number of wireless broadcasts of a repetition
+#define BENCH_SHORT_RANGE_POWER	-80 //!< Transmit power (dBm) of the short range broadcasts, about 7 cells of range
+#define BENCH_UNIT_DISK_RANGE	20 //!< Radius (cells) of the unit-disk channel, which covers the whole cube
+#define BENCH_CONTENDERS		100 //!< Number of blocks of the cube contending for the wireless channel
+#define BENCH_NEIGHBOR_ROUNDS	20 //!< Number of times the neighborhood of every block is computed by a repetition
+#define BENCH_MELD_MAX_RULES	1000000 //!< Maximum number of rules processed by a Meld VM, in case the program never ends
+#define BENCH_SEED				"1" //!< Simulation seed of the fixtures
+
+using namespace std;
+using namespace BaseSimulator;
+
+namespace Benchmarks {
+
+//!< Simulator of the fixtures, whose constructor is accessible (simulators are created by createSimulator otherwise)
+class BenchSimulator : public BlinkyBlocks::BlinkyBlocksSimulator {
+public:
+	BenchSimulator(int argc, char *argv[], BlockCodeBuilder bcb) : BlinkyBlocksSimulator(argc, argv, bcb) {};
+};
+
+/**
+ * @brief World of Blinky Blocks loaded from a configuration file, in a simulation context of its own, ready to run
+ *  in the calling thread. Built as by createSimulator, without starting the scheduler.
+ */
+class BenchWorld {
+	unique_ptr<SimulationContext> context;
+	vector<string> args; //!< Command line of the simulator, kept alive with the simulator
+	vector<char*> argv;
+public:
+	BenchWorld(const string &config, const vector<string> &options = {},
+			   Simulator::Type type = Simulator::CPP) : context(new SimulationContext()) {
+		context->bind();
+		Simulator::setType(type);
+
+		args = { "vsbench", "-t", "-a", BENCH_SEED, "-c", config };
+		args.insert(args.end(), options.begin(), options.end());
+		for (string &s : args) argv.push_back(&s[0]);
+		argv.push_back(NULL);
+
+		Simulator *s = new BenchSimulator(args.size(), argv.data(), BenchBlockCode::buildNewBlockCode);
+		s->parseConfiguration(args.size(), argv.data());
+		getWorld()->linkBlocks();
+		getScheduler()->setState(Scheduler::NOTSTARTED);
+	}
+
+	~BenchWorld() {
+		context->bind();
+		getScheduler()->cancelStart();
+		Scheduler::deleteScheduler();
+		Simulator::deleteSimulator();
+		Simulator::setType(Simulator::CPP);
+		idleContext.bind();
+	}
+
+	//!< @brief Processes the events of the simulation until there are none left
+	void run() { getScheduler()->runInCallingThread(); }
+
+	static SimulationContext idleContext; //!< Context the thread is bound to between fixtures
+};
+
+SimulationContext BenchWorld::idleContext;
+
+static unique_ptr<BenchWorld> fixture; //!< World of the running benchmark
+
+static void deleteFixture() {
+	fixture.reset();
+}
+
+//===========================================================================================================
+//
+//          Scheduler::schedule and event list
+//
+//===========================================================================================================
+
+/**
+ * @brief Event of the hold model: when processed, schedules a new event after a random delay, until the budget of
+ *  the benchmark is exhausted. The size of the event list is thus constant.
+ */
+class HoldEvent : public Event {
+public:
+	static mt19937 generator; //!< Seeded at each repetition, the same dates are generated by every run
+	static uint64_t budget; //!< Number of events that remain to be scheduled
+
+	HoldEvent(Time t) : Event(t) {};
+	void consume() {
+		if (budget == 0) return;
+		budget--;
+		uniform_int_distribution<Time> delay(1, 2 * BENCH_HOLD_MEAN_DELAY);
+		getScheduler()->schedule(new HoldEvent(date + delay(generator)));
+	}
+	const string getEventName() { return "HoldEvent"; }
+};
+
+mt19937 HoldEvent::generator;
+uint64_t HoldEvent::budget = 0;
+
+static void registerHoldBenchmark(const string &queue) {
+	registerBenchmark("scheduler/hold/" + queue,
+					  []() {
+						  fixture->run();
+						  return (uint64_t)BENCH_HOLD_OPS;
+					  },
+					  [queue]() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_LINE_CONFIG, { "-q", queue }));
+						  HoldEvent::generator.seed(1);
+						  HoldEvent::budget = BENCH_HOLD_OPS;
+						  uniform_int_distribution<Time> date(0, 2 * BENCH_HOLD_MEAN_DELAY);
+						  for (int i = 0; i < BENCH_HOLD_EVENTS; i++) {
+							  getScheduler()->schedule(new HoldEvent(date(HoldEvent::generator)));
+						  }
+					  },
+					  deleteFixture);
+}
+
+/**
+ * @brief Event of the watchdog model: a hold model event that also disarms a timeout and arms a new one when
+ *  processed, as a block code restarting a watchdog timer
+ */
+class WatchdogEvent : public Event {
+public:
+	static EventHandle timeout; //!< Timeout armed by the last event processed
+
+	WatchdogEvent(Time t) : Event(t) {};
+	void consume() {
+		if (HoldEvent::budget == 0) return;
+		HoldEvent::budget--;
+		getScheduler()->cancel(timeout);
+		timeout = getScheduler()->scheduleCancellable(new HoldEvent(date + BENCH_WATCHDOG_DELAY));
+		uniform_int_distribution<Time> delay(1, 2 * BENCH_HOLD_MEAN_DELAY);
+		getScheduler()->schedule(new WatchdogEvent(date + delay(HoldEvent::generator)));
+	}
+	const string getEventName() { return "WatchdogEvent"; }
+};
+
+EventHandle WatchdogEvent::timeout;
+
+static void registerWatchdogBenchmark() {
+	registerBenchmark("scheduler/watchdog",
+					  []() {
+						  fixture->run();
+						  return (uint64_t)BENCH_HOLD_OPS;
+					  },
+					  []() {
+						  fixture.reset(new BenchWorld(BENCH_LINE_CONFIG));
+						  HoldEvent::generator.seed(1);
+						  HoldEvent::budget = BENCH_HOLD_OPS;
+						  WatchdogEvent::timeout = EventHandle();
+						  uniform_int_distribution<Time> date(0, 2 * BENCH_HOLD_MEAN_DELAY);
+						  for (int i = 0; i < BENCH_HOLD_EVENTS; i++) {
+							  getScheduler()->schedule(new WatchdogEvent(date(HoldEvent::generator)));
+						  }
+					  },
+					  deleteFixture);
+}
+
+//===========================================================================================================
+//
+//          Point-to-point messages
+//
+//===========================================================================================================
+
+static void registerChainBenchmark() {
+	registerBenchmark("network/p2p_chain",
+					  []() {
+						  fixture->run();
+						  return (uint64_t)BENCH_CHAIN_MESSAGES * (getWorld()->getMap().size() - 1);
+					  },
+					  []() {
+						  BenchBlockCode::chainMessages = BENCH_CHAIN_MESSAGES;
+						  fixture.reset(new BenchWorld(BENCH_LINE_CONFIG));
+					  },
+					  deleteFixture);
+}
+
+//===========================================================================================================
+//
+//          Concurrent simulations
+//
+//===========================================================================================================
+
+//!< @brief Runs a whole simulation of the line, from createSimulator to deleteSimulator, in a context of its own
+static void runLineSimulation() {
+	SimulationContext context;
+	context.bind();
+	vector<string> args = { "vsbench", "-t", "-a", BENCH_SEED, "-c", BENCH_LINE_CONFIG };
+	vector<char*> argv;
+	for (string &s : args) argv.push_back(&s[0]);
+	argv.push_back(NULL);
+
+	BlinkyBlocks::createSimulator(args.size(), argv.data(), BenchBlockCode::buildNewBlockCode);
+	deleteSimulator();
+	BenchWorld::idleContext.bind();
+}
+
+/**
+ * @brief Simulations started by createSimulator in concurrent threads, each in its own context. The blocks send no
+ *  message: the scheduler threads end while the threads owning them join them (regression test of the termination
+ *  of concurrent simulations, see Scheduler::joinSchedulerThread)
+ */
+static void registerContextsBenchmark() {
+	registerBenchmark("simulation/concurrent_contexts",
+					  []() {
+						  vector<thread> threads;
+						  for (int i = 0; i < BENCH_CONTEXTS; i++) threads.emplace_back(runLineSimulation);
+						  for (thread &t : threads) t.join();
+						  return (uint64_t)BENCH_CONTEXTS;
+					  },
+					  []() { BenchBlockCode::chainMessages = 0; });
+}
+
+//===========================================================================================================
+//
+//          Wireless messages
+//
+//===========================================================================================================
+
+//!< @brief Broadcasts messages from the first block of the fixture, returns the number of broadcasts
+static uint64_t broadcast() {
+	WirelessNetworkInterface *source = getWorld()->getMap().begin()->second->getWirelessNetworkInterface();
+	for (int i = 0; i < BENCH_BROADCASTS; i++) {
+		WirelessMessagePtr msg(new WirelessMessage(-1));
+		msg->sourceInterface = source;
+		getWorld()->broadcastWirelessMessage(msg);
+	}
+	return (uint64_t)BENCH_BROADCASTS;
+}
+
+/**
+ * @brief Enqueues a message in the wireless interfaces of the first blocks of the fixture, all in range of each
+ *  other, and runs the simulation until the medium access control has sent them all
+ * @param unicast : true to send every message to the next block, acknowledged if acknowledgments are enabled
+ * @return the number of messages
+ */
+static uint64_t contend(bool unicast) {
+	auto &blocks = getWorld()->getMap();
+	auto it = blocks.begin();
+	for (int i = 0; i < BENCH_CONTENDERS && it != blocks.end(); i++, it++) {
+		auto next = std::next(it) == blocks.end() ? blocks.begin() : std::next(it);
+		WirelessMessage *msg = new WirelessMessage(unicast ? next->first : WIRELESS_BROADCAST_ID);
+		it->second->getWirelessNetworkInterface()->addToOutgoingBuffer(WirelessMessagePtr(msg));
+	}
+	fixture->run();
+	return (uint64_t)min((size_t)BENCH_CONTENDERS, blocks.size());
+}
+
+static void registerBroadcastBenchmarks() {
+	// With the default transmit power, every block of the cube is within range
+	registerBenchmark("network/wireless_broadcast", broadcast,
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+					  },
+					  deleteFixture);
+	// Receptions by the 999 other blocks: link budget, shadowing, and the events that follow
+	registerBenchmark("network/wireless_receive",
+					  []() {
+						  uint64_t nbBroadcasts = broadcast();
+						  fixture->run();
+						  return nbBroadcasts * (getWorld()->getMap().size() - 1);
+					  },
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+					  },
+					  deleteFixture);
+	// Same receptions through the unit-disk channel, which skips the computation of the received power
+	registerBenchmark("network/wireless_receive_unit_disk",
+					  []() {
+						  uint64_t nbBroadcasts = broadcast();
+						  fixture->run();
+						  return nbBroadcasts * (getWorld()->getMap().size() - 1);
+					  },
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+						  WirelessNetworkInterface::setChannelModel(new UnitDiskChannelModel(BENCH_UNIT_DISK_RANGE));
+					  },
+					  deleteFixture);
+	// Only the blocks close to the source are reached, the others are skipped by the spatial index of the medium
+	registerBenchmark("network/wireless_broadcast_short", broadcast,
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+						  for (const auto &it : getWorld()->getMap()) {
+							  it.second->getWirelessNetworkInterface()->setTransmitPower(BENCH_SHORT_RANGE_POWER);
+						  }
+					  },
+					  deleteFixture);
+	// CSMA/CA: backoffs frozen and resumed by every transmission sensed, and the receptions
+	registerBenchmark("network/wireless_contention", []() { return contend(false); },
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+					  },
+					  deleteFixture);
+	// Same, with acknowledgments and the retransmissions of the messages that collide
+	registerBenchmark("network/wireless_contention_ack", []() { return contend(true); },
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+						  WirelessMacParameters mac;
+						  mac.ack = true;
+						  WirelessNetworkInterface::setMacParameters(mac);
+					  },
+					  deleteFixture);
+}
+
+//===========================================================================================================
+//
+//          Lattice
+//
+//===========================================================================================================
+
+static vector<Cell3DPosition> positions; //!< Positions of the blocks of the fixture
+
+static void registerNeighborCellsBenchmark() {
+	registerBenchmark("lattice/active_neighbor_cells",
+					  []() {
+						  Lattice *lattice = getWorld()->lattice;
+						  size_t nbNeighbors = 0;
+						  for (int i = 0; i < BENCH_NEIGHBOR_ROUNDS; i++) {
+							  for (const Cell3DPosition &p : positions) {
+								  nbNeighbors += lattice->getActiveNeighborCells(p).size();
+							  }
+						  }
+						  return nbNeighbors > 0 ? (uint64_t)BENCH_NEIGHBOR_ROUNDS * positions.size() : 0;
+					  },
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+						  positions.clear();
+						  for (const auto &it : getWorld()->getMap()) {
+							  positions.push_back(it.second->position);
+						  }
+					  },
+					  deleteFixture);
+}
+
+//===========================================================================================================
+//
+//          Meld
+//
+//===========================================================================================================
+
+static vector<MeldInterpret::MeldInterpretVM*> vms; //!< Meld VMs of the blocks of the fixture
+
+static void registerMeldBenchmark() {
+	registerBenchmark("meld/process_one_rule",
+					  []() {
+						  uint64_t nbRules = 0;
+						  for (MeldInterpret::MeldInterpretVM *vm : vms) {
+							  uint64_t n = 0;
+							  do {
+								  vm->processOneRule();
+								  n++;
+							  } while (vm->isWaiting() && n < BENCH_MELD_MAX_RULES);
+							  nbRules += n;
+						  }
+						  return nbRules;
+					  },
+					  []() {
+						  BenchBlockCode::chainMessages = 0;
+						  fixture.reset(new BenchWorld(BENCH_LINE_CONFIG, { "-p", BENCH_MELD_PROGRAM },
+													   Simulator::MELDINTERPRET));
+						  for (const auto &it : getWorld()->getMap()) {
+							  BuildingBlock *bb = it.second;
+							  MeldInterpret::MeldInterpretVM *vm = new MeldInterpret::MeldInterpretVM(bb);
+							  for (int i = 0; i < bb->getNbInterfaces(); i++) {
+								  vm->neighbors[i] = VACANT;
+							  }
+							  vm->enqueue_at((meld_int)bb->position.pt[0], (meld_int)bb->position.pt[1],
+											 (meld_int)bb->position.pt[2], 1);
+							  vms.push_back(vm);
+						  }
+					  },
+					  []() {
+						  for (MeldInterpret::MeldInterpretVM *vm : vms) {
+							  MeldInterpret::MeldInterpretVM::vmMap.erase(vm->getBlockId());
+							  delete vm;
+						  }
+						  vms.clear();
+						  deleteFixture();
+					  });
+}
+
+//===========================================================================================================
+//
+//          Configuration loading
+//
+//===========================================================================================================
+
+static void registerConfigBenchmark() {
+	registerBenchmark("config/load_1000_blocks",
+					  []() {
+						  fixture.reset(new BenchWorld(BENCH_CUBE_CONFIG));
+						  return (uint64_t)1;
+					  },
+					  []() { BenchBlockCode::chainMessages = 0; },
+					  deleteFixture);
+}
+
+void registerCoreBenchmarks() {
+	for (const string queue : { "map", "heap", "heap4", "calendar" }) {
+		registerHoldBenchmark(queue);
+	}
+	registerWatchdogBenchmark();
+	registerChainBenchmark();
+	registerContextsBenchmark();
+	registerBroadcastBenchmarks();
+	registerNeighborCellsBenchmark();
+	registerMeldBenchmark();
+	registerConfigBenchmark();
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,168 @@
+/*! @file batchRunner.cpp
+ * @brief Runs the same configuration with several simulation seeds, in a pool of worker processes (see option -b)
+ * @date 17/10/2026
+ */
+
+#include "batchRunner.h"
+
+#include <map>
+#include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <iomanip>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "simulator.h"
+#include "scheduler.h"
+#include "statsCollector.h"
+
+using namespace std;
+using namespace BaseSimulator::utils;
+
+namespace BaseSimulator {
+
+BatchRunner::BatchRunner(int _firstSeed, int _nbRuns, int _nbProcesses)
+    : firstSeed(_firstSeed), nbRuns(_nbRuns), nbProcesses(_nbProcesses) {
+}
+
+void BatchRunner::runWorker(int seed, int fd) {
+    // Only the results of the run are of interest, discard its output
+    int devNull = open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+    }
+
+    Simulator::getSimulator()->reseed(seed);
+    getScheduler()->runInCallingThread();
+
+    StatsCollector &sc = StatsCollector::getInstance();
+    RunResults r;
+    r.seed = seed;
+    r.events = sc.getEventsCount();
+    r.messages = sc.getMsgCount();
+    r.motions = sc.getMotionCount();
+    r.largestEventsQueueSize = sc.getLargestEventsQueueSize();
+    r.simulatedTime = sc.getSimulatedElapsedTime();
+    r.realTime = sc.getRealElapsedTime();
+
+    // Smaller than PIPE_BUF: written at once, whether the parent is reading or not
+    int status = write(fd, &r, sizeof(r)) == sizeof(r) ? EXIT_SUCCESS : EXIT_FAILURE;
+    close(fd);
+
+    // Do not run the destructors of the world and scheduler copies, nor flush the parent streams
+    _exit(status);
+}
+
+bool BatchRunner::run() {
+    map<pid_t, pair<int, int>> workers; // running worker process -> (seed, read end of its pipe)
+    int nextRun = 0;
+
+    cout << "\033[1;33m" << "Batch : " << nbRuns << " runs with seeds " << firstSeed << " to "
+         << firstSeed + nbRuns - 1 << ", " << nbProcesses << " at a time" << "\033[0m" << endl;
+
+    while (nextRun < nbRuns || !workers.empty()) {
+        // Keep the pool full
+        while (nextRun < nbRuns && (int)workers.size() < nbProcesses) {
+            int seed = firstSeed + nextRun;
+            int fds[2];
+            if (pipe(fds) != 0) {
+                perror("error: batch pipe");
+                exit(EXIT_FAILURE);
+            }
+
+            // Pending output would otherwise be written again by the worker
+            cout.flush();
+            cerr.flush();
+
+            pid_t pid = fork();
+            if (pid < 0) {
+                perror("error: batch fork");
+                exit(EXIT_FAILURE);
+            } else if (pid == 0) {
+                close(fds[0]);
+                runWorker(seed, fds[1]);
+            }
+
+            close(fds[1]);
+            workers[pid] = make_pair(seed, fds[0]);
+            nextRun++;
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            perror("error: batch waitpid");
+            exit(EXIT_FAILURE);
+        }
+
+        auto it = workers.find(pid);
+        if (it == workers.end()) continue;
+        int seed = it->second.first;
+        int fd = it->second.second;
+        workers.erase(it);
+
+        RunResults r;
+        bool received = read(fd, &r, sizeof(r)) == sizeof(r);
+        close(fd);
+
+        if (received && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+            results.push_back(r);
+            cout << "Run seed " << r.seed << ": " << r.events << " events, " << r.messages << " messages, "
+                 << r.motions << " motions, simulated time " << r.simulatedTime << " us, real time "
+                 << std::setprecision(2) << std::fixed << r.realTime << " us" << endl;
+        } else {
+            nbFailures++;
+            cerr << "error: batch run with seed " << seed << " failed";
+            if (WIFSIGNALED(status)) cerr << " (signal " << WTERMSIG(status) << ")";
+            cerr << endl;
+        }
+    }
+
+    cout << *this;
+    return nbFailures == 0;
+}
+
+// Prints min mean max standard-deviation of a statistic over all the successful runs
+template<typename T>
+static void printAggregate(ostream &out, const string &name, const vector<RunResults> &results,
+                           T RunResults::*field) {
+    double min = results[0].*field, max = min, sum = 0;
+    for (const RunResults &r : results) {
+        double v = r.*field;
+        min = v < min ? v : min;
+        max = v > max ? v : max;
+        sum += v;
+    }
+    double mean = sum / results.size();
+
+    double variance = 0;
+    for (const RunResults &r : results) {
+        variance += (r.*field - mean) * (r.*field - mean);
+    }
+    variance /= results.size();
+
+    out << name << ": " << std::setprecision(2) << std::fixed << min << " " << mean << " " << max
+        << " " << sqrt(variance) << endl;
+}
+
+ostream& operator<<(ostream& out,const BatchRunner &br) {
+    out << endl << "=== BATCH STATISTICS ===" << endl;
+    out << "Number of runs: " << br.results.size() << " (" << br.nbFailures << " failed)" << endl;
+    if (br.results.empty()) return out;
+
+    out << "Format: \"parameter: min mean max standard-deviation\"" << endl;
+    printAggregate(out, "Simulator elapsed time (us)", br.results, &RunResults::simulatedTime);
+    printAggregate(out, "Real elapsed time (us)", br.results, &RunResults::realTime);
+    printAggregate(out, "Number of events processed", br.results, &RunResults::events);
+    printAggregate(out, "Number of messages processed", br.results, &RunResults::messages);
+    printAggregate(out, "Number of motions processed", br.results, &RunResults::motions);
+    printAggregate(out, "Maximum sized reached by the events list", br.results,
+                   &RunResults::largestEventsQueueSize);
+    return out;
+}
+
+} // namespace BaseSimulator
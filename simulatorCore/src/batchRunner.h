@@ -0,0 +1,63 @@
+/*! @file batchRunner.h
+ * @brief Runs the same configuration with several simulation seeds, in a pool of worker processes (see option -b)
+ * @date 17/10/2026
+ */
+
+#ifndef BATCHRUNNER_H__
+#define BATCHRUNNER_H__
+
+#include <iostream>
+#include <cstdint>
+#include <vector>
+
+#include "tDefs.h"
+
+namespace BaseSimulator {
+
+//!< Statistics of a single run of a batch, sent by the worker process to the parent through a pipe
+struct RunResults {
+    int seed; //!< Simulation seed of the run
+    uint64_t events; //!< Number of events processed
+    uint64_t messages; //!< Number of messages processed
+    uint64_t motions; //!< Number of motions processed
+    uint64_t largestEventsQueueSize; //!< Maximum size reached by the events queue
+    Time simulatedTime; //!< Duration of the run in simulated time (us)
+    double realTime; //!< Duration of the run in real time (us)
+};
+
+/**
+ * @brief Runs the simulation nbRuns times with successive seeds, each run in its own worker process
+ *
+ *  The world is parsed and built once, by the parent process, then each worker is forked from it before the
+ *  scheduler starts, and inherits a copy-on-write copy of the world and of the pending events. A worker re-seeds
+ *  the simulator and block random generators (see Simulator::reseed), runs the scheduler to completion in its
+ *  single thread, and sends its RunResults back to the parent. At most nbProcesses workers run at the same time.
+ *  Workers outputs are discarded, the parent prints a line per run and a report aggregating all runs.
+ */
+class BatchRunner {
+    int firstSeed; //!< Seed of the first run, the following runs use the next seeds
+    int nbRuns; //!< Number of runs
+    int nbProcesses; //!< Maximum number of worker processes running at the same time
+
+    std::vector<RunResults> results; //!< Results of the successful runs, in order of completion
+    int nbFailures = 0; //!< Number of runs whose worker process did not send its results
+
+    //!< Worker process side: runs the simulation with seed and writes its results to fd, never returns
+    void runWorker(int seed, int fd);
+public:
+    BatchRunner(int _firstSeed, int _nbRuns, int _nbProcesses);
+
+    /**
+     * @brief Runs the whole batch and prints its report
+     *  Must be called from the main thread, before the scheduler has been started.
+     * @return false if a run failed
+     */
+    bool run();
+
+    //!< Prints the report aggregating the results of all runs (min mean max standard-deviation of each statistic)
+    friend std::ostream& operator<<(std::ostream& out,const BatchRunner &br);
+};
+
+} // namespace BaseSimulator
+
+#endif // BATCHRUNNER_H__
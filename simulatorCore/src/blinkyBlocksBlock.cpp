@@ -34,22 +34,30 @@ namespace BlinkyBlocks {
   BlinkyBlocksBlock::BlinkyBlocksBlock(int bId, BlockCodeBuilder bcb)
     : BaseSimulator::BuildingBlock(bId, bcb, SCLattice::MAX_NB_NEIGHBORS) {
     OUTPUT << "BlinkyBlocksBlock constructor" << endl;
-    
+    setRandomDataRates();
+}
+
+BlinkyBlocksBlock::~BlinkyBlocksBlock() {
+    OUTPUT << "BlinkyBlocksBlock destructor " << blockId << endl;
+}
+
+void BlinkyBlocksBlock::reseed(ruint seed) {
+    BuildingBlock::reseed(seed);
+    setRandomDataRates();
+}
+
+void BlinkyBlocksBlock::setRandomDataRates() {
     double dataRateMin = ((BLINKYBLOCKS_PACKET_DATASIZE*pow(10,6)*8) / (BLINKYBLOCKS_TRANSMISSION_MAX_TIME*1000));
     double dataRateMax = ((BLINKYBLOCKS_PACKET_DATASIZE*pow(10,6)*8)  / (BLINKYBLOCKS_TRANSMISSION_MIN_TIME*1000));
 
     for (int i = 0; i < SCLattice::MAX_NB_NEIGHBORS; i++) {
       P2PNetworkInterface *p2p = P2PNetworkInterfaces[i];
       doubleRNG g = Random::getUniformDoubleRNG(getRandomUint(),dataRateMin,dataRateMax);
-      RandomRate *r = new RandomRate(g);
+      RandomRate *r = new RandomRate(g,dataRateMax);
       p2p->setDataRate(r);
     }
 }
 
-BlinkyBlocksBlock::~BlinkyBlocksBlock() {
-    OUTPUT << "BlinkyBlocksBlock destructor " << blockId << endl;
-}
-
 void BlinkyBlocksBlock::pauseClock(Time delay, Time start) {
     //while(BaseSimulator::getScheduler()->now()<delay+start){
 
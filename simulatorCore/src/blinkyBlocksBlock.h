@@ -25,6 +25,8 @@ class BlinkyBlocksBlock : public BaseSimulator::BuildingBlock {
 	BlinkyBlocksBlock(int bId, BlockCodeBuilder bcb);
 	~BlinkyBlocksBlock();
 
+	virtual void reseed(ruint seed);
+
 	inline virtual BlinkyBlocksGlBlock* getGlBlock() { return (BlinkyBlocksGlBlock *)ptrGlBlock; };
 
 	P2PNetworkInterface *getInterfaceDestId(int id);
@@ -39,6 +41,10 @@ class BlinkyBlocksBlock : public BaseSimulator::BuildingBlock {
 	void removeNeighbor(P2PNetworkInterface *ni);
 	void stopBlock(Time date, State s);
 	void pauseClock(Time delay, Time start);
+
+protected:
+	//!< Draws a random data rate for each interface from the block random generator
+	void setRandomDataRates();
 };
 
 std::ostream& operator<<(std::ostream &stream, BlinkyBlocksBlock const& bb);
@@ -108,7 +108,7 @@ BlinkyBlocksSimulator::~BlinkyBlocksSimulator() {
 }
 
 void BlinkyBlocksSimulator::createSimulator(int argc, char *argv[], BlockCodeBuilder bcb) {
-	simulator =  new BlinkyBlocksSimulator(argc, argv, bcb);
+	Simulator *simulator = new BlinkyBlocksSimulator(argc, argv, bcb);
 	simulator->parseConfiguration(argc, argv);
 	simulator->startSimulation();
 }
@@ -117,7 +117,7 @@ void BlinkyBlocksSimulator::loadWorld(const Cell3DPosition &gridSize, const Vect
 									  int argc, char *argv[]) {
 	world = new BlinkyBlocksWorld(gridSize, gridScale, argc,argv);
 
-	if (GlutContext::GUIisEnabled)
+	if (GlutContext::isGUIEnabled())
 		world->loadTextures("../../simulatorCore/resources/textures/latticeTextures");
 
 	World::setWorld(world);
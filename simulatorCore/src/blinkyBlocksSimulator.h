@@ -28,8 +28,7 @@ class BlinkyBlocksSimulator : public BaseSimulator::Simulator {
     static void createSimulator(int argc, char *argv[], BlockCodeBuilder bcb);   
 
     static BlinkyBlocksSimulator* getSimulator() {
-	assert(simulator != NULL);
-	return((BlinkyBlocksSimulator*)simulator);
+	return((BlinkyBlocksSimulator*)Simulator::getSimulator());
     }
 
     virtual void loadWorld(const Cell3DPosition &gridSize, const Vector3D &gridScale,
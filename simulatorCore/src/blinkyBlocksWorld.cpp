@@ -26,7 +26,7 @@ BlinkyBlocksWorld::BlinkyBlocksWorld(const Cell3DPosition &gridSize, const Vecto
 									 int argc, char *argv[]):World(argc, argv) {
 	OUTPUT << "\033[1;31mBlinkyBlocksWorld constructor\033[0m" << endl;
 
-	if (GlutContext::GUIisEnabled) {
+	if (GlutContext::isGUIEnabled()) {
 		objBlock = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/blinkyBlocksTextures",
 											"blinkyBlockCentered.obj");
 		objBlockForPicking = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/blinkyBlocksTextures",
@@ -43,7 +43,7 @@ BlinkyBlocksWorld::~BlinkyBlocksWorld() {
 }
 
 void BlinkyBlocksWorld::deleteWorld() {
-	delete((BlinkyBlocksWorld*)world);
+	World::deleteWorld();
 }
 
 void BlinkyBlocksWorld::addBlock(bID blockId, BlockCodeBuilder bcb,
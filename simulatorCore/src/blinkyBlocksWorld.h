@@ -31,8 +31,7 @@ class BlinkyBlocksWorld : public BaseSimulator::World {
 
     static void deleteWorld();
     static BlinkyBlocksWorld* getWorld() {
-        assert(world != NULL);
-        return((BlinkyBlocksWorld*)world);
+        return((BlinkyBlocksWorld*)World::getWorld());
     }
     void printInfo() {
         OUTPUT << "I'm a BlinkyBlocksWorld" << endl;
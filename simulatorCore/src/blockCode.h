@@ -13,6 +13,7 @@
 #include <map>
 
 #include "trace.h"
+#include "stateSnapshot.h"
 #include "target.h"
 #include "TinyXML/tinyxml.h"
 
@@ -27,6 +28,7 @@ class Scheduler;
 class Lattice;
 class BuildingBlock;
 class BlockCode;
+class CheckpointArchive;
 
 typedef std::function<void (BlockCode*,std::shared_ptr<Message>,P2PNetworkInterface*)> eventFunc;
 
@@ -79,6 +81,23 @@ class BlockCode {
 //virtual bool getAttribute(const string &att,ostringstream &sout) { sout << "no debugging"; return false; };
     virtual void addDebugAttributes(Scheduler *scheduler){};
 
+    /**
+     * @brief Saves the variables of the block code that the processing of an event can modify, so that the optimistic
+     *  parallel engine can undo the events it rolls back (see -E optimistic). Not supported by default.
+     *  Overriding block codes save their attributes into s (see StateSnapshot::save), and return true.
+     * @param s snapshot in which the variables are saved
+     * @return true if the block code supports state saving, false otherwise */
+    virtual bool saveState(StateSnapshot &s) { return false; }
+
+    /**
+     * @brief Saves or restores the variables of the block code into a checkpoint file, so that a simulation can be
+     *  resumed from it (see -K and -C). Not supported by default.
+     *  Overriding block codes archive their attributes with `a & attribute` in both directions (see
+     *  CheckpointArchive), the same code saving them, or restoring them if a.isLoading(), and return true.
+     * @param a archive in which the variables are saved, or from which they are restored
+     * @return true if the block code supports checkpoints, false otherwise */
+    virtual bool checkpoint(CheckpointArchive &a) { return false; }
+
     /**
      * @brief This function is called when a module is tapped by the user. Prints a message to the console by default. 
      Can be overloaded in the user blockCode
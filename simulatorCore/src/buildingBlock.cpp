@@ -12,14 +12,12 @@
 #include "simulator.h"
 #include "scheduler.h"
 #include "trace.h"
+#include "checkpoint.h"
 
 using namespace std;
 
 namespace BaseSimulator {
 
-bID BuildingBlock::nextId = 0;
-bool BuildingBlock::userConfigHasBeenParsed = false;
-
 //===========================================================================================================
 //
 //          BuildingBlock  (class)
@@ -27,11 +25,12 @@ bool BuildingBlock::userConfigHasBeenParsed = false;
 //===========================================================================================================
 
   BuildingBlock::BuildingBlock(int bId, BlockCodeBuilder bcb, int nbInterfaces) {
-    OUTPUT << "BuildingBlock constructor (id:" << nextId << ")" << endl;
+    SimulationContext &context = SimulationContext::current();
+    OUTPUT << "BuildingBlock constructor (id:" << context.nextBlockId << ")" << endl;
 	
     if (bId < 0) {
-      blockId = nextId;
-      nextId++;
+      blockId = context.nextBlockId;
+      context.nextBlockId++;
     } else {
       blockId = bId;
     }
@@ -45,7 +44,7 @@ bool BuildingBlock::userConfigHasBeenParsed = false;
 
     buildNewBlockCode = bcb;
 
-    if (utils::StatsIndividual::enable) {
+    if (utils::StatsIndividual::isEnabled()) {
       stats = new StatsIndividual();
     }
     
@@ -54,13 +53,14 @@ bool BuildingBlock::userConfigHasBeenParsed = false;
     }
 	
     wirelessNetworkInterface = new WirelessNetworkInterface(this,4.5,-82,-110);
+    wirelessNetworkInterface->reseed(seed);
     //setDefaultHardwareParameters();
     
     blockCode = (BaseSimulator::BlockCode*)bcb(this);
 
     // Parse user configuration from configuration file, only performed once
-    if (!userConfigHasBeenParsed) {
-      userConfigHasBeenParsed = true;
+    if (!context.userConfigHasBeenParsed) {
+      context.userConfigHasBeenParsed = true;
       blockCode->parseUserElements(Simulator::getSimulator()->getConfigDocument());
     }
     
@@ -162,11 +162,13 @@ unsigned short BuildingBlock::getNbNeighbors() {
 }
 
 void BuildingBlock::scheduleLocalEvent(EventPtr pev) {
-    localEventsList.push_back(pev);
+    Time eventDate = pev->date;
+    willModify(localEventsList);
+    localEventsList.push_back(std::move(pev));
 
     if (localEventsList.size() == 1) {
 		Time date;
-		date = max(pev->date,this->blockCode->availabilityDate); // WARNING: is blockCode->availabilityDate considered?
+		date = max(eventDate,this->blockCode->availabilityDate); // WARNING: is blockCode->availabilityDate considered?
 		if (date < getScheduler()->now()) date=getScheduler()->now();
 		getScheduler()->schedule(new ProcessLocalEvent(date,this));
     }
@@ -181,11 +183,13 @@ void BuildingBlock::processLocalEvent() {
 		getScheduler()->trace("*** ERROR *** The local event list should not be empty !!");
 		exit(EXIT_FAILURE);
     }
-    pev = localEventsList.front();
+    willModify(localEventsList);
+    pev = std::move(localEventsList.front());
     localEventsList.pop_front();
-    blockCode->processLocalEvent(pev);
+    int eventType = pev->eventType;
+    blockCode->processLocalEvent(std::move(pev));
 
-    if (pev->eventType == EVENT_NI_RECEIVE ) {
+    if (eventType == EVENT_NI_RECEIVE ) {
       utils::StatsIndividual::decIncommingMessageQueueSize(stats);
     }
     
@@ -211,6 +215,8 @@ void BuildingBlock::setColor(const Color &c) {
 void BuildingBlock::setPosition(const Cell3DPosition &p) {
     position = p;
     getWorld()->updateGlData(this);
+    getWorld()->updateWirelessMedium(this);
+    wirelessNetworkInterface->invalidateLinks();
 }
 
 void BuildingBlock::tap(Time date, int face) {
@@ -218,7 +224,13 @@ void BuildingBlock::tap(Time date, int face) {
     getScheduler()->schedule(new TapEvent(date, this, (uint8_t)face));
 }
     
+void BuildingBlock::reseed(ruint seed) {
+    generator = uintRNG(seed);
+    wirelessNetworkInterface->reseed(seed);
+}
+
 ruint BuildingBlock::getRandomUint() {
+    willModify(generator);
     return generator();
 }
 
@@ -253,6 +265,58 @@ Time BuildingBlock::getSimulationTime(Time localTime) {
     return clock->getSimulationTime(localTime);
 }
 
+bool BuildingBlock::saveState(StateSnapshot &s) {
+    State st = getState();
+    s.onRestore([this, st] { setState(st); });
+    s.save(color);
+    StatsIndividual::saveState(stats, s);
+    if (clock != NULL) {
+      clock->saveState(s);
+    }
+    for (P2PNetworkInterface *p2p : P2PNetworkInterfaces) {
+      p2p->saveState(s);
+    }
+    wirelessNetworkInterface->saveState(s);
+    s.save(blockCode->availabilityDate);
+    return blockCode->saveState(s);
+}
+
+bool BuildingBlock::checkpoint(CheckpointArchive &a) {
+    State st = getState();
+    Cell3DPosition p = position;
+    a & st & color & p & isMaster;
+    setState(st);
+    if (a.isLoading() && !(p == position)) {
+      // The module has moved since the start of the simulation
+      World *wrld = getWorld();
+      wrld->disconnectBlock(this);
+      setPosition(p);
+      wrld->connectBlock(this);
+    }
+
+    // Module stats may be enabled (-i) when saving and not when restoring, or conversely
+    bool hasStats = stats != NULL;
+    a & hasStats;
+    if (hasStats) {
+      utils::StatsIndividual ignored;
+      a.bytes(stats != NULL ? stats : &ignored, sizeof(ignored));
+    }
+    if (clock != NULL && !clock->checkpoint(a)) {
+      return false;
+    }
+    for (P2PNetworkInterface *p2p : P2PNetworkInterfaces) {
+      p2p->checkpoint(a);
+    }
+    wirelessNetworkInterface->checkpoint(a);
+    a & localEventsList & blockCode->availabilityDate;
+    if (!blockCode->checkpoint(a)) {
+      return false;
+    }
+    // Last: restoring events and block code variables may draw random numbers
+    a & generator;
+    return true;
+}
+
 /*************************************************
  *            MeldInterpreter Functions  
  *************************************************/
@@ -20,6 +20,7 @@
 #include "cell3DPosition.h"
 #include "statsIndividual.h"
 #include "random.h"
+#include "stateSnapshot.h"
 
 class Event;
 typedef std::shared_ptr<Event> EventPtr;
@@ -56,16 +57,13 @@ class BuildingBlock {
 	 */
 	std::atomic<State> state;
 protected:
-	static bID nextId;
-	static bool userConfigHasBeenParsed; //!< Indicates if the user parsing as already been performed by blockCode->parseUserElements. Used to ensure that user configuration is parsed only once.
-	
 	vector<P2PNetworkInterface*> P2PNetworkInterfaces; //!< Vector of size equal to the number of interfaces of the block, contains pointers to the block's interfaces
 	WirelessNetworkInterface *wirelessNetworkInterface;
     
 	list<EventPtr> localEventsList; //!< List of local events scheduled for this block
 public:
     bID blockId; //!< id of the block
-	uintRNG generator; //!< random number generator
+	uintRNG generator; //!< random number generator, drawn through getRandomUint (saved on first draw, see saveState)
 	BlockCode *blockCode; //!< blockcode program executed by the block
 	Clock *clock; //!< internal clock of the block
 	Color color; //!< color of the block
@@ -74,6 +72,8 @@ class BuildingBlock {
 	GlBlock *ptrGlBlock; //!< ptr to the GL object corresponding to this block
 	BlockCodeBuilder buildNewBlockCode; //!< function ptr to the block's blockCodeBuilder
 	utils::StatsIndividual *stats = NULL; //!< Module stats collected during the simulation
+	vector<Event*> queuedEvents; //!< Events of the event list of the scheduler concerning this block, in no particular order (see EventQueue)
+	StateSnapshot *undoLog = NULL; //!< Snapshot of the speculative event being processed for the block, NULL otherwise (see willModify)
 	/**
 	 * @brief BuildingBlock constructor
 	 * @param bId : the block id of the block to create
@@ -88,6 +88,14 @@ class BuildingBlock {
 	 */
 	virtual ~BuildingBlock();  
 
+	/**
+	 * @brief Re-creates the random generators of the block from seed, as if it had been constructed with it
+	 *  Used to run the same configuration with another simulation seed (see BatchRunner). Subclasses owning other
+	 *  random generators must re-create them as well.
+	 * @param seed : seed used to create the block random generator
+	 */
+	virtual void reseed(ruint seed);
+
 	/**
 	 * @brief Getter for P2PNetworkInterfaces attribute
 	 * @return A vector containing pointers to the block's interfaces
@@ -256,6 +264,34 @@ class BuildingBlock {
 	 * @return global time corresponding to the local time in parameter
 	 */   	
 	Time getSimulationTime(Time localTime);
+	/**
+	 * @brief Saves the state of the block that the processing of one of its events can modify: attributes of the
+	 *  block, of its interfaces and of its clock, and variables of its block code (see BlockCode::saveState).
+	 *  Used by the optimistic parallel engine to undo the events it rolls back. Overriding classes must call
+	 *  the parent implementation.
+	 *
+	 *  Called before every speculative event, it only saves small variables. The random generators, the local
+	 *  events and the queues of the interfaces are saved by the event that first modifies them (see willModify).
+	 * @param s snapshot in which the state is saved
+	 * @return false if the block code does not support state saving, true otherwise
+	 */
+	virtual bool saveState(StateSnapshot &s);
+	/**
+	 * @brief Saves variable v of the block, of its interfaces or of its block code into the snapshot of the
+	 *  speculative event being processed, unless it has already been saved there (see saveState). Must be called
+	 *  before v is modified. Does nothing outside of the optimistic parallel engine.
+	 * @param v variable about to be modified by the event being processed
+	 */
+	template<class T>
+	inline void willModify(T &v) { if (undoLog) undoLog->saveOnce(v); }
+	/**
+	 * @brief Saves or restores the state of the block into a checkpoint file (see Checkpoint): attributes of the
+	 *  block, of its interfaces and of its clock, its pending local events, and variables of its block code (see
+	 *  BlockCode::checkpoint). Overriding classes must call the parent implementation.
+	 * @param a archive in which the state is saved, or from which it is restored
+	 * @return false if the block code or the clock does not support checkpoints, true otherwise
+	 */
+	virtual bool checkpoint(CheckpointArchive &a);
 
 	/*************************************************
 	 *            MeldInterpreter Functions  
@@ -33,6 +33,12 @@ Catoms2DBlock::~Catoms2DBlock() {
     OUTPUT << "Catoms2DBlock destructor " << blockId << endl;
 }
 
+void Catoms2DBlock::reseed(ruint seed) {
+    BuildingBlock::reseed(seed);
+    doubleRNG g = Random::getNormalDoubleRNG(getRandomUint(),CATOMS2D_MOTION_SPEED_MEAN,CATOMS2D_MOTION_SPEED_SD);
+    motionEngine->setSpeed(new RandomRate(g));
+}
+
 // PTHY: TODO: Can be genericized in BuildingBlocks
 int Catoms2DBlock::getDirection(P2PNetworkInterface *p2p) {
     if (!p2p) {
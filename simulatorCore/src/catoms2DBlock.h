@@ -38,6 +38,8 @@ class Catoms2DBlock : public BaseSimulator::BuildingBlock {
 	Catoms2DBlock(int bId, BlockCodeBuilder bcb);
 	~Catoms2DBlock();
 
+	virtual void reseed(ruint seed);
+
 	inline void setGlBlock(Catoms2DGlBlock*ptr) { ptrGlBlock=ptr;};
 	P2PNetworkInterface *getInterface(HLattice::Direction d);
 	inline P2PNetworkInterface *getInterface(int d) {
@@ -33,7 +33,7 @@ Catoms2DSimulator::~Catoms2DSimulator() {
 }
 
 void Catoms2DSimulator::createSimulator(int argc, char *argv[], BlockCodeBuilder bcb) {
-	simulator =  new Catoms2DSimulator(argc, argv, bcb);
+	Simulator *simulator = new Catoms2DSimulator(argc, argv, bcb);
 	simulator->parseConfiguration(argc, argv);
 	simulator->startSimulation();
 }
@@ -42,7 +42,7 @@ void Catoms2DSimulator::loadWorld(const Cell3DPosition &gridSize, const Vector3D
 								  int argc, char *argv[]) {
     world = new Catoms2DWorld(gridSize, gridScale, argc,argv);
 	
-	if (GlutContext::GUIisEnabled)
+	if (GlutContext::isGUIEnabled())
 		world->loadTextures("../../simulatorCore/resources/textures/latticeTextures");
 	
 	World::setWorld(world);
@@ -29,8 +29,7 @@ class Catoms2DSimulator : public BaseSimulator::Simulator {
     static void createSimulator(int argc, char *argv[], BlockCodeBuilder bcb);
 
     static Catoms2DSimulator* getSimulator() {
-	assert(simulator != NULL);
-	return((Catoms2DSimulator*)simulator);
+	return((Catoms2DSimulator*)Simulator::getSimulator());
     }
 
     virtual void loadWorld(const Cell3DPosition &gridSize, const Vector3D &gridScale,
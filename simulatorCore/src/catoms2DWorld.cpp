@@ -30,7 +30,7 @@ Catoms2DWorld::Catoms2DWorld(const Cell3DPosition &gridSize, const Vector3D &gri
                              int argc, char *argv[]):World(argc, argv) {
     OUTPUT << "\033[1;31mCatoms2DWorld constructor\033[0m" << endl;
 
-    if (GlutContext::GUIisEnabled) {
+    if (GlutContext::isGUIEnabled()) {
         objBlock = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/catoms2DTextures",
                                             "catom2D.obj");
         objBlockForPicking = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/catoms2DTextures",
@@ -47,7 +47,7 @@ Catoms2DWorld::~Catoms2DWorld() {
 }
 
 void Catoms2DWorld::deleteWorld() {
-    delete((Catoms2DWorld*)world);
+    World::deleteWorld();
 }
 void Catoms2DWorld::addBlock(bID blockId, BlockCodeBuilder bcb,
                              const Cell3DPosition &pos, const Color &col,
@@ -35,8 +35,7 @@ class Catoms2DWorld : public BaseSimulator::World {
 
     static void deleteWorld();
     static Catoms2DWorld* getWorld() {
-    assert(world != NULL);
-    return((Catoms2DWorld*)world);
+    return((Catoms2DWorld*)World::getWorld());
     }
 
     void printInfo() {
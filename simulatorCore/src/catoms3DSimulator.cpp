@@ -32,7 +32,7 @@ Catoms3DSimulator::~Catoms3DSimulator() {
 }
 
 void Catoms3DSimulator::createSimulator(int argc, char *argv[], BlockCodeBuilder bcb) {
-	simulator =  new Catoms3DSimulator(argc, argv, bcb);
+	Simulator *simulator = new Catoms3DSimulator(argc, argv, bcb);
 	simulator->parseConfiguration(argc, argv);
 	simulator->startSimulation();
 }
@@ -41,7 +41,7 @@ void Catoms3DSimulator::loadWorld(const Cell3DPosition &gridSize, const Vector3D
 				      int argc, char *argv[]) {
     world = new Catoms3DWorld(gridSize, gridScale, argc, argv);
 
-	if (GlutContext::GUIisEnabled) 
+	if (GlutContext::isGUIEnabled()) 
 		world->loadTextures("../../simulatorCore/resources/textures/latticeTextures");
 	
     World::setWorld(world);
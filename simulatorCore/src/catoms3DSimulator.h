@@ -29,8 +29,7 @@ class Catoms3DSimulator : public BaseSimulator::Simulator {
     static void createSimulator(int argc, char *argv[], BlockCodeBuilder bcb);
 
     static Catoms3DSimulator* getSimulator() {
-	assert(simulator != NULL);
-	return((Catoms3DSimulator*)simulator);
+	return((Catoms3DSimulator*)Simulator::getSimulator());
     }
    
     virtual void loadWorld(const Cell3DPosition &gridSize, const Vector3D &gridScale,
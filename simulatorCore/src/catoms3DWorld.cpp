@@ -34,7 +34,7 @@ Catoms3DWorld::Catoms3DWorld(const Cell3DPosition &gridSize, const Vector3D &gri
 							 int argc, char *argv[]):World(argc, argv) {
     OUTPUT << "\033[1;31mCatoms3DWorld constructor\033[0m" << endl;
 
-    if (GlutContext::GUIisEnabled) {
+    if (GlutContext::isGUIEnabled()) {
 		objBlock = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/catoms3DTextures",
 											"catom3Dsimple.obj");
 		objBlockForPicking =
@@ -52,7 +52,7 @@ Catoms3DWorld::~Catoms3DWorld() {
 }
 
 void Catoms3DWorld::deleteWorld() {
-    delete((Catoms3DWorld*)world);
+    World::deleteWorld();
 }
 
 void Catoms3DWorld::addBlock(bID blockId, BlockCodeBuilder bcb, const Cell3DPosition &pos, const Color &col,
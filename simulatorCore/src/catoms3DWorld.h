@@ -40,8 +40,7 @@ class Catoms3DWorld : public BaseSimulator::World {
 
     static void deleteWorld();
     static Catoms3DWorld* getWorld() {
-        assert(world != NULL);
-        return((Catoms3DWorld*)world);
+        return((Catoms3DWorld*)World::getWorld());
     }
 
     void printInfo() {
@@ -0,0 +1,153 @@
+/*! @file channelModel.cpp
+ * @brief Radio channel models of the wireless interfaces: received power as a function of the distance between
+ *  modules, and its random variation (see <wireless channel="..."/> in the configuration file)
+ * @date 17/10/2026
+ */
+
+#include "channelModel.h"
+
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+
+#include "TinyXML/tinyxml.h"
+
+using namespace std;
+
+namespace BaseSimulator {
+
+#define SPEED_OF_LIGHT	299.792458 //!< Speed of light, in m/us (frequencies are in MHz)
+
+//===========================================================================================================
+//
+//          ChannelModel  (class)
+//
+//===========================================================================================================
+
+double ChannelModel::getRangeOfSlope(float budget, float sensitivity, double slope, double reference) {
+	double margin = budget - sensitivity + CHANNEL_MAX_DEVIATIONS * deviation + CHANNEL_RANGE_MARGIN;
+	return reference * pow(10.0, margin / slope) / CHANNEL_CELL_DISTANCE;
+}
+
+float ChannelModel::getShadowing(uintRNG &generator) {
+	if (deviation <= 0) return 0;
+	std::normal_distribution<float> distribution(0, deviation);
+	float shadowing = distribution(generator);
+	float bound = CHANNEL_MAX_DEVIATIONS * deviation;
+	if (shadowing > bound) shadowing = bound;
+	else if (shadowing < -bound) shadowing = -bound;
+	return shadowing;
+}
+
+ChannelModel* ChannelModel::create(TiXmlElement *element) {
+	ChannelModel *channel = createModel(element);
+	if (channel && element) {
+		const char *attr = element->Attribute("wallAttenuation");
+		if (attr) {
+			if (atof(attr) < 0) {
+				delete channel;
+				return NULL;
+			}
+			channel->setWallAttenuation(atof(attr));
+		}
+	}
+	return channel;
+}
+
+ChannelModel* ChannelModel::createModel(TiXmlElement *element) {
+	const char *name = element ? element->Attribute("channel") : NULL;
+	if (name == NULL) return new TwoRayChannelModel();
+
+	// Parameters that are not set take their default value
+	auto value = [element](const char *attribute, double defaultValue) {
+		const char *attr = element->Attribute(attribute);
+		return attr ? atof(attr) : defaultValue;
+	};
+	string model(name);
+	if (model == "freeSpace") {
+		double frequency = value("frequency", FREE_SPACE_FREQUENCY);
+		if (frequency > 0) return new FreeSpaceChannelModel(frequency);
+	} else if (model == "twoRay") {
+		double deviation = value("deviation", TWO_RAY_DEVIATION);
+		if (deviation >= 0) return new TwoRayChannelModel(deviation);
+	} else if (model == "logDistance") {
+		double exponent = value("exponent", LOG_DISTANCE_EXPONENT);
+		double reference = value("referenceDistance", LOG_DISTANCE_REFERENCE);
+		double deviation = value("deviation", LOG_DISTANCE_DEVIATION);
+		if (exponent > 0 && reference > 0 && deviation >= 0) {
+			return new LogDistanceChannelModel(exponent, reference,
+											   value("referenceLoss", LOG_DISTANCE_REFERENCE_LOSS), deviation);
+		}
+	} else if (model == "unitDisk") {
+		double range = value("range", UNIT_DISK_RANGE);
+		if (range >= 0) return new UnitDiskChannelModel(range);
+	}
+	return NULL;
+}
+
+//===========================================================================================================
+//
+//          FreeSpaceChannelModel  (class)
+//
+//===========================================================================================================
+
+FreeSpaceChannelModel::FreeSpaceChannelModel(float frequency) : ChannelModel(0) {
+	lossAt1m = 20 * log10(4 * M_PI * frequency / SPEED_OF_LIGHT);
+}
+
+float FreeSpaceChannelModel::getLinkBudget(float power, double distance) {
+	return power - lossAt1m - 20 * log10(distance * CHANNEL_CELL_DISTANCE);
+}
+
+double FreeSpaceChannelModel::getMaxRange(float power, float sensitivity) {
+	return getRangeOfSlope(power - lossAt1m, sensitivity, 20, 1);
+}
+
+//===========================================================================================================
+//
+//          TwoRayChannelModel  (class)
+//
+//===========================================================================================================
+
+float TwoRayChannelModel::getLinkBudget(float power, double distance) {
+	// Antennas heights of 1 cancel the height gain, 10 * log10(ht^2 * hr^2)
+	return power - TWO_RAY_DISTANCE_FACTOR * log10(distance * CHANNEL_CELL_DISTANCE);
+}
+
+double TwoRayChannelModel::getMaxRange(float power, float sensitivity) {
+	return getRangeOfSlope(power, sensitivity, TWO_RAY_DISTANCE_FACTOR, 1);
+}
+
+//===========================================================================================================
+//
+//          LogDistanceChannelModel  (class)
+//
+//===========================================================================================================
+
+LogDistanceChannelModel::LogDistanceChannelModel(float e, float r, float l, float d)
+	: ChannelModel(d), exponent(e), reference(r), referenceLoss(l) {
+}
+
+float LogDistanceChannelModel::getLinkBudget(float power, double distance) {
+	return power - referenceLoss - 10 * exponent * log10(distance * CHANNEL_CELL_DISTANCE / reference);
+}
+
+double LogDistanceChannelModel::getMaxRange(float power, float sensitivity) {
+	return getRangeOfSlope(power - referenceLoss, sensitivity, 10 * exponent, reference);
+}
+
+//===========================================================================================================
+//
+//          UnitDiskChannelModel  (class)
+//
+//===========================================================================================================
+
+UnitDiskChannelModel::UnitDiskChannelModel(double r) : ChannelModel(0), range(r) {
+	range2 = r >= 0 ? (int64_t)floor(r * r) : -1;
+}
+
+float UnitDiskChannelModel::getLinkBudget(float power, double distance) {
+	return distance <= range ? power : -numeric_limits<float>::infinity();
+}
+
+} // namespace BaseSimulator
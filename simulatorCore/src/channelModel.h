@@ -0,0 +1,164 @@
+/*! @file channelModel.h
+ * @brief Radio channel models of the wireless interfaces: received power as a function of the distance between
+ *  modules, and its random variation (see <wireless channel="..."/> in the configuration file)
+ * @date 17/10/2026
+ */
+
+#ifndef CHANNELMODEL_H__
+#define CHANNELMODEL_H__
+
+#include <cstdint>
+#include <string>
+
+#include "random.h"
+#include "cell3DPosition.h"
+
+class TiXmlElement;
+
+#define CHANNEL_CELL_DISTANCE		10 //!< Distance (m) between the centers of two adjacent cells
+#define CHANNEL_MAX_DEVIATIONS		4 //!< Bound of the shadowing, in standard deviations, which bounds the radio range
+#define CHANNEL_RANGE_MARGIN		0.01 //!< Margin (dB) of the ranges, covering the rounding of the received powers
+
+#define TWO_RAY_DISTANCE_FACTOR		25 //!< Attenuation (dB) of the two-ray ground model per decade of distance
+#define TWO_RAY_DEVIATION			4 //!< Default standard deviation (dB) of the shadowing of the two-ray ground model
+#define FREE_SPACE_FREQUENCY		2400 //!< Default frequency (MHz) of the free-space model
+#define LOG_DISTANCE_EXPONENT		3 //!< Default path loss exponent of the log-distance model
+#define LOG_DISTANCE_REFERENCE		1 //!< Default reference distance (m) of the log-distance model
+#define LOG_DISTANCE_REFERENCE_LOSS	40 //!< Default path loss (dB) at the reference distance, free space at 2.4 GHz
+#define LOG_DISTANCE_DEVIATION		4 //!< Default standard deviation (dB) of the shadowing of the log-distance model
+#define UNIT_DISK_RANGE				10 //!< Default radius (cells) of the unit-disk model
+#define CHANNEL_WALL_ATTENUATION	0 //!< Default attenuation (dB) of a signal crossing a wall, walls are transparent
+
+namespace BaseSimulator {
+
+/**
+ * @brief Radio channel shared by the wireless interfaces of a simulation
+ *
+ *  The power (dBm) received from a transmission is the link budget, which only depends on the transmit power and
+ *  on the distance between the modules in the plane (x, y), plus a random shadowing, drawn for every reception from
+ *  the generator of the receiving interface. Shadowings are bounded to CHANNEL_MAX_DEVIATIONS standard deviations,
+ *  so that every model has a finite range, beyond which the spatial index of the medium skips the modules.
+ */
+class ChannelModel {
+protected:
+	float deviation; //!< Standard deviation (dB) of the shadowing, 0 if there is none
+	float wallAttenuation = CHANNEL_WALL_ATTENUATION; //!< Attenuation (dB) of a signal crossing a wall (see ObstacleGrid)
+
+	/**
+	 * @brief Returns the distance at which a received power decreasing by slope dB per decade of distance, equal to
+	 *  budget at distance reference, falls to the sensitivity, even with the largest shadowing
+	 */
+	double getRangeOfSlope(float budget, float sensitivity, double slope, double reference);
+	//!< @brief Creates the model named by the channel attribute of element, with its parameters (see create)
+	static ChannelModel* createModel(TiXmlElement *element);
+public:
+	enum Type { FREE_SPACE, TWO_RAY, LOG_DISTANCE, UNIT_DISK };
+
+	ChannelModel(float d) : deviation(d) {};
+	virtual ~ChannelModel() {};
+
+	//!< @brief Returns the type of the model
+	virtual Type getType() const = 0;
+	//!< @brief Returns the name of the model, as in the configuration file
+	virtual std::string getName() const = 0;
+
+	/**
+	 * @brief Returns the received power before shadowing
+	 * @param power : transmit power (dBm)
+	 * @param distance : distance between the modules, in cells
+	 * @return mean received power (dBm)
+	 */
+	virtual float getLinkBudget(float power, double distance) = 0;
+	/**
+	 * @brief Returns the distance beyond which a transmission cannot be sensed, whatever the shadowing
+	 * @param power : transmit power (dBm)
+	 * @param sensitivity : reception sensitivity (dBm) of the receivers
+	 * @return the range, in cells
+	 */
+	virtual double getMaxRange(float power, float sensitivity) = 0;
+	//!< @brief Draws the shadowing (dB) of a reception from generator
+	float getShadowing(uintRNG &generator);
+	//!< @brief Getter for the attenuation (dB) of a signal crossing a wall, subtracted from the link budget for each
+	//!<  wall between the modules. Ignored by the unit-disk model.
+	float getWallAttenuation() const { return wallAttenuation; };
+	//!< @brief Setter for the attenuation (dB) of a signal crossing a wall
+	void setWallAttenuation(float a) { wallAttenuation = a; };
+
+	/**
+	 * @brief Creates the model of a wireless element of the configuration, whose attribute channel names the model
+	 *  (freeSpace, twoRay, logDistance or unitDisk), and whose other attributes set its parameters, as well as the
+	 *  attenuation of the walls (wallAttenuation)
+	 * @param element : the wireless element, the default model is created if it is NULL or names no model
+	 * @return the model, NULL if the name is unknown or a parameter is out of its domain
+	 */
+	static ChannelModel* create(TiXmlElement *element);
+};
+
+/**
+ * @brief Friis free-space model: the received power decreases by 20 dB per decade of distance, from the loss of a
+ *  distance of 1 m at the frequency of the channel. No shadowing.
+ */
+class FreeSpaceChannelModel : public ChannelModel {
+	float lossAt1m; //!< Path loss (dB) at 1 m, 20 log10(4 pi / wavelength)
+public:
+	FreeSpaceChannelModel(float frequency = FREE_SPACE_FREQUENCY);
+	Type getType() const { return FREE_SPACE; };
+	std::string getName() const { return "freeSpace"; };
+	float getLinkBudget(float power, double distance);
+	double getMaxRange(float power, float sensitivity);
+};
+
+/**
+ * @brief Two-ray ground model of the wireless interfaces, with antennas of height 1: the received power decreases
+ *  by TWO_RAY_DISTANCE_FACTOR dB per decade of distance, plus a normal shadowing. Default model.
+ */
+class TwoRayChannelModel : public ChannelModel {
+public:
+	TwoRayChannelModel(float deviation = TWO_RAY_DEVIATION) : ChannelModel(deviation) {};
+	Type getType() const { return TWO_RAY; };
+	std::string getName() const { return "twoRay"; };
+	float getLinkBudget(float power, double distance);
+	double getMaxRange(float power, float sensitivity);
+};
+
+/**
+ * @brief Log-distance model: the path loss is a given loss at a reference distance, increased by 10 * exponent dB
+ *  per decade of distance beyond it, plus a normal shadowing
+ */
+class LogDistanceChannelModel : public ChannelModel {
+	float exponent; //!< Path loss exponent, 2 in free space, 2.7 to 5 in buildings
+	float reference; //!< Reference distance (m)
+	float referenceLoss; //!< Path loss (dB) at the reference distance
+public:
+	LogDistanceChannelModel(float exponent = LOG_DISTANCE_EXPONENT, float reference = LOG_DISTANCE_REFERENCE,
+							float referenceLoss = LOG_DISTANCE_REFERENCE_LOSS, float deviation = LOG_DISTANCE_DEVIATION);
+	Type getType() const { return LOG_DISTANCE; };
+	std::string getName() const { return "logDistance"; };
+	float getLinkBudget(float power, double distance);
+	double getMaxRange(float power, float sensitivity);
+};
+
+/**
+ * @brief Unit-disk model: every module within a radius hears and decodes the transmissions, the others do not
+ *  sense them. Receptions only compare integer squared distances (see covers), without any power computation.
+ */
+class UnitDiskChannelModel : public ChannelModel {
+	double range; //!< Radius of the disk (cells)
+	int64_t range2; //!< Largest squared distance (cells) within the disk
+public:
+	UnitDiskChannelModel(double range = UNIT_DISK_RANGE);
+	Type getType() const { return UNIT_DISK; };
+	std::string getName() const { return "unitDisk"; };
+	//!< @brief Returns the transmit power within the disk, minus infinity beyond it
+	float getLinkBudget(float power, double distance);
+	double getMaxRange(float power, float sensitivity) { return range; };
+	//!< @brief Returns true if the module at position p is within the disk centered on the module at position c
+	inline bool covers(const Cell3DPosition &c, const Cell3DPosition &p) const {
+		int64_t dx = p[0] - c[0], dy = p[1] - c[1];
+		return dx * dx + dy * dy <= range2;
+	}
+};
+
+} // namespace BaseSimulator
+
+#endif // CHANNELMODEL_H__
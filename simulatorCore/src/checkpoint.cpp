@@ -0,0 +1,515 @@
+/*! @file checkpoint.cpp
+ * @brief Saves the state of a running simulation to a binary file, and resumes a simulation from it (see options
+ *  -K and -C)
+ * @date 17/10/2026
+ */
+
+#include "checkpoint.h"
+
+#include <cstdio>
+#include <sstream>
+#include <typeinfo>
+
+#include "simulator.h"
+#include "scheduler.h"
+#include "world.h"
+#include "buildingBlock.h"
+#include "simulationContext.h"
+#include "statsCollector.h"
+
+using namespace std;
+
+namespace BaseSimulator {
+
+//===========================================================================================================
+//
+//          CheckpointArchive  (class)
+//
+//===========================================================================================================
+
+CheckpointArchive::CheckpointArchive(const string &path, bool load) : loading(load) {
+	if (loading) {
+		in.open(path, ios::in | ios::binary);
+	} else {
+		out.open(path, ios::out | ios::binary | ios::trunc);
+	}
+	if (loading ? !in.is_open() : !out.is_open()) {
+		throw CheckpointException("cannot open " + path);
+	}
+	if (loading) {
+		in.seekg(0, ios::end);
+		fileSize = in.tellg();
+		in.seekg(0, ios::beg);
+	}
+}
+
+void CheckpointArchive::bytes(void *p, size_t n) {
+	if (loading) {
+		in.read((char*)p, n);
+		if (!in) throw CheckpointException("unexpected end of file");
+	} else {
+		out.write((const char*)p, n);
+		if (!out) throw CheckpointException("write error");
+	}
+}
+
+void CheckpointArchive::checkCount(uint64_t n, uint64_t elementSize) {
+	if (!loading) return;
+	uint64_t left = fileSize - in.tellg();
+	if (n > left / elementSize) {
+		throw CheckpointException("corrupted size " + to_string(n) + ", only " + to_string(left)
+								  + " bytes left in the file");
+	}
+}
+
+void CheckpointArchive::close() {
+	if (loading) {
+		in.close();
+	} else {
+		out.close();
+		if (!out) throw CheckpointException("write error");
+	}
+}
+
+CheckpointArchive& CheckpointArchive::operator&(string &s) {
+	uint64_t n = s.size();
+	*this & n;
+	checkCount(n, 1);
+	if (loading) s.resize(n);
+	if (n > 0) bytes(&s[0], n);
+	return *this;
+}
+
+CheckpointArchive& CheckpointArchive::operator&(uintRNG &g) {
+	string state;
+	if (!loading) {
+		ostringstream ss;
+		ss << g;
+		state = ss.str();
+	}
+	*this & state;
+	if (loading) {
+		istringstream ss(state);
+		ss >> g;
+		if (!ss) throw CheckpointException("corrupted random generator state");
+	}
+	return *this;
+}
+
+CheckpointArchive& CheckpointArchive::operator&(BuildingBlock *&bb) {
+	// When loading, the pointer is not initialized yet
+	bool present = !loading && bb != NULL;
+	bID id = present ? bb->blockId : 0;
+	*this & present;
+	if (!present) {
+		bb = NULL;
+		return *this;
+	}
+	*this & id;
+	if (loading) {
+		bb = getWorld()->getBlockById(id);
+		if (bb == NULL) throw CheckpointException("module " + to_string(id) + " does not exist");
+	}
+	return *this;
+}
+
+CheckpointArchive& CheckpointArchive::operator&(P2PNetworkInterface *&ni) {
+	BuildingBlock *bb = !loading && ni ? ni->hostBlock : NULL;
+	*this & bb;
+	if (bb == NULL) {
+		ni = NULL;
+		return *this;
+	}
+
+	vector<P2PNetworkInterface*> &interfaces = bb->getP2PNetworkInterfaces();
+	uint32_t index = 0;
+	if (!loading) {
+		while (index < interfaces.size() && interfaces[index] != ni) index++;
+	}
+	*this & index;
+	if (index >= interfaces.size()) {
+		throw CheckpointException("interface " + to_string(index) + " of module " + to_string(bb->blockId)
+								  + " does not exist");
+	}
+	ni = interfaces[index];
+	return *this;
+}
+
+CheckpointArchive& CheckpointArchive::operator&(WirelessNetworkInterface *&ni) {
+	BuildingBlock *bb = !loading && ni ? ni->hostBlock : NULL;
+	*this & bb;
+	ni = bb ? bb->getWirelessNetworkInterface() : NULL;
+	return *this;
+}
+
+template<class T> bool CheckpointArchive::shared(std::shared_ptr<T> &p, uint32_t &slot) {
+	// Reference: 0 for NULL, the index + 1 of an object already archived, or the next index for a new object
+	uint32_t ref = 0;
+	if (loading) {
+		*this & ref;
+		if (ref == 0) {
+			p.reset();
+			return true;
+		} else if (ref <= loadedObjects.size()) {
+			p = static_pointer_cast<T>(loadedObjects[ref - 1]);
+			if (!p) throw CheckpointException("corrupted object reference");
+			return true;
+		} else if (ref != loadedObjects.size() + 1) {
+			throw CheckpointException("corrupted object reference");
+		}
+		// Reserved now, as the objects it refers to are archived before it is constructed
+		slot = loadedObjects.size();
+		loadedObjects.push_back(NULL);
+		return false;
+	}
+
+	if (p) {
+		auto it = savedObjects.find(p.get());
+		if (it != savedObjects.end()) {
+			ref = it->second;
+		} else {
+			ref = savedObjects.size() + 1;
+			savedObjects[p.get()] = ref;
+			*this & ref;
+			return false;
+		}
+	}
+	*this & ref;
+	return true;
+}
+
+CheckpointArchive& CheckpointArchive::operator&(MessagePtr &m) {
+	uint32_t slot;
+	if (shared(m, slot)) return *this;
+
+	// When loading, m may still hold a previous value
+	Message *msg = loading ? NULL : m.get();
+	// Plain messages need no registration
+	bool plain = !loading && typeid(*msg) == typeid(Message);
+	unsigned int type = loading ? 0 : msg->type;
+	*this & plain & type;
+	if (plain) {
+		if (loading) msg = new Message();
+	} else {
+		Checkpointer<Message> c = Checkpoint::getMessageCheckpointer(type);
+		if (!c) {
+			throw CheckpointException("messages of type " + to_string(type)
+									  + (loading ? "" : " (" + msg->getMessageName() + ")")
+									  + " are not registered (see Checkpoint::registerMessage)");
+		}
+		msg = c(*this, msg);
+	}
+	*this & msg->id & msg->type & msg->sourceInterface & msg->destinationInterface;
+
+	if (loading) {
+		m = MessagePtr(msg);
+		loadedObjects[slot] = m;
+	}
+	return *this;
+}
+
+CheckpointArchive& CheckpointArchive::operator&(WirelessMessagePtr &m) {
+	uint32_t slot;
+	if (shared(m, slot)) return *this;
+
+	WirelessMessage *msg = loading ? NULL : m.get();
+	bool plain = !loading && typeid(*msg) == typeid(WirelessMessage);
+	unsigned int type = loading ? 0 : msg->type;
+	*this & plain & type;
+	if (plain) {
+		if (loading) msg = new WirelessMessage(0);
+	} else {
+		Checkpointer<WirelessMessage> c = Checkpoint::getWirelessMessageCheckpointer(type);
+		if (!c) {
+			throw CheckpointException("wireless messages of type " + to_string(type)
+									  + (loading ? "" : " (" + msg->getMessageName() + ")")
+									  + " are not registered (see Checkpoint::registerWirelessMessage)");
+		}
+		msg = c(*this, msg);
+	}
+	*this & msg->id & msg->type & msg->sourceInterface & msg->destinationId & msg->sequenceNumber;
+
+	if (loading) {
+		m = WirelessMessagePtr(msg);
+		loadedObjects[slot] = m;
+	}
+	return *this;
+}
+
+CheckpointArchive& CheckpointArchive::operator&(EventPtr &ev) {
+	uint32_t slot;
+	if (shared(ev, slot)) return *this;
+
+	int type = loading ? 0 : ev->eventType;
+	*this & type;
+	Checkpointer<Event> c = Checkpoint::getEventCheckpointer(type);
+	if (!c) {
+		throw CheckpointException("events of type " + to_string(type)
+								  + (loading ? "" : " (" + ev->getEventName() + ")")
+								  + " are not supported (see Checkpoint::registerEvent)");
+	}
+	Event *e = c(*this, loading ? NULL : ev.get());
+	*this & e->id & e->date & e->randomNumber;
+
+	if (loading) {
+		e->eventType = type;
+		ev = makeEventPtr(e);
+		loadedObjects[slot] = ev;
+	}
+	return *this;
+}
+
+//===========================================================================================================
+//
+//          Checkpointers of the core events
+//
+//===========================================================================================================
+
+// Events only holding their concerned block
+template<class E> static Event* checkpointBlockEvent(CheckpointArchive &a, Event *e) {
+	BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+	a & bb;
+	return e ? e : new E(0, bb);
+}
+
+// Events only holding an interface
+template<class E, class I> static Event* checkpointInterfaceEvent(CheckpointArchive &a, Event *e) {
+	I *ni = e ? static_cast<E*>(e)->interface : NULL;
+	a & ni;
+	return e ? e : new E(0, ni);
+}
+
+// Medium access control events, holding an interface and the version of the backoff or timeout
+template<class E> static Event* checkpointMacEvent(CheckpointArchive &a, Event *e) {
+	WirelessNetworkInterface *ni = e ? static_cast<E*>(e)->interface : NULL;
+	uint32_t version = e ? static_cast<E*>(e)->version : 0;
+	a & ni & version;
+	return e ? e : new E(0, ni, version);
+}
+
+// Events holding an interface and a message
+template<class E, class I, class M> static Event* checkpointMessageEvent(CheckpointArchive &a, Event *e) {
+	I *ni = e ? static_cast<E*>(e)->interface : NULL;
+	M m = e ? static_cast<E*>(e)->message : M();
+	a & ni & m;
+	return e ? e : new E(0, ni, m);
+}
+
+// Enqueue events, holding a message and its source interface
+template<class E, class I, class M> static Event* checkpointEnqueueEvent(CheckpointArchive &a, Event *e) {
+	I *ni = e ? static_cast<E*>(e)->sourceInterface : NULL;
+	M m = e ? static_cast<E*>(e)->message : M();
+	a & ni & m;
+	return e ? e : new E(0, m, ni);
+}
+
+static map<int, Checkpointer<Event>> &eventCheckpointers() {
+	static map<int, Checkpointer<Event>> checkpointers = {
+		{ EVENT_CODE_START, checkpointBlockEvent<CodeStartEvent> },
+		{ EVENT_PROCESS_LOCAL_EVENT, checkpointBlockEvent<ProcessLocalEvent> },
+		{ EVENT_END_SIMULATION, [](CheckpointArchive &a, Event *e) -> Event* {
+			return e ? e : new CodeEndSimulationEvent(0);
+		} },
+		{ EVENT_NI_START_TRANSMITTING,
+		  checkpointInterfaceEvent<NetworkInterfaceStartTransmittingEvent, P2PNetworkInterface> },
+		{ EVENT_NI_STOP_TRANSMITTING,
+		  checkpointInterfaceEvent<NetworkInterfaceStopTransmittingEvent, P2PNetworkInterface> },
+		{ EVENT_NI_DELIVER,
+		  checkpointMessageEvent<NetworkInterfaceDeliverEvent, P2PNetworkInterface, MessagePtr> },
+		{ EVENT_NI_RECEIVE,
+		  checkpointMessageEvent<NetworkInterfaceReceiveEvent, P2PNetworkInterface, MessagePtr> },
+		{ EVENT_NI_ENQUEUE_OUTGOING_MESSAGE,
+		  checkpointEnqueueEvent<NetworkInterfaceEnqueueOutgoingEvent, P2PNetworkInterface, MessagePtr> },
+		{ EVENT_WNI_START_TRANSMITTING,
+		  checkpointInterfaceEvent<WirelessNetworkInterfaceStartTransmittingEvent, WirelessNetworkInterface> },
+		{ EVENT_WNI_STOP_TRANSMITTING,
+		  checkpointInterfaceEvent<WirelessNetworkInterfaceStopTransmittingEvent, WirelessNetworkInterface> },
+		{ EVENT_WNI_START_RECEIVE,
+		  checkpointMessageEvent<WirelessNetworkInterfaceStartReceiveEvent, WirelessNetworkInterface,
+								 WirelessMessagePtr> },
+		{ EVENT_WNI_STOP_RECEIVE,
+		  checkpointInterfaceEvent<WirelessNetworkInterfaceStopReceiveEvent, WirelessNetworkInterface> },
+		{ EVENT_WNI_MESSAGE_RECEIVED,
+		  checkpointMessageEvent<WirelessNetworkInterfaceMessageReceivedEvent, WirelessNetworkInterface,
+								 WirelessMessagePtr> },
+		{ EVENT_WNI_ENQUEUE_OUTGOING_MESSAGE,
+		  checkpointEnqueueEvent<WirelessNetworkInterfaceEnqueueOutgoingEvent, WirelessNetworkInterface,
+								 WirelessMessagePtr> },
+		{ EVENT_WNI_CHANNEL_LISTENING, checkpointMacEvent<WirelessNetworkInterfaceChannelListeningEvent> },
+		{ EVENT_WNI_IDLE, checkpointInterfaceEvent<WirelessNetworkInterfaceIdleEvent, WirelessNetworkInterface> },
+		{ EVENT_WNI_ACK_TIMEOUT, checkpointMacEvent<WirelessNetworkInterfaceAckTimeoutEvent> },
+		{ EVENT_WNI_SEND_ACK,
+		  checkpointMessageEvent<WirelessNetworkInterfaceSendAckEvent, WirelessNetworkInterface, WirelessMessagePtr> },
+		{ EVENT_SET_COLOR, [](CheckpointArchive &a, Event *e) -> Event* {
+			BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+			Color c = e ? static_cast<SetColorEvent*>(e)->color : Color();
+			a & bb & c;
+			return e ? e : new SetColorEvent(0, bb, c);
+		} },
+		{ EVENT_ADD_NEIGHBOR, [](CheckpointArchive &a, Event *e) -> Event* {
+			BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+			uint64_t face = e ? static_cast<AddNeighborEvent*>(e)->face : 0;
+			uint64_t target = e ? static_cast<AddNeighborEvent*>(e)->target : 0;
+			a & bb & face & target;
+			return e ? e : new AddNeighborEvent(0, bb, face, target);
+		} },
+		{ EVENT_REMOVE_NEIGHBOR, [](CheckpointArchive &a, Event *e) -> Event* {
+			BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+			uint64_t face = e ? static_cast<RemoveNeighborEvent*>(e)->face : 0;
+			a & bb & face;
+			return e ? e : new RemoveNeighborEvent(0, bb, face);
+		} },
+		{ EVENT_TAP, [](CheckpointArchive &a, Event *e) -> Event* {
+			BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+			int face = e ? static_cast<TapEvent*>(e)->tappedFace : 0;
+			a & bb & face;
+			return e ? e : new TapEvent(0, bb, face);
+		} },
+		{ EVENT_ACCEL, [](CheckpointArchive &a, Event *e) -> Event* {
+			AccelEvent *ae = static_cast<AccelEvent*>(e);
+			BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+			uint64_t x = e ? ae->x : 0, y = e ? ae->y : 0, z = e ? ae->z : 0;
+			a & bb & x & y & z;
+			return e ? e : new AccelEvent(0, bb, x, y, z);
+		} },
+		{ EVENT_SHAKE, [](CheckpointArchive &a, Event *e) -> Event* {
+			BuildingBlock *bb = e ? e->getConcernedBlock() : NULL;
+			uint64_t force = e ? static_cast<ShakeEvent*>(e)->force : 0;
+			a & bb & force;
+			return e ? e : new ShakeEvent(0, bb, force);
+		} },
+	};
+	return checkpointers;
+}
+
+static map<unsigned int, Checkpointer<Message>> &messageCheckpointers() {
+	static map<unsigned int, Checkpointer<Message>> checkpointers;
+	return checkpointers;
+}
+
+static map<unsigned int, Checkpointer<WirelessMessage>> &wirelessMessageCheckpointers() {
+	static map<unsigned int, Checkpointer<WirelessMessage>> checkpointers;
+	return checkpointers;
+}
+
+//===========================================================================================================
+//
+//          Checkpoint  (class)
+//
+//===========================================================================================================
+
+void Checkpoint::registerEvent(int eventType, Checkpointer<Event> c) {
+	eventCheckpointers()[eventType] = c;
+}
+
+void Checkpoint::registerMessage(unsigned int msgType, Checkpointer<Message> c) {
+	messageCheckpointers()[msgType] = c;
+}
+
+void Checkpoint::registerWirelessMessage(unsigned int msgType, Checkpointer<WirelessMessage> c) {
+	wirelessMessageCheckpointers()[msgType] = c;
+}
+
+Checkpointer<Event> Checkpoint::getEventCheckpointer(int eventType) {
+	auto it = eventCheckpointers().find(eventType);
+	return it != eventCheckpointers().end() ? it->second : NULL;
+}
+
+Checkpointer<Message> Checkpoint::getMessageCheckpointer(unsigned int msgType) {
+	auto it = messageCheckpointers().find(msgType);
+	return it != messageCheckpointers().end() ? it->second : NULL;
+}
+
+Checkpointer<WirelessMessage> Checkpoint::getWirelessMessageCheckpointer(unsigned int msgType) {
+	auto it = wirelessMessageCheckpointers().find(msgType);
+	return it != wirelessMessageCheckpointers().end() ? it->second : NULL;
+}
+
+void Checkpoint::header(CheckpointArchive &a, int &seed) {
+	uint32_t magic = CHECKPOINT_MAGIC;
+	uint32_t version = CHECKPOINT_VERSION;
+	a & magic;
+	if (magic != CHECKPOINT_MAGIC) throw CheckpointException("not a checkpoint file");
+	a & version;
+	if (version != CHECKPOINT_VERSION) {
+		throw CheckpointException("unsupported checkpoint version " + to_string(version));
+	}
+	a & seed;
+}
+
+void Checkpoint::transfer(CheckpointArchive &a) {
+	SimulationContext &context = SimulationContext::current();
+	Simulator *simulator = context.simulator;
+
+	int seed = simulator->getSeed();
+	header(a, seed);
+	if (seed != simulator->getSeed()) {
+		throw CheckpointException("checkpoint saved with seed " + to_string(seed) + ", simulation seed is "
+								  + to_string(simulator->getSeed()));
+	}
+
+	simulator->checkpoint(a);
+	context.stats.checkpoint(a);
+	// Before the blocks: constructing some events draws numbers from the generator of their block
+	context.scheduler->checkpoint(a);
+
+	map<bID, BuildingBlock*> &blocks = context.world->getMap();
+	uint64_t nbBlocks = blocks.size();
+	a & nbBlocks;
+	if (nbBlocks != blocks.size()) {
+		throw CheckpointException("checkpoint of " + to_string(nbBlocks) + " modules, simulation of "
+								  + to_string(blocks.size()));
+	}
+	for (auto &idBlock : blocks) {
+		bID id = idBlock.first;
+		a & id;
+		if (id != idBlock.first) {
+			throw CheckpointException("module " + to_string(id) + " does not exist");
+		}
+		if (!idBlock.second->checkpoint(a)) {
+			throw CheckpointException("the block code of module " + to_string(id)
+									  + " does not support checkpoints (see BlockCode::checkpoint)");
+		}
+	}
+
+	// Last, as restoring events and messages consumes identifiers
+	int nextEventId = context.nextEventId;
+	uint64_t nextMessageId = context.nextMessageId;
+	uint64_t nextWirelessMessageId = context.nextWirelessMessageId;
+	a & nextEventId & nextMessageId & nextWirelessMessageId;
+	context.nextEventId = nextEventId;
+	context.nextMessageId = nextMessageId;
+	context.nextWirelessMessageId = nextWirelessMessageId;
+}
+
+void Checkpoint::save(const string &path) {
+	string tmpPath = path + ".tmp";
+	try {
+		CheckpointArchive a(tmpPath, false);
+		transfer(a);
+		a.close();
+	} catch (CheckpointException&) {
+		remove(tmpPath.c_str());
+		throw;
+	}
+
+	// An interrupted save never leaves a partial checkpoint in place of the previous one
+	if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+		remove(tmpPath.c_str());
+		throw CheckpointException("cannot rename " + tmpPath + " to " + path);
+	}
+}
+
+void Checkpoint::load(const string &path) {
+	CheckpointArchive a(path, true);
+	transfer(a);
+}
+
+int Checkpoint::readSeed(const string &path) {
+	CheckpointArchive a(path, true);
+	int seed = 0;
+	header(a, seed);
+	return seed;
+}
+
+} // namespace BaseSimulator
@@ -0,0 +1,254 @@
+/*! @file checkpoint.h
+ * @brief Saves the state of a running simulation to a binary file, and resumes a simulation from it (see options
+ *  -K and -C)
+ * @date 17/10/2026
+ */
+
+#ifndef CHECKPOINT_H__
+#define CHECKPOINT_H__
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <functional>
+#include <type_traits>
+#include <stdexcept>
+
+#include "tDefs.h"
+#include "random.h"
+#include "events.h"
+#include "network.h"
+
+#define CHECKPOINT_MAGIC		0x4B435356 //!< "VSCK", first bytes of a checkpoint file
+#define CHECKPOINT_VERSION		3 //!< Version of the checkpoint format, incremented on incompatible changes
+#define CHECKPOINT_DEFAULT_FILE	"checkpoint.vsck" //!< Checkpoint file written by -K when none is specified
+
+namespace BaseSimulator {
+
+class BuildingBlock;
+
+//!< @brief Exception thrown when a checkpoint cannot be saved or restored
+struct CheckpointException : std::runtime_error {
+	CheckpointException(const std::string &what) : std::runtime_error(what) {};
+};
+
+/**
+ * @brief Binary archive, either written (save) or read (load) by the same code
+ *
+ *  As in boost::serialization, a single function transfers an object in both directions: `a & x` writes x into
+ *  the archive when saving, and reads x from it when loading. Values of trivially copyable types, strings, RNGs
+ *  and standard containers of those are stored by value. Pointers to the objects of the world (blocks, interfaces)
+ *  are stored as identifiers, and resolved against the world rebuilt from the same configuration when loading.
+ *  Messages and events are stored by value, once even if several pointers share them.
+ */
+class CheckpointArchive {
+	std::ofstream out; //!< Output file when saving
+	std::ifstream in; //!< Input file when loading
+	bool loading; //!< true if the archive is read, false if it is written
+	uint64_t fileSize = 0; //!< Size of the input file (loading)
+
+	std::map<const void*, uint32_t> savedObjects; //!< Messages and events already saved -> their index (saving)
+	std::vector<std::shared_ptr<void>> loadedObjects; //!< Messages and events already loaded, by index (loading)
+
+	/**
+	 * @brief Archives the reference to a shared object
+	 * @return true if the object is NULL or has already been archived, p is then set when loading. false if its
+	 *  value must be archived next, and when loading, stored at index slot of loadedObjects once constructed
+	 */
+	template<class T> bool shared(std::shared_ptr<T> &p, uint32_t &slot);
+public:
+	/**
+	 * @brief Opens the archive file
+	 * @param path file to write if saving, or to read if loading
+	 * @param load true to read the archive
+	 * @throw CheckpointException if the file cannot be opened
+	 */
+	CheckpointArchive(const std::string &path, bool load);
+
+	//!< @brief Returns true if the archive is read, false if it is written
+	inline bool isLoading() const { return loading; };
+
+	//!< @brief Writes or reads n raw bytes at address p
+	void bytes(void *p, size_t n);
+
+	/**
+	 * @brief Checks, before a container of n elements is allocated when loading, that the rest of the file can hold
+	 *  them, each element taking at least elementSize bytes
+	 * @throw CheckpointException if it cannot, the file is then corrupted or truncated
+	 */
+	void checkCount(uint64_t n, uint64_t elementSize);
+
+	//!< @brief Returns the fewest bytes taken by a value of type T in the archive
+	template<class T> static constexpr uint64_t minSize() {
+		return std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value ? sizeof(T) : 1;
+	}
+
+	//!< @brief Closes the archive file, @throw CheckpointException if the end of a saved archive cannot be written
+	void close();
+
+	//!< @brief Values of trivially copyable types, stored in their binary representation. Pointers are not values
+	template<class T>
+	typename std::enable_if<std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value,
+							CheckpointArchive&>::type operator&(T &v) {
+		bytes(&v, sizeof(v));
+		return *this;
+	}
+
+	CheckpointArchive& operator&(std::string &s);
+	//!< @brief Random generators, stored in their portable text representation
+	CheckpointArchive& operator&(uintRNG &g);
+
+	template<class T> CheckpointArchive& operator&(std::vector<T> &v);
+	template<class T> CheckpointArchive& operator&(std::deque<T> &d);
+	template<class T> CheckpointArchive& operator&(std::list<T> &l);
+	template<class K, class V> CheckpointArchive& operator&(std::unordered_map<K, V> &m);
+
+	//!< @brief Blocks, stored as their identifier. NULL is allowed
+	CheckpointArchive& operator&(BuildingBlock *&bb);
+	//!< @brief Point-to-point interfaces, stored as the identifier of their host and their index in it. NULL is allowed
+	CheckpointArchive& operator&(P2PNetworkInterface *&ni);
+	//!< @brief Wireless interfaces, stored as the identifier of their host. NULL is allowed
+	CheckpointArchive& operator&(WirelessNetworkInterface *&ni);
+	//!< @brief Messages, stored by value (see Checkpoint::registerMessage). NULL is allowed
+	CheckpointArchive& operator&(MessagePtr &m);
+	//!< @brief Wireless messages, stored by value (see Checkpoint::registerWirelessMessage). NULL is allowed
+	CheckpointArchive& operator&(WirelessMessagePtr &m);
+	//!< @brief Events, stored by value (see Checkpoint::registerEvent). NULL is allowed
+	CheckpointArchive& operator&(EventPtr &ev);
+};
+
+/**
+ * @brief Saves or restores the part of an object that is not already stored by the caller
+ *
+ *  When saving, obj is the object to save, and the function archives its attributes and returns obj. When loading,
+ *  obj is NULL, and the function reads the attributes, constructs the object and returns it. Identifiers and
+ *  dates are handled by the archive.
+ */
+template<class T> using Checkpointer = std::function<T*(CheckpointArchive &a, T *obj)>;
+
+/**
+ * @brief Saves the state of a simulation into a checkpoint file, and restores it
+ *
+ *  A checkpoint stores the state that the simulation has reached, not the configuration: it is restored into the
+ *  world built from the configuration file and seed of the simulation that saved it, right before the scheduler
+ *  starts. It holds the date and pending events of the scheduler, the random generator of the simulator, the
+ *  global statistics and identifier counters, and the state of every block (see BuildingBlock::checkpoint),
+ *  including the variables of its block code (see BlockCode::checkpoint).
+ *
+ *  The core events and messages are supported. Events and messages defined by an application are supported once
+ *  registered (see registerEvent and registerMessage), otherwise saving the checkpoint fails with an error naming
+ *  them.
+ */
+class Checkpoint {
+	//!< @brief Archives and checks the format identification and the seed of the simulation
+	static void header(CheckpointArchive &a, int &seed);
+	//!< @brief Archives the whole simulation state, in the same order when saving and loading
+	static void transfer(CheckpointArchive &a);
+public:
+	/**
+	 * @brief Saves the state of the simulation of the calling thread into path, once its scheduler is stopped
+	 *  between two dates. The file is written under a temporary name, then renamed.
+	 * @throw CheckpointException if a part of the state cannot be saved
+	 */
+	static void save(const std::string &path);
+
+	/**
+	 * @brief Restores the state saved in path into the simulation of the calling thread, whose world has been built
+	 *  from the same configuration and seed, and whose scheduler has not been started.
+	 * @throw CheckpointException if the checkpoint does not match the simulation, or cannot be read
+	 */
+	static void load(const std::string &path);
+
+	/**
+	 * @brief Reads the simulation seed stored in a checkpoint, which the simulation restoring it must be built with
+	 * @throw CheckpointException if the file is not a checkpoint
+	 */
+	static int readSeed(const std::string &path);
+
+	//!< @brief Registers the function archiving the events of type eventType (see uniqueEventsId.h)
+	static void registerEvent(int eventType, Checkpointer<Event> c);
+	//!< @brief Registers the function archiving the messages of type msgType, if they are not plain Message instances
+	static void registerMessage(unsigned int msgType, Checkpointer<Message> c);
+	//!< @brief Registers the function archiving the wireless messages of type msgType, if they are not plain WirelessMessage instances
+	static void registerWirelessMessage(unsigned int msgType, Checkpointer<WirelessMessage> c);
+
+	//!< @brief Registers MessageOf<T> messages of type msgType, whose data is archived with `a & data`
+	template<class T> static void registerMessage(unsigned int msgType) {
+		registerMessage(msgType, [msgType](CheckpointArchive &a, Message *m) -> Message* {
+			T data = m ? *static_cast<MessageOf<T>*>(m)->getData() : T();
+			a & data;
+			return m ? m : new MessageOf<T>(msgType, data);
+		});
+	}
+
+	//!< @brief Registers WirelessMessageOf<T> messages of type msgType, whose data is archived with `a & data`
+	template<class T> static void registerWirelessMessage(unsigned int msgType) {
+		registerWirelessMessage(msgType, [msgType](CheckpointArchive &a, WirelessMessage *m) -> WirelessMessage* {
+			T data = m ? *static_cast<WirelessMessageOf<T>*>(m)->getData() : T();
+			a & data;
+			return m ? m : new WirelessMessageOf<T>(msgType, data, 0);
+		});
+	}
+
+	//!< @brief Returns the function archiving the events of type eventType, NULL if it is not supported
+	static Checkpointer<Event> getEventCheckpointer(int eventType);
+	//!< @brief Returns the function archiving the messages of type msgType, NULL if it has not been registered
+	static Checkpointer<Message> getMessageCheckpointer(unsigned int msgType);
+	//!< @brief Returns the function archiving the wireless messages of type msgType, NULL if it has not been registered
+	static Checkpointer<WirelessMessage> getWirelessMessageCheckpointer(unsigned int msgType);
+};
+
+template<class T> CheckpointArchive& CheckpointArchive::operator&(std::vector<T> &v) {
+	uint64_t n = v.size();
+	*this & n;
+	checkCount(n, minSize<T>());
+	if (loading) v.resize(n);
+	for (T &x : v) *this & x;
+	return *this;
+}
+
+template<class T> CheckpointArchive& CheckpointArchive::operator&(std::deque<T> &d) {
+	uint64_t n = d.size();
+	*this & n;
+	checkCount(n, minSize<T>());
+	if (loading) d.resize(n);
+	for (T &x : d) *this & x;
+	return *this;
+}
+
+template<class T> CheckpointArchive& CheckpointArchive::operator&(std::list<T> &l) {
+	uint64_t n = l.size();
+	*this & n;
+	checkCount(n, minSize<T>());
+	if (loading) l.resize(n);
+	for (T &x : l) *this & x;
+	return *this;
+}
+
+template<class K, class V> CheckpointArchive& CheckpointArchive::operator&(std::unordered_map<K, V> &m) {
+	uint64_t n = m.size();
+	*this & n;
+	checkCount(n, minSize<K>() + minSize<V>());
+	if (loading) {
+		m.clear();
+		for (uint64_t i = 0; i < n; i++) {
+			K k;
+			*this & k;
+			*this & m[k];
+		}
+	} else {
+		for (auto &kv : m) {
+			K k = kv.first;
+			*this & k & kv.second;
+		}
+	}
+	return *this;
+}
+
+} // namespace BaseSimulator
+
+#endif // CHECKPOINT_H__
@@ -10,12 +10,14 @@
 
 #include <cstdint>
 #include "tDefs.h"
+#include "stateSnapshot.h"
 
 using namespace std;
 
 namespace BaseSimulator {
 
 //class BuildingBlock;
+class CheckpointArchive;
 
 /**
  * \brief Abstract class parent of any clock
@@ -51,6 +53,21 @@ class Clock {
    * @para localTime Local time for which the simulator time is requested.
    */
   virtual Time getSimulationTime(Time localTime) = 0;
+
+  /**
+   * @brief saves the state of the clock that can be modified when it is read 
+   * (used by the optimistic parallel engine). Nothing to save by default.
+   * @para s snapshot in which the state is saved
+   */
+  virtual void saveState(StateSnapshot &s) {};
+
+  /**
+   * @brief saves or restores the state of the clock into a checkpoint file (see Checkpoint).
+   * Nothing to save by default, clocks whose state is modified when they are read must override it.
+   * @para a archive in which the state is saved, or from which it is restored
+   * @return false if the clock does not support checkpoints, true otherwise
+   */
+  virtual bool checkpoint(CheckpointArchive &a) { return true; };
 };
 
 /**
@@ -36,6 +36,10 @@ clockNoise_t GClockNoise::getNoise(Time simTime) {
   return (clockNoise_t)generator();
 }
 
+void GClockNoise::saveState(StateSnapshot &s) {
+  s.save(generator);
+}
+
 //==============================================================================
 //
 //          DNoiseQClock  (class)
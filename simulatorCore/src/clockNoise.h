@@ -7,6 +7,7 @@
 
 #include "tDefs.h"
 #include "random.h"
+#include "stateSnapshot.h"
 
 using namespace std;
 
@@ -33,6 +34,11 @@ class ClockNoise {
    * @return noise
    */
   virtual clockNoise_t getNoise(Time simTime) = 0;
+  /**
+   * @brief Saves the state modified by getNoise, if any
+   * @para s snapshot in which the state is saved
+   */
+  virtual void saveState(StateSnapshot &s) {};
 };
  
 /**
@@ -56,6 +62,7 @@ class GClockNoise : public ClockNoise {
   ~GClockNoise();
 
   clockNoise_t getNoise(Time simTime);
+  void saveState(StateSnapshot &s);
 };
  
 /**
@@ -5,6 +5,7 @@
 #include <cstdlib>
 
 #include "statsIndividual.h"
+#include "eventProfiler.h"
 #include "openglViewer.h"
 #include "simulator.h"
 #include "trace.h"
@@ -17,16 +18,30 @@ void CommandLine::help() {
     cerr << "\t -c <name>\t\txml configuration file" << endl;
     cerr << "\t -r \t\t\trun realtime mode on startup" << endl;
     cerr << "\t -R \t\t\trun fastest mode on startup" << endl;
+    cerr << "\t -T <speed>\t\tpace of the realtime mode, in simulated seconds per second (default: 1)" << endl;
+    cerr << "\t -w <date>\t\twarm start: run fastest mode until date (us), then realtime mode" << endl;
+    cerr << "\t -W <events>\t\twarm start: run fastest mode until this number of events has been processed, then realtime mode" << endl;
     cerr << "\t -x \t\t\tterminate simulation when scheduler ends (Graphical Mode only)" << endl;
     cerr << "\t -t \t\t\tterminal mode only (no graphical output)" << endl;
     cerr << "\t -s [<maximumDate> | inf] \tScheduler mode:\tBy default, stops when event list is empty\n"
          << "\t\t maximumDate (us) : the scheduler will stop when even list is empty, or when the maximum date is reach\n"
          << "\t\t inf : the scheduler will have an infinite duration and can only be stopped by the user" << endl;
+    cerr << "\t -q {\"map\", \"heap\", \"heap4\", \"calendar\"}\tdata structure of the scheduler's event queue (default: heap4)" << endl;
+    cerr << "\t -P <threads>\t\tprocess events on several threads (parallel execution, terminal mode only)" << endl;
+    cerr << "\t -b <runs>\t\trun the simulation with runs successive seeds, starting from the simulation seed (terminal mode only)" << endl;
+    cerr << "\t -j <processes>\t\tnumber of simulations run at the same time by -b (default: number of cores)" << endl;
+    cerr << "\t -K <date> [<file>]\tsave the state of the simulation to a checkpoint file once date (us) is reached (default file: " << CHECKPOINT_DEFAULT_FILE << ")" << endl;
+    cerr << "\t -C <file>\t\tresume the simulation from a checkpoint file saved by -K, with the same configuration" << endl;
+    cerr << "\t -Y <file>\t\trecord the events processed by the scheduler into a binary trace file" << endl;
+    cerr << "\t -V <file>\t\tverify that the events processed match a trace recorded by -Y, stop at the first divergence" << endl;
+    cerr << "\t -E {\"conservative\", \"optimistic\"}\tsynchronization of the threads of parallel executions (default: conservative)" << endl;
     cerr << "\t -m <VMpath>:<VMport>\tpath to the MeldVM directory and port" << endl;
     cerr << "\t -k {\"BB\", \"RB\", \"SB\", \"C2D\", \"C3D\", \"MR\"}\t module type for generic Block Code execution" << endl;
     cerr << "\t -g \t\t\tEnable regression testing (export terminal configuration)" << endl;
     cerr << "\t -l \t\t\tEnable printing of log information to file simulation.log" << endl;
     cerr << "\t -i \t\t\tEnable printing more detailed simulation stats" << endl;
+    cerr << "\t -e [<file.csv>]\t\tProfile the time spent processing each type of event, and optionally write it to a CSV file" << endl;
+    cerr << "\t -S <period> [<file.csv>]\twrite a snapshot of the scheduler statistics every period (us) to a CSV file (default: " << STATS_TIMESERIES_DEFAULT_FILE << ")" << endl;
     cerr << "\t -a <seed>\t\tSet simulation seed" << endl;
     cerr << "\t -h \t\t\thelp" << endl;
     exit(EXIT_SUCCESS);
@@ -89,6 +104,116 @@ void CommandLine::read(int argc, char *argv[]) {
                     help();
                 }
             } break;
+            case 'T': {
+                if (argc < 2) {
+                    cerr << "error: No realtime speed provided after -T" << endl;
+                    help();
+                }
+                try {
+                    realtimeSpeed = stod(argv[1]);
+                } catch(std::logic_error&) {
+                    realtimeSpeed = 0;
+                }
+                if (!(realtimeSpeed > 0)) {
+                    cerr << "error: Realtime speed must be a positive number!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
+            case 'w': {
+                if (argc < 2) {
+                    cerr << "error: No warm start date provided after -w" << endl;
+                    help();
+                }
+                try {
+                    warmStartDate = stoull(argv[1]);
+                } catch(std::logic_error&) {
+                    cerr << "error: Warm start date must be an integer!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
+            case 'W': {
+                if (argc < 2) {
+                    cerr << "error: No number of events provided after -W" << endl;
+                    help();
+                }
+                try {
+                    warmStartEvents = stoull(argv[1]);
+                } catch(std::logic_error&) {
+                    warmStartEvents = 0;
+                }
+                if (warmStartEvents == 0) {
+                    cerr << "error: Warm start number of events must be a positive integer!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
+            case 'K': {
+                if (argc < 2) {
+                    cerr << "error: No checkpoint date provided after -K" << endl;
+                    help();
+                }
+                try {
+                    checkpointDate = stoull(argv[1]);
+                } catch(std::logic_error&) {
+                    cerr << "error: Checkpoint date must be an integer!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+                if (argc > 1 && argv[1][0] != '-') {
+                    checkpointFile = argv[1];
+                    argc--;
+                    argv++;
+                }
+            } break;
+            case 'C': {
+                if (argc < 2) {
+                    cerr << "error: No checkpoint file provided after -C" << endl;
+                    help();
+                }
+                resumeFile = argv[1];
+                argc--;
+                argv++;
+            } break;
+            case 'Y':
+            case 'V': {
+                if (argc < 2) {
+                    cerr << "error: No trace file provided after -" << argv[0][1] << endl;
+                    help();
+                }
+                traceVerify = argv[0][1] == 'V';
+                traceFile = argv[1];
+                argc--;
+                argv++;
+            } break;
+            case 'S': {
+                if (argc < 2) {
+                    cerr << "error: No snapshot period provided after -S" << endl;
+                    help();
+                }
+                try {
+                    statsPeriod = stoull(argv[1]);
+                } catch(std::logic_error&) {
+                    cerr << "error: Snapshot period must be an integer!" << endl;
+                    help();
+                }
+                if (statsPeriod == 0) {
+                    cerr << "error: Snapshot period must be strictly positive!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+                if (argc > 1 && argv[1][0] != '-') {
+                    statsFile = argv[1];
+                    argc--;
+                    argv++;
+                }
+            } break;
             case 'x': {
                 schedulerAutoStop = true;
             } break;
@@ -124,8 +249,85 @@ void CommandLine::read(int argc, char *argv[]) {
                 argc--;
                 argv++;
             } break;
+            case 'q': {
+                if (argc < 2) {
+                    cerr << "error: No event queue type provided after -q" << endl;
+                    help();
+                }
+                eventQueue = BaseSimulator::EventQueue::parseType(argv[1]);
+                if (eventQueue == -1) {
+                    cerr << "error: unknown event queue type: " << argv[1] << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
+            case 'P': {
+                if (argc < 2) {
+                    cerr << "error: No number of threads provided after -P" << endl;
+                    help();
+                }
+                try {
+                    nbThreads = stoi(argv[1]);
+                } catch(std::logic_error&) {
+                    nbThreads = 0;
+                }
+                if (nbThreads < 1) {
+                    cerr << "error: Number of threads must be a positive integer!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
+            case 'b': {
+                if (argc < 2) {
+                    cerr << "error: No number of runs provided after -b" << endl;
+                    help();
+                }
+                try {
+                    batchRuns = stoi(argv[1]);
+                } catch(std::logic_error&) {
+                    batchRuns = 0;
+                }
+                if (batchRuns < 1) {
+                    cerr << "error: Number of runs must be a positive integer!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
+            case 'j': {
+                if (argc < 2) {
+                    cerr << "error: No number of processes provided after -j" << endl;
+                    help();
+                }
+                try {
+                    batchProcesses = stoi(argv[1]);
+                } catch(std::logic_error&) {
+                    batchProcesses = 0;
+                }
+                if (batchProcesses < 1) {
+                    cerr << "error: Number of processes must be a positive integer!" << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
+            case 'E': {
+                if (argc < 2) {
+                    cerr << "error: No parallel engine type provided after -E" << endl;
+                    help();
+                }
+                parallelEngine = BaseSimulator::ParallelEngine::parseType(argv[1]);
+                if (parallelEngine == -1) {
+                    cerr << "error: unknown parallel engine type: " << argv[1] << endl;
+                    help();
+                }
+                argc--;
+                argv++;
+            } break;
             case 't': {
-                GlutContext::GUIisEnabled = false;
+                GlutContext::setGUIEnabled(false);
             } break;
             case 'f' : {
                 //fullScreen = true;
@@ -137,13 +339,21 @@ void CommandLine::read(int argc, char *argv[]) {
                 argv++;
             } break;
             case 'l' : {
-                log_file.open("simulation.log");
+                getLogFile().open("simulation.log");
             } break;
             case 'g' : {
-                Simulator::regrTesting = true;
+                Simulator::setRegrTesting(true);
             } break;
             case 'i' : {
-                utils::StatsIndividual::enable = true;
+                utils::StatsIndividual::setEnabled(true);
+            } break;
+            case 'e' : {
+                utils::EventProfiler::getInstance().enable = true;
+                if (argc > 1 && argv[1][0] != '-') {
+                    utils::EventProfiler::getInstance().csvFile = argv[1];
+                    argc--;
+                    argv++;
+                }
             } break;
             case 'a' : {
                 string str(argv[1]);
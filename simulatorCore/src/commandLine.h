@@ -11,6 +11,8 @@
 #include <string>
 
 #include "scheduler.h"
+#include "checkpoint.h"
+#include "statsTimeSeries.h"
 #include "tDefs.h"
 
 using namespace std;
@@ -30,6 +32,21 @@ class CommandLine {
 	int schedulerLength  = SCHEDULER_LENGTH_DEFAULT;
 	bool schedulerAutoStop = false;
 	Time maximumDate = 0;
+	int eventQueue = CMD_LINE_UNDEFINED;
+	int nbThreads = 1;
+	int parallelEngine = PARALLEL_ENGINE_CONSERVATIVE;
+	double realtimeSpeed = SCHEDULER_REALTIME_SPEED_DEFAULT;
+	Time warmStartDate = TIME_MAX;
+	uint64_t warmStartEvents = 0;
+	int batchRuns = 0;
+	int batchProcesses = 0;
+	Time checkpointDate = TIME_MAX;
+	string checkpointFile = CHECKPOINT_DEFAULT_FILE;
+	string resumeFile = "";
+	string traceFile = "";
+	bool traceVerify = false;
+	Time statsPeriod = 0;
+	string statsFile = STATS_TIMESERIES_DEFAULT_FILE;
 	
 	
 	bool meldDebugger = false;
@@ -69,6 +86,27 @@ class CommandLine {
 	int getSchedulerLength() { return schedulerLength; }
 	Time getMaximumDate() { return maximumDate; }
 	bool getSchedulerAutoStop() { return schedulerAutoStop; }
+	int getEventQueue() { return eventQueue; }
+	int getNbThreads() { return nbThreads; }
+	int getParallelEngine() { return parallelEngine; }
+	double getRealtimeSpeed() { return realtimeSpeed; }
+	bool warmStartRequested() { return warmStartDate != TIME_MAX || warmStartEvents != 0; }
+	Time getWarmStartDate() { return warmStartDate; }
+	uint64_t getWarmStartEvents() { return warmStartEvents; }
+	bool batchRequested() { return batchRuns > 0; }
+	int getBatchRuns() { return batchRuns; }
+	int getBatchProcesses() { return batchProcesses; }
+	bool checkpointRequested() { return checkpointDate != TIME_MAX; }
+	Time getCheckpointDate() { return checkpointDate; }
+	string getCheckpointFile() { return checkpointFile; }
+	bool resumeRequested() { return !resumeFile.empty(); }
+	string getResumeFile() { return resumeFile; }
+	bool traceRequested() { return !traceFile.empty(); }
+	string getTraceFile() { return traceFile; }
+	bool isTraceVerify() { return traceVerify; }
+	bool statsTimeSeriesRequested() { return statsPeriod > 0; }
+	Time getStatsPeriod() { return statsPeriod; }
+	string getStatsFile() { return statsFile; }
 	bool isSimulationSeedSet() { return simulationSeedSet; }
 	int getSimulationSeed() { return simulationSeed; }
 
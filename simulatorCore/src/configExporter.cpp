@@ -22,7 +22,7 @@ namespace BaseSimulator {
 static string generateConfigFilename() {
     std::ostringstream out;
 
-    if (Simulator::regrTesting)
+    if (Simulator::isRegrTesting())
         out << ".confCheck" << ".xml";
     else {
         time_t now = time(0);
@@ -103,7 +103,7 @@ void ConfigExporter::exportConfiguration() {
 }
 
 void ConfigExporter::exportCameraAndLightSource() {
-    if (GlutContext::GUIisEnabled) {
+    if (GlutContext::isGUIEnabled()) {
         // Export Camera
         Camera *camera = world->getCamera();
         
@@ -139,7 +139,7 @@ void ConfigExporter::exportCameraAndLightSource() {
 void ConfigExporter::exportWorld() {
     worldElt = new TiXmlElement("world");
     worldElt->SetAttribute("gridSize", toXmlAttribute(world->lattice->gridSize));
-    if (GlutContext::GUIisEnabled) {
+    if (GlutContext::isGUIEnabled()) {
         worldElt->SetAttribute("windowSize",
                                toXmlAttribute(GlutContext::screenWidth, GlutContext::screenHeight));
     }
@@ -0,0 +1,268 @@
+/*! @file conservativeEngine.cpp
+ * @brief Conservative parallel execution of the simulation events (YAWNS: Yet Another Windowing Network Simulator)
+ * @date 17/10/2026
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include "conservativeEngine.h"
+#include "scheduler.h"
+#include "world.h"
+#include "network.h"
+#include "trace.h"
+
+using namespace std;
+using namespace BaseSimulator::utils;
+
+namespace BaseSimulator {
+
+ConservativeEngine::ConservativeEngine(Scheduler *s, unsigned int n) : ParallelEngine(s, n), workers(n) {
+	for (unsigned int i = 0; i < n; i++) {
+		workers[i].index = i;
+	}
+}
+
+bool ConservativeEngine::processedBefore(const CausalKey *a, const CausalKey *b) {
+	if (a->date != b->date) return a->date < b->date;
+	// Inherited events were in the event list before any event of the window was created
+	if ((a->parent == NULL) != (b->parent == NULL)) return a->parent == NULL;
+	if (a->parent == NULL) return a->rank < b->rank;
+	return createdBefore(a, b);
+}
+
+bool ConservativeEngine::createdBefore(const CausalKey *a, const CausalKey *b) {
+	if (a->parent != b->parent) return processedBefore(a->parent, b->parent);
+	return a->rank < b->rank;
+}
+
+void ConservativeEngine::start() {
+	lookahead = computeLookahead();
+	nbWindows = 0;
+	nbSyncEvents = 0;
+
+	if (lookahead == 0) {
+		cerr << "warning: null lookahead (unbounded P2P data rate or null DIFS), events will be processed sequentially" << endl;
+	} else {
+		cout << "\033[1;33m" << "Scheduler : " << getName() << " parallel engine, " << nbWorkers
+			 << " threads, lookahead " << lookahead << " us" << "\033[0m" << endl;
+	}
+
+	ParallelEngine::start();
+}
+
+void ConservativeEngine::stop() {
+	ParallelEngine::stop();
+	cout << "\033[1;33m" << "Scheduler : " << nbWindows << " parallel windows, "
+		 << nbSyncEvents << " sequential events" << "\033[0m" << endl;
+}
+
+void ConservativeEngine::step() {
+	if (lookahead == 0 || scheduler->eventsQueue->top()->getOwnerBlock() == NULL) {
+		processSyncEvent();
+	} else {
+		processWindow();
+	}
+}
+
+void ConservativeEngine::processSyncEvent() {
+	EventPtr pev = scheduler->eventsQueue->pop();
+	// Events scheduled in the past by a lookahead violation are processed late
+	scheduler->currentDate = max(scheduler->currentDate, pev->date);
+	consumeCounted(pev.get());
+	StatsCollector::getInstance().incEventsCount();
+	scheduler->eventsMapSize--;
+	nbSyncEvents++;
+}
+
+void ConservativeEngine::processWindow() {
+	EventQueue *queue = scheduler->eventsQueue;
+
+	Time start = queue->top()->date;
+	windowEnd = lookahead > TIME_MAX - start ? TIME_MAX : start + lookahead;
+
+	// Distribute the events of the window to the workers, up to the first event without owner
+	uint64_t rank = 0;
+	unsigned int nbPartitions = 0, lastPartition = 0;
+	while (!queue->empty()) {
+		const EventPtr &top = queue->top();
+		if (top->date >= windowEnd) break;
+		BuildingBlock *owner = top->getOwnerBlock();
+		if (owner == NULL) {
+			windowEnd = top->date;
+			break;
+		}
+
+		Worker &w = workers[partitionOf(owner)];
+		if (w.heap.empty()) {
+			nbPartitions++;
+			lastPartition = w.index;
+		}
+		w.keys.push_back(CausalKey{top->date, rank++, NULL});
+		// Events are extracted in increasing order, the array remains a heap
+		w.heap.push_back(PendingEvent{&w.keys.back(), queue->pop()});
+		scheduler->eventsMapSize--;
+	}
+
+	scheduler->parallelSection = true;
+	if (nbPartitions == 1) {
+		processPartition(lastPartition);
+	} else {
+		runWorkers();
+	}
+	scheduler->parallelSection = false;
+	nbWindows++;
+
+	uint64_t nbEvents = 0;
+	for (Worker &w : workers) {
+		// Reported once: the following windows are processed sequentially
+		if (!w.violation.empty() && lookahead > 0) {
+			cerr << "warning: lookahead violation in parallel execution, " << w.violation << "." << endl
+				 << "Events can only be scheduled for another module at least " << lookahead
+				 << " us after the current date, and only cancelled by their own module. "
+				 << "The events of this window may have been processed out of order, "
+				 << "the rest of the simulation is processed sequentially." << endl;
+			lookahead = 0;
+		}
+		w.violation.clear();
+		for (EventPtr &pev : w.cancels) {
+			queue->cancel(pev.get());
+			scheduler->eventsMapSize--;
+		}
+		w.cancels.clear();
+		if (w.windowEvents > 0) {
+			scheduler->currentDate = max(scheduler->currentDate, w.date);
+			nbEvents += w.windowEvents;
+			w.nbEvents += w.windowEvents;
+			w.windowEvents = 0;
+		}
+		StatsCollector::getInstance().incMsgCount(w.nbMessages);
+		StatsCollector::getInstance().incMotionCount(w.nbMotions);
+		w.nbMessages = w.nbMotions = 0;
+	}
+	StatsCollector::getInstance().incEventsCount(nbEvents);
+
+	mergeOutgoing();
+
+	for (Worker &w : workers) {
+		w.keys.clear();
+		// Cancellations of the events of other modules, delayed until their events have been inserted
+		for (EventPtr &pev : w.lateCancels) {
+			if (pev->processed || pev->cancelled) continue;
+			pev->cancelled = true;
+			if (pev->queued) {
+				scheduler->eventsQueue->cancel(pev.get());
+				scheduler->eventsMapSize--;
+			}
+		}
+		w.lateCancels.clear();
+	}
+}
+
+void ConservativeEngine::mergeOutgoing() {
+	unsigned int nbSources = 0;
+	for (Worker &w : workers) {
+		if (w.outgoing.empty()) continue;
+		nbSources++;
+		std::move(w.outgoing.begin(), w.outgoing.end(), back_inserter(outgoing));
+		w.outgoing.clear();
+	}
+
+	// Events of a single worker are already in creation order
+	if (nbSources > 1) {
+		sort(outgoing.begin(), outgoing.end(), [](const PendingEvent &a, const PendingEvent &b) {
+				return createdBefore(a.key, b.key);
+			});
+	}
+
+	for (PendingEvent &p : outgoing) {
+		scheduler->insertEvent(std::move(p.ev));
+	}
+	outgoing.clear();
+}
+
+void ConservativeEngine::processPartition(unsigned int i) {
+	Worker &w = workers[i];
+	if (w.heap.empty()) return;
+
+	auto later = [](const PendingEvent &a, const PendingEvent &b) { return processedBefore(b.key, a.key); };
+
+	current = &w;
+	while (!w.heap.empty()) {
+		pop_heap(w.heap.begin(), w.heap.end(), later);
+		PendingEvent p = std::move(w.heap.back());
+		w.heap.pop_back();
+
+		if (p.ev->cancelled) continue;
+
+		w.date = p.key->date;
+		w.processing = p.key;
+		w.nbChildren = 0;
+		p.ev->processed = true;
+		consumeCounted(p.ev.get());
+		w.windowEvents++;
+	}
+	current = NULL;
+}
+
+bool ConservativeEngine::schedule(EventPtr &pev) {
+	Worker *w = static_cast<Worker*>(current);
+	if (w == NULL) return false;
+
+	w->keys.push_back(CausalKey{pev->date, w->nbChildren++, w->processing});
+	const CausalKey *key = &w->keys.back();
+
+	if (pev->date >= windowEnd) {
+		w->outgoing.push_back(PendingEvent{key, std::move(pev)});
+		return true;
+	}
+
+	BuildingBlock *owner = pev->getOwnerBlock();
+	if (owner != NULL && partitionOf(owner) == w->index) {
+		w->heap.push_back(PendingEvent{key, std::move(pev)});
+		push_heap(w->heap.begin(), w->heap.end(), [](const PendingEvent &a, const PendingEvent &b) {
+				return processedBefore(b.key, a.key);
+			});
+	} else {
+		// Inserted in the event list at the end of the window, possibly after later events have been processed
+		if (w->violation.empty()) {
+			stringstream info;
+			info << pev->getEventName() << " scheduled at " << pev->date << " by an event of date " << w->date;
+			if (owner) info << " for module " << owner->blockId;
+			else info << " (event without owner)";
+			w->violation = info.str();
+		}
+		w->outgoing.push_back(PendingEvent{key, std::move(pev)});
+	}
+	return true;
+}
+
+bool ConservativeEngine::cancel(EventPtr &pev) {
+	Worker *w = static_cast<Worker*>(current);
+	// Between windows, every pending event is in the event list
+	if (w == NULL) return false;
+
+	BuildingBlock *owner = pev->getOwnerBlock();
+	if (owner == NULL || partitionOf(owner) != w->index) {
+		if (w->violation.empty()) {
+			stringstream info;
+			info << pev->getEventName() << " of date " << pev->date;
+			if (owner) info << " for module " << owner->blockId;
+			else info << " (event without owner)";
+			info << " cancelled by an event of date " << w->date;
+			w->violation = info.str();
+		}
+		w->lateCancels.push_back(pev);
+		return true;
+	}
+
+	if (pev->processed) return false;
+	pev->cancelled = true;
+	// Events of the event list are removed from it at the end of the window, by the scheduler thread
+	if (pev->queued) {
+		w->cancels.push_back(pev);
+	}
+	return true;
+}
+
+} // BaseSimulator namespace
@@ -0,0 +1,96 @@
+/*! @file conservativeEngine.h
+ * @brief Conservative parallel execution of the simulation events (YAWNS: Yet Another Windowing Network Simulator)
+ * @date 17/10/2026
+ */
+
+#ifndef CONSERVATIVEENGINE_H_
+#define CONSERVATIVEENGINE_H_
+
+#include <deque>
+#include <vector>
+
+#include "parallelEngine.h"
+
+namespace BaseSimulator {
+
+/**
+ * @brief Conservative, window-based parallel engine
+ *  The lookahead L is the smallest delay between an event and the events it can schedule on another module: the
+ *  minimum transmission duration over all P2P interfaces, and the propagation delay of wireless messages. Given
+ *  the date T of the earliest pending event, no event of [T, T+L[ can be affected by another module's event of
+ *  the same window, so the window is processed by all workers concurrently, each on its own modules. Windows are
+ *  also closed by the first event without owner, which is processed alone by the scheduler thread.
+ *
+ *  Events scheduled during a window are transferred to the event list at the end of the window, in the order in
+ *  which the sequential engine would have scheduled them. Simultaneous events are thus processed in the same order
+ *  as in a sequential run, and the simulation produces the same results.
+ */
+class ConservativeEngine : public ParallelEngine {
+	/**
+	 * @brief Position of an event in the sequential processing order
+	 *  Events inherited from the event list are ordered by date and rank in the list. Events created during the
+	 *  window come after inherited events of the same date, ordered by creation order: the position of their
+	 *  creator, then their rank among the events created by the same event.
+	 */
+	struct CausalKey {
+		Time date; //!< date of the event
+		uint64_t rank; //!< rank in the event list if inherited, rank among its siblings otherwise
+		const CausalKey *parent; //!< key of the event that created this one, NULL if inherited
+	};
+
+	//!< An event waiting to be processed by a worker or transferred to the event list
+	struct PendingEvent {
+		const CausalKey *key; //!< position of the event in the sequential order
+		EventPtr ev; //!< the event itself
+	};
+
+	//!< Per-worker state
+	struct Worker : public WorkerContext {
+		vector<PendingEvent> heap; //!< events of the current window, min-heap on CausalKey
+		vector<PendingEvent> outgoing; //!< events created during the window, to be processed in a later window
+		deque<CausalKey> keys; //!< storage of the keys of the current window
+		const CausalKey *processing = NULL; //!< key of the event being processed
+		uint64_t nbChildren = 0; //!< number of events created by the event being processed
+		uint64_t windowEvents = 0; //!< number of events processed during the current window
+		vector<EventPtr> cancels; //!< events of the event list cancelled during the window
+		vector<EventPtr> lateCancels; //!< events of other modules cancelled during the window (lookahead violations)
+	};
+
+	vector<Worker> workers; //!< state of the workers, indexed by partition
+	vector<PendingEvent> outgoing; //!< events created during the window by all the workers, being merged
+	Time lookahead = 0; //!< minimum delay between an event and the events it schedules for another module
+	Time windowEnd = 0; //!< end date (excluded) of the current window
+	uint64_t nbWindows = 0; //!< number of windows processed in parallel
+	uint64_t nbSyncEvents = 0; //!< number of events processed alone by the scheduler thread
+
+	//!< @brief Returns true if the event of key a is processed before the event of key b in a sequential run
+	static bool processedBefore(const CausalKey *a, const CausalKey *b);
+	//!< @brief Returns true if the event of key a is created before the event of key b in a sequential run
+	static bool createdBefore(const CausalKey *a, const CausalKey *b);
+
+	//!< @brief Processes the earliest event of the event list on the scheduler thread
+	void processSyncEvent();
+	//!< @brief Extracts the events of the next window, and processes them on the workers
+	void processWindow();
+	//!< @brief Transfers the events created during the window into the event list, in sequential creation order
+	void mergeOutgoing();
+
+	void processPartition(unsigned int i);
+public:
+	ConservativeEngine(Scheduler *s, unsigned int n);
+	~ConservativeEngine() {};
+
+	void start();
+	void stop();
+	void step();
+	bool schedule(EventPtr &pev);
+	bool cancel(EventPtr &pev);
+	const string getName() const { return "conservative"; };
+
+	//!< @brief Getter for ConservativeEngine::lookahead, valid once the engine has been started
+	inline Time getLookahead() const { return lookahead; };
+};
+
+} // BaseSimulator namespace
+
+#endif /* CONSERVATIVEENGINE_H_ */
@@ -25,18 +25,13 @@ class CPPScheduler : public BaseSimulator::Scheduler {
 	static void createScheduler();
 	static void deleteScheduler();
 	static CPPScheduler* getScheduler() {
-		assert(scheduler != NULL);
-		return((CPPScheduler*)scheduler);
+		return((CPPScheduler*)Scheduler::getScheduler());
 	}
 
 	void printInfo() {
 		OUTPUT << "I'm a CPPScheduler" << endl;
 	}
 
-	void waitForSchedulerEnd() {
-		schedulerThread->join();
-	}
-
 	inline int getMode() { return schedulerMode; }
 };
 
@@ -0,0 +1,142 @@
+/*! @file eventPool.cpp
+ * @brief Pool allocator for simulation events and their shared_ptr control blocks
+ * @date 17/10/2026
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+
+#include "eventPool.h"
+
+namespace BaseSimulator {
+
+#ifndef DISABLE_EVENT_POOL
+
+#define EVENT_POOL_NB_CLASSES (EVENT_POOL_MAX_SIZE / EVENT_POOL_GRANULARITY)
+#define EVENT_POOL_HEADER_SIZE	EVENT_POOL_GRANULARITY	//!< Room left for the ChunkHeader, keeping blocks aligned
+
+//!< Header of a free block, stored in the block itself
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+//!< Free lists of a thread, indexed by size class. Outlives the thread: its chunks can be freed after it has exited
+struct ThreadPool {
+	FreeBlock *freeLists[EVENT_POOL_NB_CLASSES]; //!< blocks freed by the owner thread
+	std::atomic<FreeBlock*> remoteLists[EVENT_POOL_NB_CLASSES]; //!< blocks freed by other threads
+	ThreadPool *nextOrphan; //!< next pool of the depot
+};
+
+//!< Header of a chunk, at its start: chunks are aligned on their size, the header of a block is found by masking
+struct ChunkHeader {
+	ThreadPool *owner;
+};
+
+static thread_local ThreadPool *pool = NULL;
+
+//!< Pools of the threads that have exited, adopted by the next threads that allocate
+static std::mutex depotMutex;
+static ThreadPool *depot = NULL;
+
+//!< Returns the pool of the calling thread to the depot when the thread exits
+struct PoolReleaser {
+	~PoolReleaser() {
+		std::lock_guard<std::mutex> lock(depotMutex);
+		pool->nextOrphan = depot;
+		depot = pool;
+		pool = NULL;
+	}
+};
+
+//!< @brief Gives the calling thread a pool, from the depot if it is not empty
+static ThreadPool *acquirePool() {
+	static thread_local PoolReleaser releaser;
+	(void)releaser;
+
+	std::lock_guard<std::mutex> lock(depotMutex);
+	if (depot) {
+		pool = depot;
+		depot = depot->nextOrphan;
+	} else {
+		// Never freed: blocks of its chunks can be released at any time
+		pool = new ThreadPool();
+	}
+	return pool;
+}
+
+//!< @brief Returns the size class of a block of size bytes
+static inline size_t sizeClass(size_t size) {
+	return size ? (size - 1) / EVENT_POOL_GRANULARITY : 0;
+}
+
+//!< @brief Carves a new chunk into blocks of class c, returns the first one and adds the others to the free list
+static void *refill(ThreadPool *p, size_t c) {
+	size_t blockSize = (c + 1) * EVENT_POOL_GRANULARITY;
+	size_t nbBlocks = (EVENT_POOL_CHUNK_SIZE - EVENT_POOL_HEADER_SIZE) / blockSize;
+	void *memory;
+	if (posix_memalign(&memory, EVENT_POOL_CHUNK_SIZE, EVENT_POOL_CHUNK_SIZE) != 0) throw std::bad_alloc();
+	char *chunk = static_cast<char*>(memory);
+	reinterpret_cast<ChunkHeader*>(chunk)->owner = p;
+	chunk += EVENT_POOL_HEADER_SIZE;
+
+	FreeBlock *list = p->freeLists[c];
+	for (size_t i = nbBlocks - 1; i > 0; i--) {
+		FreeBlock *b = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+		b->next = list;
+		list = b;
+	}
+	p->freeLists[c] = list;
+
+	return chunk;
+}
+
+#endif
+
+void *EventPool::allocate(size_t size) {
+#ifndef DISABLE_EVENT_POOL
+	if (size <= EVENT_POOL_MAX_SIZE) {
+		ThreadPool *p = pool ? pool : acquirePool();
+		size_t c = sizeClass(size);
+		FreeBlock *b = p->freeLists[c];
+		if (b == NULL && p->remoteLists[c].load(std::memory_order_relaxed)) {
+			// Takes back at once the blocks that other threads have freed
+			b = p->remoteLists[c].exchange(NULL, std::memory_order_acquire);
+		}
+		if (b) {
+			p->freeLists[c] = b->next;
+			return b;
+		}
+		return refill(p, c);
+	}
+#endif
+	return ::operator new(size);
+}
+
+void EventPool::release(void *p, size_t size) {
+	if (p == NULL) return;
+#ifndef DISABLE_EVENT_POOL
+	if (size <= EVENT_POOL_MAX_SIZE) {
+		size_t c = sizeClass(size);
+		FreeBlock *b = static_cast<FreeBlock*>(p);
+		ThreadPool *owner = reinterpret_cast<ChunkHeader*>(
+			reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(EVENT_POOL_CHUNK_SIZE - 1))->owner;
+		if (owner == pool) {
+			b->next = owner->freeLists[c];
+			owner->freeLists[c] = b;
+		} else {
+			// Back to the pool of the chunk, which only takes the whole list: no ABA problem
+			FreeBlock *head = owner->remoteLists[c].load(std::memory_order_relaxed);
+			do {
+				b->next = head;
+			} while (!owner->remoteLists[c].compare_exchange_weak(head, b, std::memory_order_release,
+																  std::memory_order_relaxed));
+		}
+		return;
+	}
+#endif
+	::operator delete(p);
+}
+
+} // BaseSimulator namespace
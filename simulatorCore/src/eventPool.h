@@ -0,0 +1,58 @@
+/*! @file eventPool.h
+ * @brief Pool allocator for simulation events and their shared_ptr control blocks
+ *  Memory is carved from large chunks into fixed-size blocks, one free list per size class and per thread.
+ *  A block freed by another thread than its owner goes back to the owner. The pools of the threads that exit are
+ *  adopted by the next threads. Freed blocks are kept for reuse and never returned to the system.
+ *  Define DISABLE_EVENT_POOL to fall back to the global allocator (when using a memory checker, for instance).
+ * @date 17/10/2026
+ */
+
+#ifndef EVENTPOOL_H_
+#define EVENTPOOL_H_
+
+#include <cstddef>
+#include <new>
+
+#define EVENT_POOL_GRANULARITY	16		//!< Size classes are multiples of this value (bytes)
+#define EVENT_POOL_MAX_SIZE		512		//!< Larger objects are allocated with the global allocator (bytes)
+#define EVENT_POOL_CHUNK_SIZE	65536	//!< Size of the memory chunks from which blocks are carved (bytes, power of 2)
+
+namespace BaseSimulator {
+
+//!< Allocation functions of the event pools, used by Event::operator new and EventAllocator
+class EventPool {
+public:
+	/**
+	 * @brief Allocates size bytes from the pool of the calling thread
+	 * @param size size of the block, blocks larger than EVENT_POOL_MAX_SIZE come from the global allocator
+	 */
+	static void *allocate(size_t size);
+	/**
+	 * @brief Returns a block to the pool of the thread that allocated it. It can be called from any thread
+	 * @param p block to release
+	 * @param size size that was requested at allocation
+	 */
+	static void release(void *p, size_t size);
+};
+
+//!< Standard allocator interface over EventPool, used to allocate the control block of EventPtr (see makeEventPtr)
+template <class T>
+class EventAllocator {
+public:
+	typedef T value_type;
+
+	EventAllocator() {};
+	template <class U> EventAllocator(const EventAllocator<U>&) {};
+
+	T *allocate(size_t n) { return static_cast<T*>(EventPool::allocate(n * sizeof(T))); };
+	void deallocate(T *p, size_t n) { EventPool::release(p, n * sizeof(T)); };
+};
+
+template <class T, class U>
+inline bool operator==(const EventAllocator<T>&, const EventAllocator<U>&) { return true; }
+template <class T, class U>
+inline bool operator!=(const EventAllocator<T>&, const EventAllocator<U>&) { return false; }
+
+} // BaseSimulator namespace
+
+#endif /* EVENTPOOL_H_ */
@@ -0,0 +1,68 @@
+/*! @file eventProfiler.cpp
+ * @brief Measures the time spent by the scheduler in the consume() function of each type of event
+ * One instance per simulation, owned by its SimulationContext.
+ * @date 17/10/2026
+ */
+
+#include "eventProfiler.h"
+#include "simulationContext.h"
+
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+namespace BaseSimulator {
+namespace utils {
+
+
+EventProfiler& EventProfiler::getInstance() {
+    return SimulationContext::current().profiler;
+}
+
+vector<pair<int, const EventTypeProfile*>> EventProfiler::sortedProfiles() const {
+    vector<pair<int, const EventTypeProfile*>> sorted;
+    for (size_t type = 0; type < profiles.size(); type++) {
+        if (profiles[type].count > 0) sorted.push_back(make_pair((int)type, &profiles[type]));
+    }
+    stable_sort(sorted.begin(), sorted.end(),
+                [](const pair<int, const EventTypeProfile*> &a, const pair<int, const EventTypeProfile*> &b) {
+                    return a.second->totalTime > b.second->totalTime;
+                });
+    return sorted;
+}
+
+bool EventProfiler::writeCSV(const string &path) const {
+    ofstream csv(path);
+    if (!csv.is_open()) return false;
+
+    csv << "eventType,name,count,totalTime(us),meanTime(us),maxTime(us)" << endl;
+    csv << std::setprecision(3) << std::fixed;
+    for (const auto &tp : sortedProfiles()) {
+        const EventTypeProfile &p = *tp.second;
+        csv << tp.first << ",\"" << p.name << "\"," << p.count << "," << p.totalTime / 1000.0 << ","
+            << p.totalTime / 1000.0 / p.count << "," << p.maxTime / 1000.0 << endl;
+    }
+    return !csv.fail();
+}
+
+ostream& operator<<(ostream& out,const EventProfiler &ep) {
+    vector<pair<int, const EventTypeProfile*>> sorted = ep.sortedProfiles();
+    uint64_t total = 0;
+    for (const auto &tp : sorted) total += tp.second->totalTime;
+
+    out << endl << "=== EVENT PROFILE ===" << endl;
+    out << "Format: \"event type (id): count, total time (us), mean time (us), max time (us), share of consume time\"" << endl;
+    out << std::setprecision(2) << std::fixed;
+    for (const auto &tp : sorted) {
+        const EventTypeProfile &p = *tp.second;
+        out << p.name << " (" << tp.first << "): " << p.count << ", " << p.totalTime / 1000.0 << ", "
+            << p.totalTime / 1000.0 / p.count << ", " << p.maxTime / 1000.0 << ", "
+            << (total ? 100.0 * p.totalTime / total : 0) << "%" << endl;
+    }
+    return out;
+}
+
+} // namespace BaseSimulator::utils
+} // namespace BaseSimulator
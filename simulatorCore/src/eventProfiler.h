@@ -0,0 +1,82 @@
+/*! @file eventProfiler.h
+ * @brief Measures the time spent by the scheduler in the consume() function of each type of event
+ * One instance per simulation, owned by its SimulationContext.
+ * @date 17/10/2026
+ */
+
+#ifndef EVENTPROFILER_H__
+#define EVENTPROFILER_H__
+
+#include <iostream>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "tDefs.h"
+
+namespace BaseSimulator {
+class SimulationContext;
+
+namespace utils {
+
+//!< Profile of a single type of event (see uniqueEventsId.h)
+struct EventTypeProfile {
+    std::string name; //!< Name of the event type, as returned by Event::getEventName() for the first event of the type
+    uint64_t count = 0; //!< Number of consumed events of the type
+    uint64_t totalTime = 0; //!< Cumulated time spent in consume() (ns)
+    uint64_t maxTime = 0; //!< Longest time spent in a single consume() (ns)
+};
+
+//!< Per event type profiler, one instance per simulation, fed by the scheduler loop when enabled (see Scheduler::processBatch)
+//!< @attention Any access to EventProfiler must be done through the getInstance() function
+class EventProfiler {
+public:
+    bool enable = false; //!< Activation flag: true if events are profiled, false otherwise (option -e)
+    std::string csvFile; //!< If not empty, the profile is also written to this file at scheduler end
+
+    //<! @brief Used to get the instance of EventProfiler of the simulation.
+    //<! @return instance of EventProfiler owned by the SimulationContext of the calling thread
+    static EventProfiler& getInstance();
+private:
+    friend class BaseSimulator::SimulationContext;
+    EventProfiler() {};        //!< Constructor. Nothing to be done.
+    EventProfiler(EventProfiler const&); //<! Disable copy constructor. (Copying instance is not allowed)
+    void operator=(EventProfiler const&); //<! Disable assignment operator. (Copying instance is not allowed)
+
+    std::vector<EventTypeProfile> profiles; //!< Profiles indexed by event type identifier
+
+    //!< Returns the profiles of the event types that have been consumed, by decreasing cumulated time
+    std::vector<std::pair<int, const EventTypeProfile*>> sortedProfiles() const;
+public:
+    /**
+     * @brief Accounts for the consumption of an event
+     * @param type event type identifier (Event::eventType)
+     * @param name callback returning the event name, only called the first time an event type is met
+     * @param ns time spent in consume() (ns)
+     */
+    template<typename NameFn>
+    inline void record(int type, NameFn name, uint64_t ns) {
+        if ((size_t)type >= profiles.size()) profiles.resize(type + 1);
+        EventTypeProfile &p = profiles[type];
+        if (p.count == 0 && p.name.empty()) p.name = name();
+        p.count++;
+        p.totalTime += ns;
+        p.maxTime = p.maxTime < ns ? ns : p.maxTime;
+    };
+
+    /**
+     * @brief Writes the profile to a CSV file, one line per event type
+     *  Columns: event type identifier, name, count, total, mean and maximum consume() times (us)
+     * @return false if the file cannot be written
+     */
+    bool writeCSV(const std::string &path) const;
+
+    //!< Prints the profile to an output stream
+    friend std::ostream& operator<<(std::ostream& out,const EventProfiler &ep);
+};                              // class EventProfiler
+
+} // namespace BaseSimulator::utils
+} // namespace BaseSimulator
+
+#endif // EVENTPROFILER_H__
@@ -0,0 +1,292 @@
+/*! @file eventQueue.cpp
+ * @brief Pending event set used by the Scheduler to store and order future events.
+ * @date 17/10/2026
+ */
+
+#include "eventQueue.h"
+
+using namespace std;
+
+namespace BaseSimulator {
+
+#define CALENDAR_MIN_BUCKETS 2 //!< Minimum number of buckets of a calendar queue
+#define CALENDAR_SAMPLE_SIZE 25 //!< Number of events used to estimate the width of a bucket
+
+EventQueue *EventQueue::create(int type) {
+	switch (type) {
+	case SCHEDULER_QUEUE_MAP: return new MultimapEventQueue();
+	case SCHEDULER_QUEUE_BINARY_HEAP: return new HeapEventQueue<2>();
+	case SCHEDULER_QUEUE_QUATERNARY_HEAP: return new HeapEventQueue<4>();
+	case SCHEDULER_QUEUE_CALENDAR: return new CalendarEventQueue();
+	default: return NULL;
+	}
+}
+
+int EventQueue::parseType(const string &name) {
+	if (name == "map") return SCHEDULER_QUEUE_MAP;
+	if (name == "heap") return SCHEDULER_QUEUE_BINARY_HEAP;
+	if (name == "heap4") return SCHEDULER_QUEUE_QUATERNARY_HEAP;
+	if (name == "calendar") return SCHEDULER_QUEUE_CALENDAR;
+	return -1;
+}
+
+size_t EventQueue::removeIf(const std::function<bool(const EventPtr&)> &pred) {
+	size_t removed = 0;
+	discard([this, &pred, &removed](const EventPtr &ev) {
+			if (!ev->cancelled && !pred(ev)) return false;
+			if (ev->cancelled) {
+				nbCancelled--;
+			} else {
+				unindex(ev.get());
+				removed++;
+			}
+			ev->queued = false;
+			return true;
+		});
+	return removed;
+}
+
+size_t EventQueue::removeEventsOf(BuildingBlock *bb) {
+	size_t removed = bb->queuedEvents.size();
+	for (Event *ev : bb->queuedEvents) {
+		ev->cancelled = true;
+		ev->indexSlot = EVENT_NOT_INDEXED;
+	}
+	bb->queuedEvents.clear();
+	nbCancelled += removed;
+	compactIfNeeded();
+	return removed;
+}
+
+size_t EventQueue::popBatch(vector<EventPtr> &batch) {
+	skipCancelled();
+	size_t first = batch.size();
+	dequeueRun(batch);
+
+	// Drop the cancelled events of the run
+	size_t last = first;
+	for (size_t i = first; i < batch.size(); i++) {
+		Event *ev = batch[i].get();
+		ev->queued = false;
+		if (ev->cancelled) {
+			nbCancelled--;
+			continue;
+		}
+		unindex(ev);
+		if (i != last) batch[last] = std::move(batch[i]);
+		last++;
+	}
+	batch.resize(last);
+	return last - first;
+}
+
+void EventQueue::compact() {
+	if (nbCancelled == 0) return;
+	discard([](const EventPtr &ev) {
+			if (!ev->cancelled) return false;
+			ev->queued = false;
+			return true;
+		});
+	nbCancelled = 0;
+}
+
+//===========================================================================================================
+//
+//          MultimapEventQueue  (class)
+//
+//===========================================================================================================
+
+size_t MultimapEventQueue::discard(const std::function<bool(const EventPtr&)> &pred) {
+	size_t removed = 0;
+	multimap<Time,EventPtr>::iterator im = eventsMap.begin();
+	while (im != eventsMap.end()) {
+		if (pred(im->second)) {
+			im = eventsMap.erase(im);
+			removed++;
+		} else im++;
+	}
+	return removed;
+}
+
+void MultimapEventQueue::dequeueRun(vector<EventPtr> &run) {
+	multimap<Time,EventPtr>::iterator end = eventsMap.upper_bound(eventsMap.begin()->first);
+	for (multimap<Time,EventPtr>::iterator im = eventsMap.begin(); im != end; im++) {
+		run.push_back(std::move(im->second));
+	}
+	eventsMap.erase(eventsMap.begin(), end);
+}
+
+//===========================================================================================================
+//
+//          CalendarEventQueue  (class)
+//
+//===========================================================================================================
+
+CalendarEventQueue::CalendarEventQueue() {
+	buckets.resize(CALENDAR_MIN_BUCKETS);
+	setOrigin(0);
+}
+
+void CalendarEventQueue::setOrigin(Time d) {
+	lastDate = d;
+	lastBucket = bucketOf(d);
+	bucketTop = (d / width + 1) * width;
+	topValid = false;
+}
+
+void CalendarEventQueue::insert(QueuedEvent &&q) {
+	deque<QueuedEvent> &b = buckets[bucketOf(q.date)];
+	// Most insertions go at the end of the bucket (later dates, or same date but later rank)
+	if (b.empty() || !(q < b.back())) {
+		b.push_back(std::move(q));
+	} else {
+		b.insert(upper_bound(b.begin(), b.end(), q), std::move(q));
+	}
+}
+
+void CalendarEventQueue::enqueue(EventPtr ev) {
+	QueuedEvent q(std::move(ev), nextSeq++);
+
+	// The year scan assumes that no event is earlier than the last dequeued one
+	if (q.date < lastDate) {
+		setOrigin(q.date);
+	}
+
+	size_t b = bucketOf(q.date);
+	if (topValid && q < buckets[topBucket].front()) {
+		topBucket = b;
+	}
+
+	insert(std::move(q));
+	nbEvents++;
+
+	if (nbEvents > 2 * buckets.size()) {
+		resize(2 * buckets.size());
+	}
+}
+
+void CalendarEventQueue::findTop() {
+	// Scan one year of the calendar, starting from the day of the last dequeued event
+	size_t i = lastBucket;
+	Time top = bucketTop;
+	for (size_t n = 0; n < buckets.size(); n++) {
+		const deque<QueuedEvent> &b = buckets[i];
+		if (!b.empty() && b.front().date < top) {
+			topBucket = i;
+			topValid = true;
+			return;
+		}
+		if (++i == buckets.size()) i = 0;
+		top += width;
+	}
+
+	// Nothing in the current year, fall back to a direct search among the heads of the buckets
+	size_t best = buckets.size();
+	for (i = 0; i < buckets.size(); i++) {
+		if (!buckets[i].empty() && (best == buckets.size() || buckets[i].front() < buckets[best].front())) {
+			best = i;
+		}
+	}
+	topBucket = best;
+	topValid = true;
+}
+
+const EventPtr &CalendarEventQueue::head() {
+	if (!topValid) findTop();
+	return buckets[topBucket].front().ev;
+}
+
+EventPtr CalendarEventQueue::dequeue() {
+	if (!topValid) findTop();
+
+	deque<QueuedEvent> &b = buckets[topBucket];
+	Time d = b.front().date;
+	EventPtr ev = std::move(b.front().ev);
+	b.pop_front();
+	nbEvents--;
+
+	lastDate = d;
+	lastBucket = topBucket;
+	bucketTop = (d / width + 1) * width;
+	topValid = false;
+
+	if (buckets.size() > CALENDAR_MIN_BUCKETS && nbEvents < buckets.size() / 2) {
+		resize(buckets.size() / 2);
+	}
+
+	return ev;
+}
+
+void CalendarEventQueue::dequeueRun(vector<EventPtr> &run) {
+	if (!topValid) findTop();
+
+	// Events of the same date are stored contiguously at the front of the same bucket
+	deque<QueuedEvent> &b = buckets[topBucket];
+	Time d = b.front().date;
+	do {
+		run.push_back(std::move(b.front().ev));
+		b.pop_front();
+		nbEvents--;
+	} while (!b.empty() && b.front().date == d);
+
+	lastDate = d;
+	lastBucket = topBucket;
+	bucketTop = (d / width + 1) * width;
+	topValid = false;
+
+	if (buckets.size() > CALENDAR_MIN_BUCKETS && nbEvents < buckets.size() / 2) {
+		resize(buckets.size() / 2);
+	}
+}
+
+void CalendarEventQueue::resize(size_t newSize) {
+	vector<QueuedEvent> all;
+	all.reserve(nbEvents);
+	for (deque<QueuedEvent> &b : buckets) {
+		for (QueuedEvent &q : b) all.push_back(std::move(q));
+	}
+	sort(all.begin(), all.end());
+
+	// Estimate the width of a day from the average separation of the earliest events,
+	// ignoring separations greater than twice the average (Brown, 1988)
+	size_t nbSamples = min(all.size(), (size_t)CALENDAR_SAMPLE_SIZE);
+	if (nbSamples > 1) {
+		Time total = all[nbSamples - 1].date - all[0].date;
+		Time avg = total / (nbSamples - 1);
+		Time sum = 0;
+		size_t count = 0;
+		for (size_t i = 1; i < nbSamples; i++) {
+			Time sep = all[i].date - all[i - 1].date;
+			if (sep <= 2 * avg) {
+				sum += sep;
+				count++;
+			}
+		}
+		Time newWidth = count ? 3 * sum / count : 0;
+		// Keep the previous width if all sampled events are simultaneous
+		if (newWidth > 0) width = newWidth;
+	}
+
+	buckets.clear();
+	buckets.resize(newSize);
+	setOrigin(lastDate);
+
+	// Events are inserted in increasing order, buckets end up sorted
+	for (QueuedEvent &q : all) {
+		buckets[bucketOf(q.date)].push_back(std::move(q));
+	}
+}
+
+size_t CalendarEventQueue::discard(const std::function<bool(const EventPtr&)> &pred) {
+	size_t removed = 0;
+	for (deque<QueuedEvent> &b : buckets) {
+		size_t n = b.size();
+		b.erase(remove_if(b.begin(), b.end(), [&pred](const QueuedEvent &q) { return pred(q.ev); }), b.end());
+		removed += n - b.size();
+	}
+	nbEvents -= removed;
+	topValid = false;
+	return removed;
+}
+
+} // BaseSimulator namespace
@@ -0,0 +1,365 @@
+/*! @file eventQueue.h
+ * @brief Pending event set used by the Scheduler to store and order future events.
+ *  Several interchangeable implementations are provided, and can be selected from the command line (-q).
+ *  All of them order events by date, and events sharing the same date by insertion order (FIFO).
+ * @date 17/10/2026
+ */
+
+#ifndef EVENTQUEUE_H_
+#define EVENTQUEUE_H_
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+
+#include "events.h"
+#include "tDefs.h"
+
+// Event queue implementations (defines the data structure used for the scheduler's pending events)
+#define SCHEDULER_QUEUE_MAP				1 //!< Balanced tree (std::multimap), legacy implementation
+#define SCHEDULER_QUEUE_BINARY_HEAP		2 //!< Implicit binary heap
+#define SCHEDULER_QUEUE_QUATERNARY_HEAP	3 //!< Implicit 4-ary heap, shallower and more cache friendly than the binary heap. (Default)
+#define SCHEDULER_QUEUE_CALENDAR		4 //!< Calendar queue (R. Brown, 1988), O(1) amortized operations on evenly spread dates
+
+#define EVENT_QUEUE_COMPACTION_MIN		1024 //!< Minimum number of cancelled events before the queue is compacted
+#define EVENT_QUEUE_COMPACTION_RATIO	2 //!< The queue is compacted when more than 1/RATIO of its stored events are cancelled
+
+namespace BaseSimulator {
+
+/**
+ * @brief Abstract pending event set
+ *  Events are ordered according to their date. Events with equal dates are ordered according to their
+ *  insertion rank, so that they are processed in the order in which they have been scheduled.
+ *  Implementations are not thread-safe, the Scheduler is responsible for mutual exclusion.
+ *
+ *  Queued events are indexed by concerned block (see BuildingBlock::queuedEvents), so that the events of a block can
+ *  be removed in time proportional to their number (see removeEventsOf). Removed and cancelled events are only marked
+ *  as cancelled (tombstones), and are discarded when they reach the top of the queue. When tombstones make up a
+ *  large part of the queue, they are removed all at once (compaction).
+ */
+class EventQueue {
+protected:
+	uint64_t nextSeq = 0; //!< Insertion rank of the next event, used to break ties between equal dates
+	size_t nbCancelled = 0; //!< Number of cancelled events still stored in the queue
+
+	//!< @brief Inserts event ev into the data structure, according to its date
+	virtual void enqueue(EventPtr ev) = 0;
+	//!< @brief Returns the earliest stored event, cancelled or not. Structure must not be empty
+	virtual const EventPtr &head() = 0;
+	//!< @brief Removes the earliest stored event and returns it. Structure must not be empty
+	virtual EventPtr dequeue() = 0;
+	//!< @brief Returns the number of stored events, including the cancelled ones
+	virtual size_t length() const = 0;
+	/**
+	 * @brief Removes all the stored events for which pred returns true, relative order of the remaining ones is preserved
+	 * @return number of events that have been removed
+	 */
+	virtual size_t discard(const std::function<bool(const EventPtr&)> &pred) = 0;
+	/**
+	 * @brief Removes the earliest stored event, and all the following ones with the same date, and appends them to
+	 *  run in order. Structure must not be empty. The default implementation dequeues the events one by one
+	 */
+	virtual void dequeueRun(vector<EventPtr> &run) {
+		Time d = head()->date;
+		do {
+			run.push_back(dequeue());
+		} while (length() > 0 && head()->date == d);
+	}
+
+	//!< @brief Adds ev to the index of its concerned block
+	inline void index(Event *ev) {
+		BuildingBlock *bb = ev->getConcernedBlock();
+		if (bb) {
+			ev->indexSlot = bb->queuedEvents.size();
+			bb->queuedEvents.push_back(ev);
+		}
+	}
+
+	//!< @brief Removes ev from the index of its concerned block, if present
+	inline void unindex(Event *ev) {
+		if (ev->indexSlot == EVENT_NOT_INDEXED) return;
+		vector<Event*> &events = ev->getConcernedBlock()->queuedEvents;
+		Event *last = events.back();
+		events[ev->indexSlot] = last;
+		last->indexSlot = ev->indexSlot;
+		events.pop_back();
+		ev->indexSlot = EVENT_NOT_INDEXED;
+	}
+
+	//!< @brief Drops the cancelled events from the top of the queue
+	inline void skipCancelled() {
+		while (nbCancelled > 0 && head()->cancelled) {
+			dequeue()->queued = false;
+			nbCancelled--;
+		}
+	}
+
+	//!< @brief Removes the cancelled events from the queue if they are too numerous
+	inline void compactIfNeeded() {
+		if (nbCancelled >= EVENT_QUEUE_COMPACTION_MIN && nbCancelled * EVENT_QUEUE_COMPACTION_RATIO > length()) {
+			compact();
+		}
+	}
+public:
+	virtual ~EventQueue() {};
+
+	//!< @brief Inserts event ev into the queue, according to its date. Pass an rvalue to avoid reference counting
+	inline void push(EventPtr ev) {
+		ev->queued = true;
+		index(ev.get());
+		enqueue(std::move(ev));
+	}
+
+	//!< @brief Returns the earliest event of the queue. Queue must not be empty
+	inline const EventPtr &top() {
+		skipCancelled();
+		return head();
+	}
+
+	//!< @brief Removes the earliest event from the queue and returns it. Queue must not be empty
+	inline EventPtr pop() {
+		skipCancelled();
+		EventPtr ev = dequeue();
+		ev->queued = false;
+		unindex(ev.get());
+		return ev;
+	}
+
+	/**
+	 * @brief Removes the earliest events of the queue, which share the same date, and appends them to batch in order
+	 *  Queue must not be empty
+	 * @return number of events appended to batch
+	 */
+	size_t popBatch(vector<EventPtr> &batch);
+
+	//!< @brief Returns true if the queue contains no event, cancelled events aside
+	inline bool empty() const { return length() == nbCancelled; };
+	//!< @brief Returns the number of events in the queue, cancelled events aside
+	inline size_t size() const { return length() - nbCancelled; };
+	//!< @brief Removes every event from the queue
+	inline void clear() { removeIf([](const EventPtr&) { return true; }); };
+
+	/**
+	 * @brief Removes all the events for which predicate pred returns true, relative order of the remaining ones is preserved
+	 *  Cancelled events are removed as well.
+	 * @param pred predicate to evaluate on every event of the queue
+	 * @return number of events that have been removed, cancelled events aside
+	 */
+	size_t removeIf(const std::function<bool(const EventPtr&)> &pred);
+	/**
+	 * @brief Removes all the events concerning block bb, in time proportional to their number
+	 *  Events are cancelled, and discarded when they reach the top of the queue
+	 * @return number of events that have been removed
+	 */
+	size_t removeEventsOf(BuildingBlock *bb);
+	/**
+	 * @brief Cancels queued event ev, which is discarded when it reaches the top of the queue
+	 *  Event must be in the queue, and not cancelled through the queue yet
+	 */
+	inline void cancel(Event *ev) {
+		ev->cancelled = true;
+		unindex(ev);
+		nbCancelled++;
+		compactIfNeeded();
+	}
+	//!< @brief Removes all the cancelled events from the queue
+	void compact();
+	//!< @brief Returns the number of cancelled events still stored in the queue
+	inline size_t getNbCancelled() const { return nbCancelled; };
+
+	//!< @brief Returns a printable name for the implementation
+	virtual const string getName() const = 0;
+
+	/**
+	 * @brief Instantiates a new event queue of the requested implementation
+	 * @param type one of the SCHEDULER_QUEUE_* constants
+	 * @return a pointer to the newly allocated queue, or NULL if type is unknown
+	 */
+	static EventQueue *create(int type);
+	/**
+	 * @brief Parses the name of a queue implementation, as given on the command line
+	 * @param name one of "map", "heap", "heap4", "calendar"
+	 * @return the corresponding SCHEDULER_QUEUE_* constant, or -1 if name is unknown
+	 */
+	static int parseType(const string &name);
+};
+
+/**
+ * @brief Queue element used by the array-based implementations
+ *  Stores the ordering key next to the event, so that comparisons do not need to dereference the event
+ */
+struct QueuedEvent {
+	Time date; //!< date of the event
+	uint64_t seq; //!< insertion rank of the event
+	EventPtr ev; //!< the event itself
+
+	QueuedEvent() : date(0), seq(0) {};
+	QueuedEvent(EventPtr &&e, uint64_t s) : date(e->date), seq(s), ev(std::move(e)) {};
+
+	//!< @brief Strict ordering on (date, insertion rank)
+	inline bool operator<(const QueuedEvent &q) const {
+		return date < q.date || (date == q.date && seq < q.seq);
+	}
+};
+
+/**
+ * @brief Legacy implementation, a multimap indexed by date.
+ *  multimap::insert places an element after all the elements of equal key, which preserves FIFO order
+ */
+class MultimapEventQueue : public EventQueue {
+	multimap<Time,EventPtr> eventsMap; //!< Collection of event lists indexed by date
+protected:
+	void enqueue(EventPtr ev) { Time d = ev->date; eventsMap.emplace_hint(eventsMap.end(), d, std::move(ev)); };
+	const EventPtr &head() { return eventsMap.begin()->second; };
+	EventPtr dequeue() {
+		EventPtr ev = std::move(eventsMap.begin()->second);
+		eventsMap.erase(eventsMap.begin());
+		return ev;
+	};
+	size_t length() const { return eventsMap.size(); };
+	size_t discard(const std::function<bool(const EventPtr&)> &pred);
+	void dequeueRun(vector<EventPtr> &run);
+public:
+	const string getName() const { return "map"; };
+
+	/**
+	 * @brief Read access to the underlying multimap, for schedulers that require a custom ordering of simultaneous
+	 *  events (MeldProcess): they look up where to insert an event, then insert it with pushBefore. Cancelled events
+	 *  are still in it
+	 */
+	const multimap<Time,EventPtr> &getMap() const { return eventsMap; };
+	/**
+	 * @brief Inserts event ev just before position hint, which must be among the events of the date of ev, or right
+	 *  after them. Like push, the event is indexed by block and can be cancelled
+	 */
+	inline void pushBefore(multimap<Time,EventPtr>::const_iterator hint, EventPtr ev) {
+		ev->queued = true;
+		index(ev.get());
+		Time d = ev->date;
+		eventsMap.emplace_hint(hint, d, std::move(ev));
+	};
+};
+
+/**
+ * @brief Implicit d-ary min-heap on (date, insertion rank)
+ *  D = 2 gives the classical binary heap, D = 4 halves the depth of the tree and keeps the children of a node in
+ *  the same cache line.
+ */
+template <unsigned D>
+class HeapEventQueue : public EventQueue {
+	vector<QueuedEvent> heap; //!< heap array, heap[0] is the earliest event
+
+	//!< @brief Moves element e up from hole i until the heap property is restored
+	void siftUp(size_t i, QueuedEvent &&e) {
+		while (i > 0) {
+			size_t parent = (i - 1) / D;
+			if (!(e < heap[parent])) break;
+			heap[i] = std::move(heap[parent]);
+			i = parent;
+		}
+		heap[i] = std::move(e);
+	}
+
+	//!< @brief Moves element e down from hole i until the heap property is restored
+	void siftDown(size_t i, QueuedEvent &&e) {
+		size_t n = heap.size();
+		for (;;) {
+			size_t first = i * D + 1;
+			if (first >= n) break;
+			size_t last = first + D < n ? first + D : n;
+			size_t best = first;
+			for (size_t c = first + 1; c < last; c++) {
+				if (heap[c] < heap[best]) best = c;
+			}
+			if (!(heap[best] < e)) break;
+			heap[i] = std::move(heap[best]);
+			i = best;
+		}
+		heap[i] = std::move(e);
+	}
+
+	//!< @brief Rebuilds the heap property on the whole array
+	void heapify() {
+		if (heap.size() < 2) return;
+		for (size_t i = (heap.size() - 2) / D + 1; i-- > 0;) {
+			QueuedEvent e = std::move(heap[i]);
+			siftDown(i, std::move(e));
+		}
+	}
+protected:
+	void enqueue(EventPtr ev) {
+		heap.emplace_back();
+		siftUp(heap.size() - 1, QueuedEvent(std::move(ev), nextSeq++));
+	};
+
+	const EventPtr &head() { return heap.front().ev; };
+
+	EventPtr dequeue() {
+		EventPtr ev = std::move(heap.front().ev);
+		QueuedEvent last = std::move(heap.back());
+		heap.pop_back();
+		if (!heap.empty()) siftDown(0, std::move(last));
+		return ev;
+	};
+
+	size_t length() const { return heap.size(); };
+
+	size_t discard(const std::function<bool(const EventPtr&)> &pred) {
+		size_t n = heap.size();
+		heap.erase(std::remove_if(heap.begin(), heap.end(),
+								  [&pred](const QueuedEvent &q) { return pred(q.ev); }),
+				   heap.end());
+		heapify();
+		return n - heap.size();
+	};
+public:
+	const string getName() const { return D == 2 ? "heap" : "heap" + to_string(D); };
+};
+
+/**
+ * @brief Calendar queue (R. Brown, "Calendar queues: a fast O(1) priority queue implementation for the
+ *  simulation event set problem", CACM 31(10), 1988)
+ *  Events are hashed by date into an array of buckets (days) of fixed width, each bucket being kept sorted.
+ *  The queue scans the buckets as a calendar, one year being nbBuckets days. The number of buckets follows the
+ *  size of the queue, and the width of a day is re-estimated from the spacing of the earliest events on resize.
+ */
+class CalendarEventQueue : public EventQueue {
+	vector<deque<QueuedEvent>> buckets; //!< the days of the calendar, each sorted on (date, insertion rank)
+	size_t nbEvents = 0; //!< number of events in the queue
+	Time width = 1; //!< width of a bucket (us)
+	size_t lastBucket = 0; //!< index of the bucket of the last dequeued event
+	Time bucketTop = 1; //!< upper bound (excluded) of the dates of the current year in bucket lastBucket
+	Time lastDate = 0; //!< date of the last dequeued event (lower bound of the dates of the queue)
+	size_t topBucket = 0; //!< cached index of the bucket holding the earliest event
+	bool topValid = false; //!< true if topBucket is up to date
+
+	//!< @brief Returns the bucket in which an event of date d is stored
+	inline size_t bucketOf(Time d) const { return (d / width) % buckets.size(); };
+	//!< @brief Inserts q in its bucket, after all the elements with a lower or equal key
+	void insert(QueuedEvent &&q);
+	//!< @brief Locates the earliest event of the queue, and sets topBucket
+	void findTop();
+	//!< @brief Changes the number of buckets to newSize, and estimates a new bucket width
+	void resize(size_t newSize);
+	//!< @brief (Re)starts the calendar at date d
+	void setOrigin(Time d);
+protected:
+	void enqueue(EventPtr ev);
+	const EventPtr &head();
+	EventPtr dequeue();
+	size_t length() const { return nbEvents; };
+	size_t discard(const std::function<bool(const EventPtr&)> &pred);
+	void dequeueRun(vector<EventPtr> &run);
+public:
+	CalendarEventQueue();
+
+	const string getName() const { return "calendar"; };
+};
+
+} // BaseSimulator namespace
+
+#endif /* EVENTQUEUE_H_ */
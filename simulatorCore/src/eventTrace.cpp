@@ -0,0 +1,165 @@
+/*! @file eventTrace.cpp
+ * @brief Records the sequence of events processed by the scheduler into a compact binary trace, and verifies that
+ *  another run processes the same sequence (see options -Y and -V)
+ * @date 17/10/2026
+ */
+
+#include "eventTrace.h"
+
+#include <iostream>
+
+using namespace std;
+
+namespace BaseSimulator {
+
+EventTrace::EventTrace(const string &p, bool verify, int seed, uint64_t first)
+	: verifying(verify), path(p), firstEvent(first), nbEvents(first) {
+	uint32_t header[3] = { EVENTTRACE_MAGIC, EVENTTRACE_VERSION, (uint32_t)seed };
+
+	if (verifying) {
+		in.open(path, ios::in | ios::binary);
+		if (!in.is_open()) throw EventTraceException("cannot open " + path);
+		uint32_t h[3];
+		in.read((char*)h, sizeof(h));
+		if (!in || h[0] != EVENTTRACE_MAGIC) throw EventTraceException(path + " is not an event trace");
+		if (h[1] != EVENTTRACE_VERSION) {
+			throw EventTraceException(path + " has been recorded by an incompatible version (format "
+									  + to_string(h[1]) + ", expected " + to_string(EVENTTRACE_VERSION) + ")");
+		}
+		if (h[2] != header[2]) {
+			throw EventTraceException(path + " has been recorded with seed " + to_string((int)h[2])
+									  + ", not " + to_string(seed));
+		}
+		uint64_t recordedFirst;
+		in.read((char*)&recordedFirst, sizeof(recordedFirst));
+		if (!in) throw EventTraceException(path + " is truncated");
+		if (recordedFirst > firstEvent) {
+			throw EventTraceException(path + " starts at event #" + to_string(recordedFirst)
+									  + ", after the start of this run at event #" + to_string(firstEvent)
+									  + " (record it from the same checkpoint, or from the start of the simulation)");
+		}
+
+		// Skips the events processed before the checkpoint the run resumes from
+		EventTraceRecord skipped;
+		for (uint64_t i = recordedFirst; i < firstEvent; i++) {
+			if (!readRecord(skipped)) {
+				throw EventTraceException(path + " ends at event #" + to_string(i)
+										  + ", before the start of this run at event #" + to_string(firstEvent));
+			}
+		}
+	} else {
+		out.open(path, ios::out | ios::binary | ios::trunc);
+		if (!out.is_open()) throw EventTraceException("cannot open " + path);
+		out.write((const char*)header, sizeof(header));
+		out.write((const char*)&firstEvent, sizeof(firstEvent));
+		buffer.reserve(EVENTTRACE_BUFFER_SIZE + 4 * 10);
+	}
+}
+
+EventTrace::~EventTrace() {
+	// Scheduler not ended normally: keeps the events recorded so far
+	if (!verifying && out.is_open()) {
+		out.write((const char*)buffer.data(), buffer.size());
+	}
+}
+
+void EventTrace::flush() {
+	out.write((const char*)buffer.data(), buffer.size());
+	buffer.clear();
+	if (!out) throw EventTraceException("cannot write " + path);
+}
+
+bool EventTrace::readVarint(uint64_t &v) {
+	v = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (bufferNext == buffer.size()) {
+			// Refills the buffer from the file
+			buffer.resize(EVENTTRACE_BUFFER_SIZE);
+			in.read((char*)buffer.data(), buffer.size());
+			buffer.resize(in.gcount());
+			bufferNext = 0;
+			if (buffer.empty()) {
+				if (shift > 0) throw EventTraceException(path + " is truncated");
+				return false;
+			}
+		}
+		uint8_t b = buffer[bufferNext++];
+		v |= (uint64_t)(b & 0x7F) << shift;
+		if (!(b & 0x80)) return true;
+	}
+	throw EventTraceException(path + " is corrupted");
+}
+
+bool EventTrace::readRecord(EventTraceRecord &r) {
+	uint64_t v[4];
+	if (!readVarint(v[0])) return false;
+	for (int i = 1; i < 4; i++) {
+		if (!readVarint(v[i])) throw EventTraceException(path + " is truncated");
+	}
+	r.date = lastDate + v[0];
+	r.eventType = (int)v[1];
+	r.blockId = (int64_t)v[2] - 1;
+	r.messageId = (int64_t)v[3] - 1;
+	lastDate = r.date;
+	return true;
+}
+
+bool EventTrace::verify(const EventTraceRecord &r, Event *ev) {
+	if (diverged) return false;
+
+	EventTraceRecord expected;
+	if (!readRecord(expected)) {
+		reportDivergence(NULL, &r, ev);
+		return false;
+	}
+	if (expected != r) {
+		reportDivergence(&expected, &r, ev);
+		return false;
+	}
+	lastMatch = r;
+	nbEvents++;
+	return true;
+}
+
+static ostream& operator<<(ostream &out, const EventTraceRecord &r) {
+	out << "date " << r.date << ", type " << r.eventType
+		<< ", block " << (r.blockId < 0 ? string("-") : to_string(r.blockId))
+		<< ", message " << (r.messageId < 0 ? string("-") : to_string(r.messageId));
+	return out;
+}
+
+void EventTrace::reportDivergence(const EventTraceRecord *expected, const EventTraceRecord *actual, Event *ev) {
+	diverged = true;
+	cerr << "error: the simulation diverges from trace " << path << " at event #" << nbEvents << endl;
+	if (nbEvents > firstEvent) {
+		cerr << "\tlast matching event: " << lastMatch << endl;
+	}
+	if (expected) {
+		cerr << "\texpected:            " << *expected << endl;
+	} else {
+		cerr << "\texpected:            end of the trace" << endl;
+	}
+	if (actual) {
+		cerr << "\tprocessed:           " << *actual << " (" << ev->getEventName() << ")" << endl;
+	} else {
+		cerr << "\tprocessed:           end of the simulation" << endl;
+	}
+}
+
+void EventTrace::finish() {
+	if (verifying) {
+		EventTraceRecord expected;
+		if (!diverged && readRecord(expected)) {
+			reportDivergence(&expected, NULL, NULL);
+		}
+		if (!diverged) {
+			cout << "\033[1;32m" << "Event trace: " << nbEvents - firstEvent << " events match " << path << "\033[0m" << endl;
+		}
+	} else {
+		flush();
+		out.close();
+		cout << "\033[1;33m" << "Event trace: " << nbEvents - firstEvent << " events recorded to " << path << "\033[0m" << endl;
+	}
+}
+
+} // namespace BaseSimulator
@@ -0,0 +1,146 @@
+/*! @file eventTrace.h
+ * @brief Records the sequence of events processed by the scheduler into a compact binary trace, and verifies that
+ *  another run processes the same sequence (see options -Y and -V)
+ * @date 17/10/2026
+ */
+
+#ifndef EVENTTRACE_H__
+#define EVENTTRACE_H__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "tDefs.h"
+#include "events.h"
+#include "buildingBlock.h"
+
+#define EVENTTRACE_MAGIC		0x52545356 //!< "VSTR", first bytes of a trace file
+#define EVENTTRACE_VERSION		2 //!< Version of the trace format, incremented on incompatible changes
+#define EVENTTRACE_BUFFER_SIZE	(64 * 1024) //!< Size (bytes) of the buffers through which the trace is written or read
+
+namespace BaseSimulator {
+
+//!< @brief Exception thrown when a trace cannot be written or read
+struct EventTraceException : std::runtime_error {
+	EventTraceException(const std::string &what) : std::runtime_error(what) {};
+};
+
+//!< @brief Part of a processed event stored in the trace
+struct EventTraceRecord {
+	Time date = 0; //!< Date of the event
+	int eventType = 0; //!< Type of the event (see uniqueEventsId.h)
+	int64_t blockId = -1; //!< Identifier of the module concerned by the event, -1 if none
+	int64_t messageId = -1; //!< Identifier of the message carried by the event, -1 if none (see Event::getMessageId)
+
+	bool operator==(const EventTraceRecord &r) const {
+		return date == r.date && eventType == r.eventType && blockId == r.blockId && messageId == r.messageId;
+	}
+	bool operator!=(const EventTraceRecord &r) const { return !(*this == r); }
+};
+
+/**
+ * @brief Event trace of a simulation, fed by the scheduler for each event it processes (see Scheduler::processBatch)
+ *
+ *  In record mode, the trace of the run is written to a file. In verify mode, the run is compared with the trace
+ *  of a previous run: the first event that differs from the recorded one (or that is missing, or in excess) is
+ *  reported as a divergence, and the scheduler stops there.
+ *
+ *  The file starts with a header (magic, version, simulation seed, index of the first recorded event), followed by
+ *  one record per event. Records are written as variable-length integers: the date as the difference with the
+ *  previous event, then the event type, and the module and message identifiers plus one (0 when there is none).
+ *  A record usually takes 4 to 8 bytes.
+ *
+ *  A run resumed from a checkpoint (see -C) starts after the events processed before the checkpoint: its trace
+ *  records their number as the index of its first event. It can be verified against the trace of the full run,
+ *  whose records before that index are skipped, or against a trace recorded from the same checkpoint.
+ */
+class EventTrace {
+	bool verifying; //!< true in verify mode, false in record mode
+	std::string path; //!< Trace file
+	std::ofstream out; //!< Output file in record mode
+	std::ifstream in; //!< Input file in verify mode
+	std::vector<uint8_t> buffer; //!< Bytes waiting to be written (record), or read and not decoded yet (verify)
+	size_t bufferNext = 0; //!< Index in buffer of the next byte to decode (verify)
+	Time lastDate = 0; //!< Date of the last record, from which the date of the next one is encoded
+
+	uint64_t firstEvent; //!< Number of events processed before the run, by the simulation it resumes (see -C)
+	uint64_t nbEvents; //!< Index of the next event to record or verify, from the start of the simulation
+	bool diverged = false; //!< true once a divergence has been found (verify)
+	EventTraceRecord lastMatch; //!< Last record that matched (verify)
+
+	//!< @brief Appends v to the buffer as a variable-length integer, 7 bits per byte
+	inline void writeVarint(uint64_t v) {
+		while (v >= 0x80) {
+			buffer.push_back((uint8_t)(v | 0x80));
+			v >>= 7;
+		}
+		buffer.push_back((uint8_t)v);
+	}
+	//!< @brief Decodes the next variable-length integer, returns false at the end of the file
+	bool readVarint(uint64_t &v);
+	//!< @brief Decodes the next record of the trace, returns false at the end of the file
+	bool readRecord(EventTraceRecord &r);
+	//!< @brief Writes the buffer to the file and empties it
+	void flush();
+	//!< @brief Reports the divergence of the run from the trace, at event nbEvents
+	void reportDivergence(const EventTraceRecord *expected, const EventTraceRecord *actual, Event *ev);
+public:
+	/**
+	 * @brief Opens a trace file
+	 * @param path file to write in record mode, or to compare the run with in verify mode
+	 * @param verify true for verify mode
+	 * @param seed seed of the simulation, stored in the header in record mode, and compared with it in verify mode
+	 * @param first number of events processed before the run, by the simulation it resumes from a checkpoint
+	 * @throw EventTraceException if the file cannot be opened, is not a trace, has been recorded with another seed,
+	 *  or starts after the event first
+	 */
+	EventTrace(const std::string &path, bool verify, int seed, uint64_t first = 0);
+	~EventTrace();
+
+	//!< @brief Returns the record of a processed event
+	static inline EventTraceRecord makeRecord(Event *ev) {
+		EventTraceRecord r;
+		BaseSimulator::BuildingBlock *bb = ev->getTracedBlock();
+		r.date = ev->date;
+		r.eventType = ev->eventType;
+		r.blockId = bb ? (int64_t)bb->blockId : -1;
+		r.messageId = ev->getMessageId();
+		return r;
+	}
+
+	/**
+	 * @brief Records a processed event, or compares it with the next event of the trace
+	 * @return false if the event diverges from the trace, the scheduler must then stop
+	 */
+	inline bool process(Event *ev) {
+		EventTraceRecord r = makeRecord(ev);
+		if (verifying) return verify(r, ev);
+		writeVarint(r.date - lastDate);
+		writeVarint((uint64_t)r.eventType);
+		writeVarint((uint64_t)(r.blockId + 1));
+		writeVarint((uint64_t)(r.messageId + 1));
+		lastDate = r.date;
+		nbEvents++;
+		if (buffer.size() >= EVENTTRACE_BUFFER_SIZE) flush();
+		return true;
+	}
+
+	//!< @brief Compares the record r of the processed event ev with the next event of the trace
+	bool verify(const EventTraceRecord &r, Event *ev);
+
+	/**
+	 * @brief Ends the trace at scheduler end: writes the end of the file (record), or checks that no recorded
+	 *  event is missing from the run (verify), and prints a summary
+	 */
+	void finish();
+
+	//!< @brief Returns true if the run has diverged from the trace
+	inline bool hasDiverged() const { return diverged; }
+};
+
+} // namespace BaseSimulator
+
+#endif // EVENTTRACE_H__
@@ -14,8 +14,6 @@
 #include "blockCode.h"
 #include "statsIndividual.h"
 
-int Event::nextId = 0;
-unsigned int Event::nbLivingEvents = 0;
 
 using namespace std;
 using namespace BaseSimulator;
@@ -27,9 +25,9 @@ using namespace BaseSimulator;
 //===========================================================================================================
 
 Event::Event(Time t) {
-	id = nextId;
-	nextId++;
-	nbLivingEvents++;
+	SimulationContext &context = SimulationContext::current();
+	id = context.nextEventId++;
+	context.nbLivingEvents++;
 	date = t;
 	eventType = EVENT_GENERIC;
 	randomNumber = 0;
@@ -37,9 +35,9 @@ Event::Event(Time t) {
 }
 
 Event::Event(Event *ev) {
-	id = nextId;
-	nextId++;
-	nbLivingEvents++;
+	SimulationContext &context = SimulationContext::current();
+	id = context.nextEventId++;
+	context.nbLivingEvents++;
 	date = ev->date;
 	eventType = ev->eventType;
 	randomNumber = 0;
@@ -48,7 +46,7 @@ Event::Event(Event *ev) {
 
 Event::~Event() {
 	EVENT_DESTRUCTOR_INFO();
-	nbLivingEvents--;
+	SimulationContext::current().nbLivingEvents--;
 }
 
 const string Event::getEventName() {
@@ -56,11 +54,11 @@ const string Event::getEventName() {
 }
 
 unsigned int Event::getNextId() {
-	return(nextId);
+	return(SimulationContext::current().nextEventId);
 }
 
 unsigned int Event::getNbLivingEvents() {
-	return(nbLivingEvents);
+	return(SimulationContext::current().nbLivingEvents);
 }
 
 //===========================================================================================================
@@ -227,15 +225,7 @@ NetworkInterfaceStopTransmittingEvent::~NetworkInterfaceStopTransmittingEvent()
 
 void NetworkInterfaceStopTransmittingEvent::consume() {
 	EVENT_CONSUME_INFO();
-	if (!interface->connectedInterface) {
-	  ERRPUT << "Warning: connection loss, untransmitted message!" << endl;
-	} else {
-	  BaseSimulator::BuildingBlock *receivingBlock = interface->connectedInterface->hostBlock;
-	  receivingBlock->scheduleLocalEvent(EventPtr(new NetworkInterfaceReceiveEvent(BaseSimulator::getScheduler()->now(), interface->connectedInterface, interface->messageBeingTransmitted)));
-	  BaseSimulator::utils::StatsIndividual::incReceivedMessageCount(receivingBlock->stats);
-	  BaseSimulator::utils::StatsIndividual::incIncommingMessageQueueSize(receivingBlock->stats);
-	}
-	
+	// The message has been delivered by the NetworkInterfaceDeliverEvent of the same date, scheduled just before this one
 	interface->messageBeingTransmitted.reset();
 	interface->availabilityDate = BaseSimulator::getScheduler()->now();
 	
@@ -249,6 +239,40 @@ const string NetworkInterfaceStopTransmittingEvent::getEventName() {
 	return("NetworkInterfaceStopTransmitting Event");
 }
 
+//===========================================================================================================
+//
+//          NetworkInterfaceDeliverEvent  (class)
+//
+//===========================================================================================================
+
+NetworkInterfaceDeliverEvent::NetworkInterfaceDeliverEvent(Time t, P2PNetworkInterface *ni, MessagePtr mes):Event(t) {
+	eventType = EVENT_NI_DELIVER;
+	interface = ni;
+	message = mes;
+	EVENT_CONSTRUCTOR_INFO();
+}
+
+NetworkInterfaceDeliverEvent::~NetworkInterfaceDeliverEvent() {
+	message.reset();
+	EVENT_DESTRUCTOR_INFO();
+}
+
+void NetworkInterfaceDeliverEvent::consume() {
+	EVENT_CONSUME_INFO();
+	if (message->sourceInterface->connectedInterface != interface) {
+	  ERRPUT << "Warning: connection loss, untransmitted message!" << endl;
+	} else {
+	  BaseSimulator::BuildingBlock *receivingBlock = interface->hostBlock;
+	  receivingBlock->scheduleLocalEvent(makeEventPtr(new NetworkInterfaceReceiveEvent(BaseSimulator::getScheduler()->now(), interface, message)));
+	  BaseSimulator::utils::StatsIndividual::incReceivedMessageCount(receivingBlock->stats);
+	  BaseSimulator::utils::StatsIndividual::incIncommingMessageQueueSize(receivingBlock->stats);
+	}
+}
+
+const string NetworkInterfaceDeliverEvent::getEventName() {
+	return("NetworkInterfaceDeliver Event");
+}
+
 //===========================================================================================================
 //
 //          WirelessNetworkInterfaceStopTransmittingEvent  (class)
@@ -267,14 +291,7 @@ WirelessNetworkInterfaceStopTransmittingEvent::~WirelessNetworkInterfaceStopTran
 
 void WirelessNetworkInterfaceStopTransmittingEvent::consume() {
     EVENT_CONSUME_INFO();
-
-    interface->messageBeingTransmitted.reset();
-    interface->availabilityDate = BaseSimulator::getScheduler()->now();
-    
-    if (interface->outgoingQueue.size() > 0) {
-        //cout << "one more to send !!" << endl;
-	BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceChannelListeningEvent(BaseSimulator::getScheduler()->now(),interface));
-    }
+    interface->stopTransmit();
 }
 
 const string WirelessNetworkInterfaceStopTransmittingEvent::getEventName() {
@@ -463,9 +480,10 @@ const string WirelessNetworkInterfaceEnqueueOutgoingEvent::getEventName() {
 //          WirelessNetworkInterfaceChannelListeningEvent  (class)
 //
 //===========================================================================================================
-WirelessNetworkInterfaceChannelListeningEvent::WirelessNetworkInterfaceChannelListeningEvent(Time t, WirelessNetworkInterface *ni):Event(t) {
+WirelessNetworkInterfaceChannelListeningEvent::WirelessNetworkInterfaceChannelListeningEvent(Time t, WirelessNetworkInterface *ni, uint32_t v):Event(t) {
     eventType = EVENT_WNI_CHANNEL_LISTENING;
     interface = ni;
+    version = v;
     EVENT_CONSTRUCTOR_INFO();
 }
 
@@ -475,19 +493,7 @@ WirelessNetworkInterfaceChannelListeningEvent::~WirelessNetworkInterfaceChannelL
 
 void WirelessNetworkInterfaceChannelListeningEvent::consume(){
     EVENT_CONSUME_INFO();
-    stringstream info;
-    std::random_device rand;
-    std::default_random_engine generator(rand());
-    std::uniform_int_distribution<int> distribution(0,400);
-    int randomBackoff = distribution(generator);
-    if (!interface->getAvailability() || interface->first){
-	info << "Channel used";
-	BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceChannelListeningEvent(BaseSimulator::getScheduler()->now()+randomBackoff,interface));
-   	if (interface->first) interface->first=false;
-    }
-    else
-	interface->send();	
-    getScheduler()->trace(info.str());
+    interface->backoffExpired(version);
 }
 
 const string WirelessNetworkInterfaceChannelListeningEvent::getEventName() {
@@ -511,12 +517,63 @@ WirelessNetworkInterfaceIdleEvent::~WirelessNetworkInterfaceIdleEvent() {
 
 void WirelessNetworkInterfaceIdleEvent::consume(){
     EVENT_CONSUME_INFO();
-    interface->setAvailability(true);
+    interface->stopSensing();
 }
 
 const string WirelessNetworkInterfaceIdleEvent::getEventName() {
     return("WirelessNetworkInterfaceIdleEvent Event");
 }
+
+//===========================================================================================================
+//
+//          WirelessNetworkInterfaceAckTimeoutEvent  (class)
+//
+//===========================================================================================================
+WirelessNetworkInterfaceAckTimeoutEvent::WirelessNetworkInterfaceAckTimeoutEvent(Time t, WirelessNetworkInterface *ni, uint32_t v):Event(t) {
+    eventType = EVENT_WNI_ACK_TIMEOUT;
+    interface = ni;
+    version = v;
+    EVENT_CONSTRUCTOR_INFO();
+}
+
+WirelessNetworkInterfaceAckTimeoutEvent::~WirelessNetworkInterfaceAckTimeoutEvent() {
+    EVENT_DESTRUCTOR_INFO();
+}
+
+void WirelessNetworkInterfaceAckTimeoutEvent::consume(){
+    EVENT_CONSUME_INFO();
+    interface->ackTimeout(version);
+}
+
+const string WirelessNetworkInterfaceAckTimeoutEvent::getEventName() {
+    return("WirelessNetworkInterfaceAckTimeoutEvent Event");
+}
+
+//===========================================================================================================
+//
+//          WirelessNetworkInterfaceSendAckEvent  (class)
+//
+//===========================================================================================================
+WirelessNetworkInterfaceSendAckEvent::WirelessNetworkInterfaceSendAckEvent(Time t, WirelessNetworkInterface *ni, WirelessMessagePtr ack):Event(t) {
+    eventType = EVENT_WNI_SEND_ACK;
+    interface = ni;
+    message = ack;
+    EVENT_CONSTRUCTOR_INFO();
+}
+
+WirelessNetworkInterfaceSendAckEvent::~WirelessNetworkInterfaceSendAckEvent() {
+    message.reset();
+    EVENT_DESTRUCTOR_INFO();
+}
+
+void WirelessNetworkInterfaceSendAckEvent::consume(){
+    EVENT_CONSUME_INFO();
+    interface->sendAck(message);
+}
+
+const string WirelessNetworkInterfaceSendAckEvent::getEventName() {
+    return("WirelessNetworkInterfaceSendAckEvent Event");
+}
 //===========================================================================================================
 //
 //          SetColorEvent  (class)
@@ -549,7 +606,7 @@ SetColorEvent::~SetColorEvent() {
 
 void SetColorEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new SetColorEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new SetColorEvent(this)));
 }
 
 const string SetColorEvent::getEventName() {
@@ -581,7 +638,7 @@ AddNeighborEvent::~AddNeighborEvent() {
 
 void AddNeighborEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new AddNeighborEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new AddNeighborEvent(this)));
 }
 
 const string AddNeighborEvent::getEventName() {
@@ -611,7 +668,7 @@ RemoveNeighborEvent::~RemoveNeighborEvent() {
 
 void RemoveNeighborEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new RemoveNeighborEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new RemoveNeighborEvent(this)));
 }
 
 const string RemoveNeighborEvent::getEventName() {
@@ -640,7 +697,7 @@ TapEvent::~TapEvent() {
 
 void TapEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new TapEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new TapEvent(this)));
 }
 
 const string TapEvent::getEventName() {
@@ -674,7 +731,7 @@ AccelEvent::~AccelEvent() {
 
 void AccelEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new AccelEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new AccelEvent(this)));
 }
 
 const string AccelEvent::getEventName() {
@@ -704,7 +761,7 @@ ShakeEvent::~ShakeEvent() {
 
 void ShakeEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new ShakeEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new ShakeEvent(this)));
 }
 
 const string ShakeEvent::getEventName() {
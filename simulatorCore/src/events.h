@@ -12,17 +12,22 @@
 
 #include <inttypes.h>
 #include <string>
+#include <atomic>
 #include "buildingBlock.h"
 #include "uniqueEventsId.h"
 #include "network.h"
 #include "color.h"
 #include "tDefs.h"
 #include "random.h"
+#include "eventPool.h"
+#include "simulationContext.h"
 
 using namespace std;
 
 class Event;
 
+#define EVENT_NOT_INDEXED	SIZE_MAX //!< Event::indexSlot of an event that is not in the index of a module
+
 typedef std::shared_ptr<Event> EventPtr;
 
 #ifdef DEBUG_EVENTS
@@ -46,15 +51,15 @@ typedef std::shared_ptr<Event> EventPtr;
 //===========================================================================================================
 
 class Event {
-protected:
-	static int nextId;
-	static unsigned int nbLivingEvents;
-
 public:
 	int id;				//!< unique ID of the event (mainly for debugging purpose)
 	Time date;		//!< time at which the event will be processed. 0 means simulation start
 	int eventType;		//!< see the various types at the beginning of this file
 	BaseSimulator::ruint randomNumber;
+	bool queued = false; //!< true while the event is stored in the event list of the scheduler (see EventQueue)
+	bool cancelled = false; //!< true if the event has been cancelled, it is discarded instead of being processed (see Scheduler::cancel)
+	bool processed = false; //!< true once a parallel engine has processed the event (see ParallelEngine::cancel)
+	size_t indexSlot = EVENT_NOT_INDEXED; //!< position of the event in BuildingBlock::queuedEvents of its concerned block
 
 	Event(Time t);
 	Event(Event *ev);
@@ -66,6 +71,49 @@ class Event {
 	static unsigned int getNextId();
 	static unsigned int getNbLivingEvents();
 	virtual BaseSimulator::BuildingBlock* getConcernedBlock() { return NULL; };
+	/**
+	 * @brief Returns the only module whose state is modified by this event, or NULL if the event may modify the state
+	 *  of several modules or of the world. Events with an owner can be processed concurrently with the events of other
+	 *  modules by a parallel engine (see parallelEngine.h), events without owner are processed alone.
+	 */
+	virtual BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
+	//!< @brief Returns the module the event is recorded for in event traces, or NULL if none (see eventTrace.h)
+	virtual BaseSimulator::BuildingBlock* getTracedBlock() {
+		BaseSimulator::BuildingBlock *bb = getConcernedBlock();
+		return bb ? bb : getOwnerBlock();
+	};
+	//!< @brief Returns the identifier of the message carried by the event, or -1 if none (see eventTrace.h)
+	virtual int64_t getMessageId() { return -1; };
+
+	//!< @brief Events are allocated from per-thread free lists, one for each object size (see eventPool.h)
+	static void *operator new(size_t size) { return BaseSimulator::EventPool::allocate(size); };
+	//!< @brief Returns the memory of an event to the free lists. Size is the one of the most derived type
+	static void operator delete(void *p, size_t size) { BaseSimulator::EventPool::release(p, size); };
+};
+
+/**
+ * @brief Wraps a newly allocated event into an EventPtr, allocating its control block from the event pools
+ *  Prefer it over EventPtr(ev), which allocates the control block with the global allocator.
+ */
+inline EventPtr makeEventPtr(Event *ev) {
+	return EventPtr(ev, std::default_delete<Event>(), BaseSimulator::EventAllocator<Event>());
+}
+
+/**
+ * @brief Handle on a scheduled event, returned by Scheduler::scheduleCancellable and used to cancel it (see Scheduler::cancel)
+ *  The handle does not keep the event alive. It converts to true if the event has been scheduled.
+ */
+class EventHandle {
+	std::weak_ptr<Event> ev; //!< the event, expired once it has been processed or discarded
+	bool scheduled = false; //!< true if the event has been accepted by the scheduler
+public:
+	EventHandle() {};
+	EventHandle(const EventPtr &e) : ev(e), scheduled(true) {};
+
+	//!< @brief Returns the event if it is still alive, NULL otherwise
+	inline EventPtr lock() const { return ev.lock(); };
+	//!< @brief Returns true if the event has been scheduled
+	inline explicit operator bool() const { return scheduled; };
 };
 
 //===========================================================================================================
@@ -85,6 +133,8 @@ class BlockEvent : public Event {
 
 public:
 	BaseSimulator::BuildingBlock* getConcernedBlock() {return concernedBlock;};
+	//!< @brief Block events only modify their concerned module, unless they override this (motions, for instance)
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return concernedBlock; };
 	virtual void consumeBlockEvent() = 0;
 	virtual void consume() {
 		if (concernedBlock->getState() >= BaseSimulator::BuildingBlock::ALIVE) {
@@ -154,6 +204,7 @@ class NetworkInterfaceStartTransmittingEvent : public Event {
 	~NetworkInterfaceStartTransmittingEvent();
 	void consume();
 	const virtual string getEventName();
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
 };
 
 //===========================================================================================================
@@ -172,6 +223,9 @@ class WirelessNetworkInterfaceStartTransmittingEvent : public Event {
     ~WirelessNetworkInterfaceStartTransmittingEvent();
     void consume();
     const virtual string getEventName();
+    // Starts a transmission, which reaches the other modules after the propagation delay: owned only if it is not null
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return WirelessNetworkInterface::getPropagationDelay() > 0 ? interface->hostBlock : NULL; };
+    BaseSimulator::BuildingBlock* getTracedBlock() { return interface->hostBlock; };
 };
 
 //===========================================================================================================
@@ -190,6 +244,27 @@ class NetworkInterfaceStopTransmittingEvent : public Event {
     ~NetworkInterfaceStopTransmittingEvent();
     void consume();
     const virtual string getEventName();
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
+};
+
+//===========================================================================================================
+//
+//          NetworkInterfaceDeliverEvent  (class)
+//
+//===========================================================================================================
+
+//!< End of a P2P transmission, on the receiver side: the message is added to the local events of the receiving module
+class NetworkInterfaceDeliverEvent : public Event {
+public:
+	P2PNetworkInterface *interface; //!< receiving interface
+	MessagePtr message;
+
+	NetworkInterfaceDeliverEvent(Time, P2PNetworkInterface *ni, MessagePtr mes);
+	~NetworkInterfaceDeliverEvent();
+	void consume();
+	const virtual string getEventName();
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
+	int64_t getMessageId() { return message->id; };
 };
 
 //===========================================================================================================
@@ -208,6 +283,9 @@ class WirelessNetworkInterfaceStopTransmittingEvent : public Event {
 	~WirelessNetworkInterfaceStopTransmittingEvent();
 	void consume();
 	const virtual string getEventName();
+	// Schedules a channel listening event at the same date, hence the same owner
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return WirelessNetworkInterface::getPropagationDelay() > 0 ? interface->hostBlock : NULL; };
+	BaseSimulator::BuildingBlock* getTracedBlock() { return interface->hostBlock; };
 };
 
 //===========================================================================================================
@@ -225,6 +303,8 @@ class NetworkInterfaceReceiveEvent : public Event {
 	~NetworkInterfaceReceiveEvent();
 	void consume();
 	const virtual string getEventName();
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
+	int64_t getMessageId() { return message->id; };
 };
 
 //===========================================================================================================
@@ -242,6 +322,8 @@ class WirelessNetworkInterfaceStartReceiveEvent : public Event {
     ~WirelessNetworkInterfaceStartReceiveEvent();
     void consume();
     const virtual string getEventName();
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
+    int64_t getMessageId() { return message->id; };
 };
 
 //===========================================================================================================
@@ -258,6 +340,7 @@ class WirelessNetworkInterfaceStopReceiveEvent : public Event {
     ~WirelessNetworkInterfaceStopReceiveEvent();
     void consume();
     const virtual string getEventName();
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
 };
 
 //===========================================================================================================
@@ -275,6 +358,8 @@ class WirelessNetworkInterfaceMessageReceivedEvent : public Event {
     ~WirelessNetworkInterfaceMessageReceivedEvent();
     void consume();
     const virtual string getEventName();
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
+    int64_t getMessageId() { return message->id; };
 };
 
 //===========================================================================================================
@@ -296,6 +381,8 @@ class NetworkInterfaceEnqueueOutgoingEvent : public Event {
 	~NetworkInterfaceEnqueueOutgoingEvent();
 	void consume();
 	const virtual string getEventName();
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return sourceInterface->hostBlock; };
+	int64_t getMessageId() { return message->id; };
 };
 
 //===========================================================================================================
@@ -319,6 +406,10 @@ class WirelessNetworkInterfaceEnqueueOutgoingEvent : public Event {
     ~WirelessNetworkInterfaceEnqueueOutgoingEvent();
     void consume();
     const virtual string getEventName();
+    // Only modifies its own interface: the channel listening event it schedules is at least DIFS later
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return sourceInterface->hostBlock; };
+    BaseSimulator::BuildingBlock* getTracedBlock() { return sourceInterface->hostBlock; };
+    int64_t getMessageId() { return message->id; };
 };
 
 //===========================================================================================================
@@ -327,14 +418,19 @@ class WirelessNetworkInterfaceEnqueueOutgoingEvent : public Event {
 //
 //===========================================================================================================
 
+// End of the backoff of the message at the head of the outgoing queue, ignored if the backoff has been frozen since
 class WirelessNetworkInterfaceChannelListeningEvent : public Event {
 public:
     WirelessNetworkInterface *interface;
+    uint32_t version; //!< Version of the backoff (see WirelessNetworkInterface::getMacVersion)
     
-    WirelessNetworkInterfaceChannelListeningEvent(Time, WirelessNetworkInterface *ni);
+    WirelessNetworkInterfaceChannelListeningEvent(Time, WirelessNetworkInterface *ni, uint32_t v);
     ~WirelessNetworkInterfaceChannelListeningEvent();
     void consume();
     const virtual string getEventName();
+    // Starts a transmission, which reaches the other modules after the propagation delay: owned only if it is not null
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return WirelessNetworkInterface::getPropagationDelay() > 0 ? interface->hostBlock : NULL; };
+    BaseSimulator::BuildingBlock* getTracedBlock() { return interface->hostBlock; };
 };
 
 //===========================================================================================================
@@ -351,6 +447,47 @@ class WirelessNetworkInterfaceIdleEvent : public Event {
     ~WirelessNetworkInterfaceIdleEvent();
     void consume();
     const virtual string getEventName();
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
+};
+
+//===========================================================================================================
+//
+//          WirelessNetworkInterfaceAckTimeoutEvent  (class)
+//
+//===========================================================================================================
+
+// No acknowledgment of the message sent, ignored if the acknowledgment has been received since
+class WirelessNetworkInterfaceAckTimeoutEvent : public Event {
+public:
+    WirelessNetworkInterface *interface;
+    uint32_t version; //!< Version of the timeout (see WirelessNetworkInterface::getMacVersion)
+    
+    WirelessNetworkInterfaceAckTimeoutEvent(Time, WirelessNetworkInterface *ni, uint32_t v);
+    ~WirelessNetworkInterfaceAckTimeoutEvent();
+    void consume();
+    const virtual string getEventName();
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return interface->hostBlock; };
+    BaseSimulator::BuildingBlock* getTracedBlock() { return interface->hostBlock; };
+};
+
+//===========================================================================================================
+//
+//          WirelessNetworkInterfaceSendAckEvent  (class)
+//
+//===========================================================================================================
+
+class WirelessNetworkInterfaceSendAckEvent : public Event {
+public:
+    WirelessNetworkInterface *interface;
+    WirelessMessagePtr message; //!< The acknowledgment
+    
+    WirelessNetworkInterfaceSendAckEvent(Time, WirelessNetworkInterface *ni, WirelessMessagePtr ack);
+    ~WirelessNetworkInterfaceSendAckEvent();
+    void consume();
+    const virtual string getEventName();
+    // Starts a transmission, which reaches the other modules after the propagation delay: owned only if it is not null
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return WirelessNetworkInterface::getPropagationDelay() > 0 ? interface->hostBlock : NULL; };
+    BaseSimulator::BuildingBlock* getTracedBlock() { return interface->hostBlock; };
 };
 
 //===========================================================================================================
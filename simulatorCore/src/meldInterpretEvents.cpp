@@ -34,7 +34,7 @@ VMSetIdEvent::~VMSetIdEvent() {
 
 void VMSetIdEvent::consume() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMSetIdEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMSetIdEvent(this)));
 }
 
 const string VMSetIdEvent::getEventName() {
@@ -62,8 +62,8 @@ VMStopEvent::~VMStopEvent() {
 
 void VMStopEvent::consume() {
 	EVENT_CONSUME_INFO();
-	//concernedBlock->scheduleLocalEvent(EventPtr(new VMStopEvent(this)));
-	concernedBlock->blockCode->processLocalEvent(EventPtr(new VMStopEvent(this)));
+	//concernedBlock->scheduleLocalEvent(makeEventPtr(new VMStopEvent(this)));
+	concernedBlock->blockCode->processLocalEvent(makeEventPtr(new VMStopEvent(this)));
 }
 
 const string VMStopEvent::getEventName() {
@@ -98,7 +98,7 @@ VMSendMessageEvent::~VMSendMessageEvent() {
 
 void VMSendMessageEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMSendMessageEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMSendMessageEvent(this)));
 }
 
 const string VMSendMessageEvent::getEventName() {
@@ -135,7 +135,7 @@ VMSendMessageEvent2::~VMSendMessageEvent2() {
 void VMSendMessageEvent2::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
 	//concernedBlock->processLocalEvent();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMSendMessageEvent2(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMSendMessageEvent2(this)));
 }
 
 const string VMSendMessageEvent2::getEventName() {
@@ -166,7 +166,7 @@ VMReceiveMessageEvent2::~VMReceiveMessageEvent2() {
 
 void VMReceiveMessageEvent2::consumeBlockEvent() {
   EVENT_CONSUME_INFO();
-  concernedBlock->scheduleLocalEvent(EventPtr(new VMReceiveMessageEvent2(this)));
+  concernedBlock->scheduleLocalEvent(makeEventPtr(new VMReceiveMessageEvent2(this)));
 }
 
 const string VMReceiveMessageEvent2::getEventName() {
@@ -196,7 +196,7 @@ VMHandleDebugCommandEvent::~VMHandleDebugCommandEvent() {
 
 void VMHandleDebugCommandEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMHandleDebugCommandEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMHandleDebugCommandEvent(this)));
 }
 
 const string VMHandleDebugCommandEvent::getEventName() {
@@ -255,7 +255,7 @@ VMEndPollEvent::~VMEndPollEvent() {
 
 void VMEndPollEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMEndPollEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMEndPollEvent(this)));
 	return;
 }
 
@@ -285,7 +285,7 @@ ComputePredicateEvent::~ComputePredicateEvent() {
 
 void ComputePredicateEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new ComputePredicateEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new ComputePredicateEvent(this)));
 }
 
 const string ComputePredicateEvent::getEventName() {
@@ -318,7 +318,7 @@ AddTupleEvent::~AddTupleEvent() {
 
 void AddTupleEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new AddTupleEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new AddTupleEvent(this)));
 }
 
 const string AddTupleEvent::getEventName() {
@@ -351,7 +351,7 @@ RemoveTupleEvent::~RemoveTupleEvent() {
 
 void RemoveTupleEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new RemoveTupleEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new RemoveTupleEvent(this)));
 }
 
 const string RemoveTupleEvent::getEventName() {
@@ -21,8 +21,6 @@
 #include "trace.h"
 
 using namespace std;
-using us = chrono::microseconds;
-using get_time = chrono::steady_clock;
 
 namespace MeldInterpret {
 
@@ -38,11 +36,11 @@ MeldInterpretScheduler::~MeldInterpretScheduler() {
 }
 
 void MeldInterpretScheduler::createScheduler() {
-    scheduler = new MeldInterpretScheduler();
+    new MeldInterpretScheduler();
 }
 
 void MeldInterpretScheduler::deleteScheduler() {
-    delete((MeldInterpretScheduler*)scheduler);
+    delete((MeldInterpretScheduler*)getScheduler());
 }
 
 
@@ -60,10 +58,10 @@ void MeldInterpretScheduler::SemWaitOrReadDebugMessage() {
 }
 
 void *MeldInterpretScheduler::startPaused(/*void *param*/) {
+    context->bind();
 
     int seed = 500;
     srand (seed);
-    bool hasProcessed = false;
 
     // 1) world ready
     // 2) user start order
@@ -83,189 +81,29 @@ void *MeldInterpretScheduler::startPaused(/*void *param*/) {
     sem_schedulerStart->wait();
     schedulerMode = SCHEDULER_MODE_FASTEST;
 #endif
-    state = RUNNING;
-    //checkForReceivedVMCommands();
-    multimap<Time, EventPtr>::iterator first, tmp;
-    EventPtr pev;
-	auto systemStartTime = get_time::now();
-    auto pausedTime = systemStartTime - systemStartTime; // zero by default
-	cout << "\033[1;33m" << "Scheduler : start order received " << 0 << "\033[0m" << endl;
-
-    switch (schedulerMode) {
-    case SCHEDULER_MODE_FASTEST:
-        OUTPUT << "fastest mode scheduler\n" << endl;
-        //MeldInterpretDebugger::print("Simulation starts in deterministic mode");
-        while (state != ENDED) {
-            do {
-                  while (!eventsMap.empty()  || schedulerLength == SCHEDULER_LENGTH_INFINITE) {
-                        hasProcessed = true;
-                        // lock();
-                        first = eventsMap.begin();
-                        pev = (*first).second;
-                        currentDate = pev->date;
-                        pev->consume();
-                        StatsCollector::getInstance().incEventsCount();
-                        eventsMap.erase(first);
-                        eventsMapSize--;
-                        // unlock();
-                        if (state == PAUSED) {
-                              if (MeldInterpretVM::isInDebuggingMode()) {
-                              //getDebugger()->handleBreakAtTimeReached(currentDate);
-                              } else {
-                                    sem_schedulerStart->wait();
-                              }
-                              setState(RUNNING);
-                        }
-
-                        // Check that we have not reached the maximum simulation date, if there is one
-                        if (currentDate > maximumDate) {
-                            cout << "\033[1;33m" << "Scheduler : maximum simulation date (" << maximumDate
-                                 << ") has been reached. Terminating..." << "\033[0m" << endl;
-                            break;
-                        }
-
-                        //checkForReceivedVMCommands();
-                  }
-                  OUTPUT << "EventMap is empty" << endl;
-                  // PTHY: Equilibrium doesn't seem to be working, use SCHEDULER_LENGTH_INFINITE
-                  //       to keep looping
-                  if (eventsMap.empty() && schedulerLength != SCHEDULER_LENGTH_INFINITE) {
-                      state = ENDED;
-                      break;
-                  }
-
-                  if (terminate.load()) {
-                      break;
-                  }
-                //checkForReceivedVMCommands();
-            } while (!MeldInterpretVM::equilibrium() || !eventsMap.empty());
-
-            if(hasProcessed) {
-                hasProcessed = false;
-                ostringstream s;
-                s << "Equilibrium reached at "<< now() << "us ...";
-                //MeldInterpretDebugger::print(s.str(), false);
-                /*if (getSimulator()->testMode) {
-                  BlinkyBlocks::getWorld()->dump();
-                  stop(0);
-                  return 0;
-                  }*/
-                if (MeldInterpretVM::isInDebuggingMode()) {
-                    //getDebugger()->handlePauseRequest();
-                }
-            }
+    // if ENDED: Simulation terminated before scheduler start, quitting
+    if (state != ENDED) {
+        run();
+    }
 
-            //checkForReceivedVMCommands();
-        }
 #ifdef TEST_DETER
-        getWorld()->killAllVMs();
-        exit(0);
+    getWorld()->killAllVMs();
+    exit(0);
 #endif
-        break;
-
-    case SCHEDULER_MODE_REALTIME: 
-        OUTPUT << "Realtime mode scheduler\n" << endl;
-        //MeldInterpretDebugger::print("Simulation starts in real time mode");
-	    while((state != ENDED && !eventsMap.empty()) || schedulerLength == SCHEDULER_LENGTH_INFINITE) {
-	        auto systemCurrentTime = get_time::now() - pausedTime;
-	    	auto systemCurrentTimeMax = systemCurrentTime - systemStartTime;
-            // currentDate = systemCurrentTimeMax;
-            //checkForReceivedVMCommands();
-            // while (true) {
-            //     // Lock from here, to be sure that the element
-            //     // is not destroyed in another thread
-            //     // (previously the graphic interface was doing
-            //     // it).
-            //     lock();
-            //     if (eventsMap.empty()) {
-            //         unlock();
-            //         break;
-            //     }
-            //     first=eventsMap.begin();
-            //     pev = (*first).second;
-            //     if(pev->date > systemCurrentTimeMax) {
-            //         unlock();
-            //         break;
-            //     }
-            //     currentDate = pev->date;
-            //     pev->consume();
-            //     eventsMap.erase(first);
-            //     eventsMapSize--;
-            //     unlock();
-            //     //cout << "check to send" << endl;
-            //     //checkForReceivedVMCommands();
-            //     //cout << "ok" << endl;
-            // }
-            
-			if (!eventsMap.empty()) {
-				first=eventsMap.begin();
-				pev = (*first).second;
-				while (!eventsMap.empty() && pev->date <= chrono::duration_cast<us>(systemCurrentTimeMax).count()) {
-					first=eventsMap.begin();
-					pev = (*first).second;
-					currentDate = pev->date;
-					//lock();
-					pev->consume();
-                    StatsCollector::getInstance().incEventsCount();
-					//unlock();
-					eventsMap.erase(first);
-					eventsMapSize--;
-				}
-			}
-
-			if (!eventsMap.empty()) {
-				//ev = *(listeEvenements.begin());
-				first=eventsMap.begin();
-				pev = (*first).second;
-			}
 
-            if (state == PAUSED) {
-                cout << "paused" << endl;
-                auto pauseBeginning = get_time::now();
-                SemWaitOrReadDebugMessage();
-                setState(RUNNING);
-                pausedTime = get_time::now() - pauseBeginning;
-            }
+    terminate.store(true);
 
-			if (!eventsMap.empty() || schedulerLength == SCHEDULER_LENGTH_INFINITE) {
-				std::chrono::milliseconds timespan(5);
-				std::this_thread::sleep_for(timespan);
-			}
+    return(NULL);
+}
 
-            
-			if (terminate.load()) {
-				break;
-			}
-        }
-    break;
-    default:
-        OUTPUT << "ERROR : Scheduler mode not recognized !!" << endl;
+void MeldInterpretScheduler::waitWhilePaused() {
+    if (schedulerMode == SCHEDULER_MODE_REALTIME) {
+        cout << "paused" << endl;
+        SemWaitOrReadDebugMessage();
+    } else if (!MeldInterpretVM::isInDebuggingMode()) {
+        //getDebugger()->handleBreakAtTimeReached(currentDate);
+        sem_schedulerStart->wait();
     }
-
-    auto systemStopTime = get_time::now();
-	auto elapsedTime = systemStopTime - systemStartTime;
-
-	cout << "\033[1;33m" << "Scheduler end : " << chrono::duration_cast<us>(elapsedTime).count() << "\033[0m" << endl;
-
-	pev.reset();
-
-	StatsCollector::getInstance().updateElapsedTime(currentDate, chrono::duration_cast<us>(elapsedTime).count());
-	StatsCollector::getInstance().setLivingCounters(Event::getNbLivingEvents(), Message::getNbMessages());
-	StatsCollector::getInstance().setEndEventsQueueSize(eventsMap.size());
-
-	// if simulation is a regression testing run, export configuration before leaving
-	if (Simulator::regrTesting && !terminate.load())
-		getWorld()->exportConfiguration();
-	
-	// if autoStop is enabled, terminate simulation
-	if (willAutoStop() && !terminate.load())
-		glutLeaveMainLoop();
-
-	printStats();
-
-	terminate.store(true);
-	
-    return(NULL);
 }
 
 void MeldInterpretScheduler::pause(Time date) {
@@ -273,15 +111,14 @@ void MeldInterpretScheduler::pause(Time date) {
 }
 
 void MeldInterpretScheduler::unPause() {
-    MeldInterpretScheduler* sbs = (MeldInterpretScheduler*)scheduler;
     if (state != RUNNING) {
-        sbs->sem_schedulerStart->signal();
+        sem_schedulerStart->signal();
     }
     OUTPUT << "unpause sim" << endl;
 }
 
 void MeldInterpretScheduler::stop(Time date) {
-    if (GlutContext::GUIisEnabled) {
+    if (GlutContext::isGUIEnabled()) {
         schedulerThread->detach();
         schedulerThread = NULL;
     }
@@ -22,12 +22,13 @@ class MeldInterpretScheduler : public BaseSimulator::Scheduler {
 	MeldInterpretScheduler();
 	virtual ~MeldInterpretScheduler();
 	void* startPaused(/*void *param */);
+	//!< @brief Waits for the debugger, or for a new start order
+	void waitWhilePaused();
 public:
 	static void createScheduler();
 	static void deleteScheduler();
 	static MeldInterpretScheduler* getScheduler() {
-		assert(scheduler != NULL);
-		return((MeldInterpretScheduler*)scheduler);
+		return((MeldInterpretScheduler*)Scheduler::getScheduler());
 	}
 
 	void printInfo() {
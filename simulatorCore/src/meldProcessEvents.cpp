@@ -31,7 +31,7 @@ VMSetIdEvent::~VMSetIdEvent() {
 
 void VMSetIdEvent::consume() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMSetIdEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMSetIdEvent(this)));
 }
 
 const string VMSetIdEvent::getEventName() {
@@ -59,8 +59,8 @@ VMStopEvent::~VMStopEvent() {
 
 void VMStopEvent::consume() {
 	EVENT_CONSUME_INFO();
-	//concernedBlock->scheduleLocalEvent(EventPtr(new VMStopEvent(this)));
-	concernedBlock->blockCode->processLocalEvent(EventPtr(new VMStopEvent(this)));
+	//concernedBlock->scheduleLocalEvent(makeEventPtr(new VMStopEvent(this)));
+	concernedBlock->blockCode->processLocalEvent(makeEventPtr(new VMStopEvent(this)));
 }
 
 const string VMStopEvent::getEventName() {
@@ -95,7 +95,7 @@ VMSendMessageEvent::~VMSendMessageEvent() {
 
 void VMSendMessageEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMSendMessageEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMSendMessageEvent(this)));
 }
 
 const string VMSendMessageEvent::getEventName() {
@@ -125,7 +125,7 @@ VMHandleDebugCommandEvent::~VMHandleDebugCommandEvent() {
 
 void VMHandleDebugCommandEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMHandleDebugCommandEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMHandleDebugCommandEvent(this)));
 }
 
 const string VMHandleDebugCommandEvent::getEventName() {
@@ -184,7 +184,7 @@ VMEndPollEvent::~VMEndPollEvent() {
 
 void VMEndPollEvent::consumeBlockEvent() {
 	EVENT_CONSUME_INFO();
-	concernedBlock->scheduleLocalEvent(EventPtr(new VMEndPollEvent(this)));
+	concernedBlock->scheduleLocalEvent(makeEventPtr(new VMEndPollEvent(this)));
 	return;
 }
 
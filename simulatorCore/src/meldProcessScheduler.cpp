@@ -27,6 +27,11 @@ MeldProcessScheduler::MeldProcessScheduler() {
 	OUTPUT << "MeldProcessScheduler constructor" << endl;
 	state = NOTREADY;
 	schedulerMode = SCHEDULER_MODE_REALTIME;
+	// Deterministic ordering of simultaneous events relies on multimap insertion hints
+	setEventQueue(SCHEDULER_QUEUE_MAP);
+	// Events are processed one at a time, VMs may schedule simultaneous events that have to be processed first
+	batchDispatch = false;
+	externalPollPeriod = MELDPROCESS_POLL_PERIOD;
 	schedulerThread = new thread(bind(&MeldProcessScheduler::startPaused, this));
 }
 
@@ -35,11 +40,11 @@ MeldProcessScheduler::~MeldProcessScheduler() {
 }
 
 void MeldProcessScheduler::createScheduler() {
-	scheduler = new MeldProcessScheduler();
+	new MeldProcessScheduler();
 }
 
 void MeldProcessScheduler::deleteScheduler() {
-	delete((MeldProcessScheduler*)scheduler);
+	delete((MeldProcessScheduler*)getScheduler());
 }
 
 
@@ -57,12 +62,10 @@ void MeldProcessScheduler::SemWaitOrReadDebugMessage() {
 }
 
 void *MeldProcessScheduler::startPaused(/*void *param*/) {
+	context->bind();
 
-	Time systemCurrentTime, systemCurrentTimeMax, pausedTime;
-	pausedTime = 0;
 	int seed = 500;
 	srand (seed);
-	bool hasProcessed = false;
 	
 	// 1) world ready
 	// 2) user start order
@@ -82,150 +85,81 @@ void *MeldProcessScheduler::startPaused(/*void *param*/) {
 	sem_schedulerStart->wait();
 	schedulerMode = SCHEDULER_MODE_FASTEST;
 #endif
-	state = RUNNING;
-	checkForReceivedVMCommands();
-	Time systemStartTime, systemStopTime;
-	multimap<Time, EventPtr>::iterator first, tmp;
-	EventPtr pev;
-	systemStartTime = (glutGet(GLUT_ELAPSED_TIME))*1000;
-	OUTPUT << "\033[1;33m" << "Scheduler : start order received " << systemStartTime << "\033[0m" << endl;
-	switch (schedulerMode) {
-	case SCHEDULER_MODE_FASTEST:
-		OUTPUT << "fastest mode scheduler\n" << endl;
+	if (schedulerMode == SCHEDULER_MODE_FASTEST) {
 		MeldProcessDebugger::print("Simulation starts in deterministic mode");
-		while (state != ENDED) {
-            do {
-				while (!eventsMap.empty()) {
-					hasProcessed = true;
-					do {
-						// lock();
-						first = eventsMap.begin();		
-						pev = (*first).second;
-						if (pev->date == now()) {
-							break;
-						}
-						if (MeldProcessVM::dateHasBeenReachedByAll(pev->date)) {
-							break;
-						}
-						unlock();
-						waitForOneVMCommand();
-					} while (true);
-					currentDate = pev->date;
-					pev->consume();
-					eventsMap.erase(first);
-					eventsMapSize--;
-					// unlock();
-					if (state == PAUSED) {
-						if (MeldProcessVM::isInDebuggingMode()) {
-							getDebugger()->handleBreakAtTimeReached(currentDate);
-						} else {
-							sem_schedulerStart->wait();
-						}
-						setState(RUNNING);
-					}
-					checkForReceivedVMCommands();
-				}
-				checkForReceivedVMCommands();
-			} while (!MeldProcessVM::equilibrium() || !eventsMap.empty());
-         
-			if(hasProcessed) {
-				hasProcessed = false;
-				ostringstream s;
-				s << "Equilibrium reached at "<< now() << "us ...";
-				MeldProcessDebugger::print(s.str(), false);
-				/*if (getSimulator()->testMode) {
-				  BlinkyBlocks::getWorld()->dump();
-				  stop(0);
-				  return 0;
-				  }*/
-				if (MeldProcessVM::isInDebuggingMode()) {
-					getDebugger()->handlePauseRequest();
-				}
-			}
-			checkForReceivedVMCommands();
-			std::chrono::milliseconds timespan(5);
-			std::this_thread::sleep_for(timespan);							
-		}
+	} else {
+		MeldProcessDebugger::print("Simulation starts in real time mode");
+	}
+	run();
+
 #ifdef TEST_DETER
-		getWorld()->killAllVMs();
-		exit(0);
+	getWorld()->killAllVMs();
+	exit(0);
 #endif
-		break;
-	case SCHEDULER_MODE_REALTIME:
-		OUTPUT << "Realtime mode scheduler\n" << endl;
-		MeldProcessDebugger::print("Simulation starts in real time mode");
-		while (state != ENDED) {
-			systemCurrentTime = ((Time)glutGet(GLUT_ELAPSED_TIME))*1000 - pausedTime;
-			systemCurrentTimeMax = systemCurrentTime - systemStartTime;
-			currentDate = systemCurrentTimeMax;
-			checkForReceivedVMCommands();
-			while (true) {
-				// Lock from here, to be sure that the element
-				// is not destroyed in antother thread
-				// (previously the graphic interface was doing
-				// it).
-				lock();
-				if (eventsMap.empty()) {
-					unlock();
-					break;
-				}
-				first=eventsMap.begin();
-				pev = (*first).second;
-				if(pev->date > systemCurrentTimeMax) { 
-					unlock();
-					break;
-				}
-				currentDate = pev->date;
-				pev->consume();
-				eventsMap.erase(first);
-				eventsMapSize--;
-				unlock();
-				//cout << "check to send" << endl;
-				checkForReceivedVMCommands();
-				//cout << "ok" << endl;
-			}
-			if (state == PAUSED) {
-				cout << "paused" << endl;
-            	int pauseBeginning = ((Time)glutGet(GLUT_ELAPSED_TIME))*1000;
-				SemWaitOrReadDebugMessage();
-				setState(RUNNING);
-				pausedTime += ((Time)glutGet(GLUT_ELAPSED_TIME))*1000 - pauseBeginning;
-			}
 
-			std::chrono::milliseconds timespan(5);
-			std::this_thread::sleep_for(timespan);			
+	return(NULL);
+}
+
+void MeldProcessScheduler::pollExternal() {
+	// VMs timestamp their commands with the current date, which follows the wall clock in realtime mode
+	if (schedulerMode == SCHEDULER_MODE_REALTIME) {
+		currentDate = max(currentDate, realtimeDate());
+	}
+	checkForReceivedVMCommands();
+}
+
+void MeldProcessScheduler::waitForDispatch() {
+	if (schedulerMode != SCHEDULER_MODE_FASTEST) return;
+
+	// The next event can only be processed once every VM has reached its date
+	do {
+		Time date = eventsQueue->top()->date;
+		if (date == now() || MeldProcessVM::dateHasBeenReachedByAll(date)) {
+			break;
 		}
-		break;
-	default:
-		OUTPUT << "ERROR : Scheduler mode not recognized !!" << endl;
+		waitForOneVMCommand();
+	} while (true);
+	hasProcessed = true;
+}
+
+bool MeldProcessScheduler::idle() {
+	// VMs can send commands at any time, the scheduler only stops when the simulation ends
+	checkForReceivedVMCommands();
+	if (!MeldProcessVM::equilibrium() || !eventsQueue->empty()) {
+		return true;
 	}
-	systemStopTime = ((Time)glutGet(GLUT_ELAPSED_TIME))*1000;
-	OUTPUT << "\033[1;33m" << "Scheduler end : " << systemStopTime << "\033[0m" << endl;
-	pev.reset();
-	OUTPUT << "end time : " << currentDate << endl;
-	OUTPUT << "real time elapsed : " << ((double)(systemStopTime-systemStartTime))/1000000 << endl;
-	//	OUTPUT << "Nombre d'événements restants en mémoire : " << Evenement::nbEvenements << endl;
-	//	OUTPUT << "Nombre de messages restants en mémoire : " << Message::nbMessages << endl;
-	OUTPUT << "Maximum sized reached by the events list : " << largestEventsMapSize << endl;
-	OUTPUT << "Size of the events list at the end : " << eventsMap.size() << endl;
-	OUTPUT << "Number of events processed : " << Event::getNextId() << endl;
-	OUTPUT << "Events(s) left in memory before destroying Scheduler : " << Event::getNbLivingEvents() << endl;
-	OUTPUT << "Message(s) left in memory before destroying Scheduler : " << Message::getNbMessages() << endl;
 
-	// if autoStop is enabled, terminate simulation
-	if (willAutoStop())
-		glutLeaveMainLoop();
+	if (hasProcessed) {
+		hasProcessed = false;
+		ostringstream s;
+		s << "Equilibrium reached at "<< now() << "us ...";
+		MeldProcessDebugger::print(s.str(), false);
+		if (MeldProcessVM::isInDebuggingMode()) {
+			getDebugger()->handlePauseRequest();
+		}
+	}
+	std::chrono::milliseconds timespan(5);
+	std::this_thread::sleep_for(timespan);
+	return true;
+}
 
-	return(NULL);
+void MeldProcessScheduler::waitWhilePaused() {
+	if (schedulerMode == SCHEDULER_MODE_REALTIME) {
+		cout << "paused" << endl;
+		SemWaitOrReadDebugMessage();
+	} else if (MeldProcessVM::isInDebuggingMode()) {
+		getDebugger()->handleBreakAtTimeReached(currentDate);
+	} else {
+		sem_schedulerStart->wait();
+	}
 }
 
 void MeldProcessScheduler::start(int mode) {
 	static bool done = false;
 	if ((state == NOTSTARTED) && !done) {
 		done = true;
-		MeldProcessScheduler* sbs = (MeldProcessScheduler*)scheduler;
-		sbs->schedulerMode = mode;
-		sbs->sem_schedulerStart->signal();
+		schedulerMode = mode;
+		sem_schedulerStart->signal();
 	}
 }
 
@@ -234,9 +168,8 @@ void MeldProcessScheduler::pause(Time date) {
 }
 
 void MeldProcessScheduler::unPause() {
-	MeldProcessScheduler* sbs = (MeldProcessScheduler*)scheduler;
 	if (state != RUNNING) {
-		sbs->sem_schedulerStart->signal();
+		sem_schedulerStart->signal();
 	}
 	OUTPUT << "unpause sim" << endl;
 }
@@ -247,13 +180,13 @@ void MeldProcessScheduler::stop(Time date){
 	setState(ENDED);
 }
 
-bool MeldProcessScheduler::schedule(Event *ev) {
-	assert(ev != NULL);
+bool MeldProcessScheduler::scheduleEvent(EventPtr pev) {
 	stringstream info;
 
-	EventPtr pev(ev);
+	BaseSimulator::MultimapEventQueue *queue = getMultimapQueue();
+	const multimap<Time, EventPtr> &eventsMap = queue->getMap();
 
-	OUTPUT << "MeldProcessScheduler: Schedule a " << pev->getEventName() << " (" << ev->id << ")" << endl;
+	OUTPUT << "MeldProcessScheduler: Schedule a " << pev->getEventName() << " (" << pev->id << ")" << endl;
 
 	// (pev->date > maximumDate) condition was removed because
 	// Blinky Block system never ends.
@@ -265,12 +198,12 @@ bool MeldProcessScheduler::schedule(Event *ev) {
 	
 	switch (schedulerMode) {
 	case SCHEDULER_MODE_REALTIME:
-		eventsMap.insert(pair<Time, EventPtr>(pev->date,pev));
+		queue->push(pev);
 		break;
 	case SCHEDULER_MODE_FASTEST:
 		if (eventsMap.count(pev->date) > 0) {
-			std::pair<multimap<Time, EventPtr>::iterator,multimap<Time, EventPtr>::iterator> range = eventsMap.equal_range(pev->date);
-			multimap<Time, EventPtr>::iterator it = range.first;
+			std::pair<multimap<Time, EventPtr>::const_iterator,multimap<Time, EventPtr>::const_iterator> range = eventsMap.equal_range(pev->date);
+			multimap<Time, EventPtr>::const_iterator it = range.first;
 			while (it != range.second) {
 				if (it->second->randomNumber == 0) {
 					it++;
@@ -280,7 +213,7 @@ bool MeldProcessScheduler::schedule(Event *ev) {
 					break;
 				}
 				if (it->second->randomNumber == pev->randomNumber) {
-					while (it->second->randomNumber == pev->randomNumber) {
+					while (it != range.second && it->second->randomNumber == pev->randomNumber) {
 						if (it->second->getConcernedBlock()->blockId > pev->getConcernedBlock()->blockId) {
 							break;
 						}
@@ -290,9 +223,9 @@ bool MeldProcessScheduler::schedule(Event *ev) {
 				}
 				it++;
 			}
-			eventsMap.insert(it, pair<Time, EventPtr>(pev->date,pev));
+			queue->pushBefore(it, pev);
 		} else {
-			eventsMap.insert(pair<Time, EventPtr>(pev->date,pev));	
+			queue->push(pev);
 		}
 		break;
 	default:
@@ -304,7 +237,7 @@ bool MeldProcessScheduler::schedule(Event *ev) {
 
 	if (largestEventsMapSize < eventsMapSize) largestEventsMapSize = eventsMapSize;
 
-	return(true);
+	return true;
 }
 
 } // MeldProcess namespace
@@ -15,6 +15,8 @@
 #include "network.h"
 #include "trace.h"
 
+#define MELDPROCESS_POLL_PERIOD 5000 //!< Maximum delay (us) between two checks for VM commands while waiting in realtime mode
+
 namespace MeldProcess {
 
 class MeldProcessScheduler : public BaseSimulator::Scheduler {
@@ -22,13 +24,24 @@ class MeldProcessScheduler : public BaseSimulator::Scheduler {
 	MeldProcessScheduler();
 	virtual ~MeldProcessScheduler();
 	void* startPaused(/*void *param */);
+	bool hasProcessed = false; //!< True if events have been processed since the last equilibrium
+
+	//!< @brief Processes the commands received from the VMs
+	void pollExternal();
+	//!< @brief In fastest mode, waits until all VMs have reached the date of the next event
+	void waitForDispatch();
+	//!< @brief Processes the commands received from the VMs, and reports equilibriums. Never stops the scheduler
+	bool idle();
+	//!< @brief Waits for the debugger, or for a new start order
+	void waitWhilePaused();
+	//!< @brief Event queue, a multimap in which simultaneous events are ordered by hand in MeldProcessScheduler::scheduleEvent
+	BaseSimulator::MultimapEventQueue *getMultimapQueue() { return static_cast<BaseSimulator::MultimapEventQueue*>(eventsQueue); }
 	
 public:	
 	static void createScheduler();
 	static void deleteScheduler();
 	static MeldProcessScheduler* getScheduler() {
-		assert(scheduler != NULL);
-		return((MeldProcessScheduler*)scheduler);
+		return((MeldProcessScheduler*)Scheduler::getScheduler());
 	}
 
 	void printInfo() {
@@ -55,7 +68,8 @@ class MeldProcessScheduler : public BaseSimulator::Scheduler {
 		return !r;
 	}
 	
-	bool schedule(Event *ev);
+	//!< @brief In fastest mode, simultaneous events are ordered by random number, then by block identifier
+	bool scheduleEvent(EventPtr pev);
 	
 	void SemWaitOrReadDebugMessage();
 	
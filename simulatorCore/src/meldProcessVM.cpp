@@ -61,7 +61,7 @@ MeldProcessVM::MeldProcessVM(BuildingBlock* bb){
 		acceptor->close();
 		closeAllSockets();
 #ifdef LOGFILE
-		log_file.close();
+		getLogFile().close();
 #endif
 		int fd = open(vmLogFile.str().c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
 		dup2(fd, 1);
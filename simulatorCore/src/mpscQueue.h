@@ -0,0 +1,82 @@
+/*! @file mpscQueue.h
+ * @brief Lock-free multiple producers / single consumer queue
+ *  Used by the Scheduler to receive events from other threads (GUI) when it runs in single-producer mode
+ * @date 17/10/2026
+ */
+
+#ifndef MPSCQUEUE_H_
+#define MPSCQUEUE_H_
+
+#include <atomic>
+
+namespace BaseSimulator {
+
+/**
+ * @brief Unbounded lock-free multiple producers / single consumer queue
+ *  Producers push onto an intrusive stack with a compare-and-swap. The consumer detaches the whole stack with a
+ *  single exchange, and reverses it so that elements are consumed in push order.
+ */
+template <typename T>
+class MPSCQueue {
+	struct Node {
+		T value;
+		Node *next;
+		Node(const T &v) : value(v), next(NULL) {};
+	};
+
+	std::atomic<Node*> head{NULL}; //!< Last pushed node
+
+	MPSCQueue(MPSCQueue const&); //<! Disable copy constructor
+	void operator=(MPSCQueue const&); //<! Disable assignment operator
+public:
+	MPSCQueue() {};
+	~MPSCQueue() {
+		Node *n = head.exchange(NULL);
+		while (n) {
+			Node *next = n->next;
+			delete n;
+			n = next;
+		}
+	};
+
+	//!< @brief Adds v to the queue. Can be called from any thread
+	void push(const T &v) {
+		Node *n = new Node(v);
+		n->next = head.load(std::memory_order_relaxed);
+		while (!head.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed));
+	};
+
+	//!< @brief Returns true if no element is waiting. Cheap enough to be polled by the consumer on every iteration
+	inline bool empty() const { return head.load(std::memory_order_relaxed) == NULL; };
+
+	/**
+	 * @brief Removes all the waiting elements and moves them to f, in push order. Consumer thread only.
+	 * @return number of elements consumed
+	 */
+	template <typename F>
+	size_t consumeAll(F f) {
+		Node *n = head.exchange(NULL, std::memory_order_acquire);
+		// Reverse the stack to restore push order
+		Node *fifo = NULL;
+		while (n) {
+			Node *next = n->next;
+			n->next = fifo;
+			fifo = n;
+			n = next;
+		}
+
+		size_t count = 0;
+		while (fifo) {
+			Node *next = fifo->next;
+			f(std::move(fifo->value));
+			delete fifo;
+			fifo = next;
+			count++;
+		}
+		return count;
+	};
+};
+
+} // BaseSimulator namespace
+
+#endif /* MPSCQUEUE_H_ */
@@ -25,7 +25,7 @@ MultiRobotsSimulator::~MultiRobotsSimulator() {
 }
 
 void MultiRobotsSimulator::createSimulator(int argc, char *argv[], BlockCodeBuilder bcb) {
-	simulator =  new MultiRobotsSimulator(argc, argv, bcb);
+	Simulator *simulator = new MultiRobotsSimulator(argc, argv, bcb);
 	simulator->parseConfiguration(argc, argv);
 	simulator->startSimulation();
 }
@@ -34,7 +34,7 @@ void MultiRobotsSimulator::loadWorld(const Cell3DPosition &gridSize, const Vecto
                                      int argc, char *argv[]) {
 	world = new MultiRobotsWorld(gridSize, gridScale, argc,argv);
 
-	if (GlutContext::GUIisEnabled)
+	if (GlutContext::isGUIEnabled())
 		world->loadTextures("../../simulatorCore/resources/textures/latticeTextures");
 
 	World::setWorld(world);
@@ -28,8 +28,7 @@ class MultiRobotsSimulator : public BaseSimulator::Simulator {
     static void createSimulator(int argc, char *argv[], BlockCodeBuilder bcb);   
 
     static MultiRobotsSimulator* getSimulator() {
-	assert(simulator != NULL);
-	return((MultiRobotsSimulator*)simulator);
+	return((MultiRobotsSimulator*)Simulator::getSimulator());
     }
 
     virtual void loadWorld(const Cell3DPosition &gridSize, const Vector3D &gridScale,
@@ -19,8 +19,10 @@
 #include "configExporter.h"
 #include "trace.h"
 #include "vector3D.h"
+#include "statsIndividual.h"
 
 using namespace std;
+using namespace BaseSimulator::utils;
 
 namespace MultiRobots {
 
@@ -28,7 +30,7 @@ MultiRobotsWorld::MultiRobotsWorld(const Cell3DPosition &gridSize, const Vector3
 									 int argc, char *argv[]):World(argc, argv) {
 	OUTPUT << "\033[1;31mMultiRobotsWorld constructor\033[0m" << endl;
 
-	if (GlutContext::GUIisEnabled) {
+	if (GlutContext::isGUIEnabled()) {
 		objObstacle = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/multiRobotsTextures","multiRobotSimple.obj");		
 
 		objBlock = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/multiRobotsTextures",
@@ -48,7 +50,7 @@ MultiRobotsWorld::~MultiRobotsWorld() {
 }
 
 void MultiRobotsWorld::deleteWorld() {
-	delete((MultiRobotsWorld*)world);
+	World::deleteWorld();
 }
 
 void MultiRobotsWorld::addBlock(bID blockId, BlockCodeBuilder bcb,
@@ -83,6 +85,28 @@ void MultiRobotsWorld::linkBlock(const Cell3DPosition &pos) {
     // Linked by lattice
 }
 
+void MultiRobotsWorld::glDrawEventHeatmap() {
+	uint64_t maxEvents = 1;
+	for (GlBlock *glb : tabGlBlocks) {
+		BuildingBlock *bb = getBlockById(glb->blockId);
+		if (bb && bb->stats) maxEvents = max(maxEvents, bb->stats->getEventCount());
+	}
+
+	for (GlBlock *glb : tabGlBlocks) {
+		BuildingBlock *bb = getBlockById(glb->blockId);
+		float heat = (bb && bb->stats) ? (float)bb->stats->getEventCount() / maxEvents : 0.0f;
+
+		// From blue (idle) to green then red (busiest module), drawn in place of the module color
+		GLfloat color[4];
+		memcpy(color, glb->color, sizeof(color));
+		glb->color[0] = heat < 0.5f ? 0.0f : 2.0f * heat - 1.0f;
+		glb->color[1] = heat < 0.5f ? 2.0f * heat : 2.0f - 2.0f * heat;
+		glb->color[2] = heat < 0.5f ? 1.0f - 2.0f * heat : 0.0f;
+		((MultiRobotsGlBlock*)glb)->glDraw(objBlock);
+		memcpy(glb->color, color, sizeof(color));
+	}
+}
+
 void MultiRobotsWorld::glDraw() {
 	static const GLfloat white[]={0.8f,0.8f,0.8f,1.0f},
 		gray[]={0.2f,0.2f,0.2f,1.0},
@@ -96,9 +120,13 @@ void MultiRobotsWorld::glDraw() {
 		vector <GlObstacle*>::iterator icObs=tabGlObstacles.begin();
 		Vector3D position, position2;
 		lock();
-		while (ic!=tabGlBlocks.end()) {
-			((MultiRobotsGlBlock*)(*ic))->glDraw(objBlock);
-			ic++;
+		if (GlutContext::showEventHeatmap && StatsIndividual::isEnabled()) {
+			glDrawEventHeatmap();
+		} else {
+			while (ic!=tabGlBlocks.end()) {
+				((MultiRobotsGlBlock*)(*ic))->glDraw(objBlock);
+				ic++;
+			}
 		}
 		unlock();
 
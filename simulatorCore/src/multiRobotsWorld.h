@@ -31,8 +31,7 @@ class MultiRobotsWorld : public BaseSimulator::World {
 
     static void deleteWorld();
     static MultiRobotsWorld* getWorld() {
-        assert(world != NULL);
-        return((MultiRobotsWorld*)world);
+        return((MultiRobotsWorld*)World::getWorld());
     }
     void printInfo() {
         OUTPUT << "I'm a MultiRobotsWorld" << endl;
@@ -49,6 +48,11 @@ class MultiRobotsWorld : public BaseSimulator::World {
     virtual void loadTextures(const string &str);
 
     virtual void glDraw();
+    /**
+     * @brief Draws the modules colored by number of processed events, from blue (fewest) to red (most), to spot the
+     *  hotspots of the simulation. Enabled with key 'e', requires per module statistics (-i)
+     */
+    void glDrawEventHeatmap();
     virtual void glDrawId();
     virtual void glDrawIdByMaterial();
     virtual void setSelectedFace(int n);
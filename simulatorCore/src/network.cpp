@@ -16,9 +16,9 @@
 #include "statsIndividual.h"
 #include "utils.h"
 #include "world.h"
+#include "checkpoint.h"
 
-#define SHADOWING_EXPONENT 2
-#define SHADOWING_DEVIATION 4
+#define WIRELESS_SEED_MASK 0x5bd1e995 //!< Distinguishes the seed of the interface generator from the one of the block
 
 using namespace std;
 using namespace BaseSimulator;
@@ -26,14 +26,8 @@ using namespace BaseSimulator::utils;
 
 //unsigned int Message::nextId = 0;
 //unsigned int Message::nbMessages = 0;
-uint64_t Message::nextId = 0;
-uint64_t Message::nbMessages = 0;
-uint64_t WirelessMessage::nextId = 0;
-uint64_t WirelessMessage::nbMessages = 0;
 
 
-unsigned int NetworkInterface::nextId = 0;
-int NetworkInterface::defaultDataRate = 1000000;
 //unsigned int P2PNetworkInterface::nextId = 0;
 //int P2PNetworkInterface::defaultDataRate = 1000000;
 //unsigned int WirelessNetworkInterface::nextId = 0;
@@ -47,19 +41,21 @@ int NetworkInterface::defaultDataRate = 1000000;
 //===========================================================================================================
 
 Message::Message() {
-	id = nextId;
-	nextId++;
-	nbMessages++;
+	SimulationContext &context = SimulationContext::current();
+	id = context.nextMessageId++;
+	context.nbMessages++;
+	// Set when the message is sent
+	sourceInterface = destinationInterface = NULL;
 	MESSAGE_CONSTRUCTOR_INFO();
 }
 
 Message::~Message() {
 	MESSAGE_DESTRUCTOR_INFO();
-	nbMessages--;
+	SimulationContext::current().nbMessages--;
 }
 
 uint64_t Message::getNbMessages() {
-	return(nbMessages);
+	return(SimulationContext::current().nbMessages);
 }
 
 string Message::getMessageName() {
@@ -81,20 +77,22 @@ Message* Message::clone() {
 //===========================================================================================================
 
 WirelessMessage::WirelessMessage(bID destId) {
-    id = nextId;
+    SimulationContext &context = SimulationContext::current();
+    id = context.nextWirelessMessageId++;
     destinationId = destId;
-    nextId++;
-    nbMessages++;
+    sourceInterface = NULL;
+    sequenceNumber = 0;
+    context.nbWirelessMessages++;
     MESSAGE_CONSTRUCTOR_INFO();
 }
 
 WirelessMessage::~WirelessMessage() {
     MESSAGE_DESTRUCTOR_INFO();
-    nbMessages--;
+    SimulationContext::current().nbWirelessMessages--;
 }
 
 uint64_t WirelessMessage::getNbMessages() {
-    return(nbMessages);
+    return(SimulationContext::current().nbWirelessMessages);
 }
 
 string WirelessMessage::getMessageName() {
@@ -105,6 +103,7 @@ WirelessMessage* WirelessMessage::clone() {
     WirelessMessage* ptr = new WirelessMessage(destinationId);
     ptr->sourceInterface = sourceInterface;
     ptr->type = type;
+    ptr->sequenceNumber = sequenceNumber;
     return ptr;
 }
 
@@ -116,13 +115,22 @@ WirelessMessage* WirelessMessage::clone() {
 NetworkInterface::NetworkInterface(BaseSimulator::BuildingBlock *b){
 	hostBlock = b;
 	availabilityDate=0;
-	globalId=nextId;
-	nextId++;
+	globalId=SimulationContext::current().nextInterfaceId++;
 }
 
 NetworkInterface::~NetworkInterface() {
 }
 
+void NetworkInterface::saveState(StateSnapshot &s) {
+	s.save(availabilityDate);
+	// dataRate is saved when drawn
+}
+
+void NetworkInterface::checkpoint(CheckpointArchive &a) {
+	a & availabilityDate;
+	if (dataRate) dataRate->checkpoint(a);
+}
+
 //===========================================================================================================
 //
 //          P2PNetworkInterface  (class)
@@ -133,7 +141,7 @@ P2PNetworkInterface::P2PNetworkInterface(BaseSimulator::BuildingBlock *b) : Netw
 #ifndef NDEBUG
 	OUTPUT << "P2PNetworkInterface constructor" << endl;
 #endif
-    dataRate = new StaticRate(defaultDataRate);
+    dataRate = new StaticRate(getDefaultDataRate());
     connectedInterface = NULL;
 }
 
@@ -158,6 +166,7 @@ bool P2PNetworkInterface::addToOutgoingBuffer(MessagePtr msg) {
 	stringstream info;
 
 	if (connectedInterface != NULL) {
+		hostBlock->willModify(outgoingQueue);
 		outgoingQueue.push_back(msg);
 		BaseSimulator::utils::StatsIndividual::incOutgoingMessageQueueSize(hostBlock->stats);
 		if (availabilityDate < BaseSimulator::getScheduler()->now()) availabilityDate = BaseSimulator::getScheduler()->now();
@@ -190,6 +199,7 @@ void P2PNetworkInterface::send() {
 		exit(EXIT_FAILURE);
 	}
 
+	hostBlock->willModify(outgoingQueue);
 	msg = outgoingQueue.front();
 	outgoingQueue.pop_front();
 
@@ -204,6 +214,8 @@ void P2PNetworkInterface::send() {
 /*	info << "*** sending (interface " << localId << " of block " << hostBlock->blockId << ")";
 	getScheduler()->trace(info.str());*/
 
+	// Delivery is scheduled first, so that the message is received before the next transmission starts
+	BaseSimulator::getScheduler()->schedule(new NetworkInterfaceDeliverEvent(BaseSimulator::getScheduler()->now()+transmissionDuration, connectedInterface, msg));
 	BaseSimulator::getScheduler()->schedule(new NetworkInterfaceStopTransmittingEvent(BaseSimulator::getScheduler()->now()+transmissionDuration, this));
 	
 	StatsCollector::getInstance().incMsgCount();
@@ -233,16 +245,34 @@ void P2PNetworkInterface::connect(P2PNetworkInterface *ni) {
 }
 
 Time P2PNetworkInterface::getTransmissionDuration(MessagePtr &m) {
+  if (hostBlock->undoLog) dataRate->saveState(*hostBlock->undoLog);
   double rate = dataRate->get();
   Time transmissionDuration = (m->size()*8000000ULL)/rate;
   //cerr << "TransmissionDuration: " << transmissionDuration << endl;
   return transmissionDuration;
 }
 
+Time P2PNetworkInterface::getMinTransmissionDuration(unsigned int size) {
+  double rate = dataRate->getMax();
+  if (std::isinf(rate)) return 0;
+  return (size*8000000ULL)/rate;
+}
+
 bool P2PNetworkInterface::isConnected() {
   return connectedInterface != NULL;
 }
 
+void P2PNetworkInterface::saveState(StateSnapshot &s) {
+  NetworkInterface::saveState(s);
+  s.save(messageBeingTransmitted);
+  // outgoingQueue is saved when modified
+}
+
+void P2PNetworkInterface::checkpoint(CheckpointArchive &a) {
+  NetworkInterface::checkpoint(a);
+  a & messageBeingTransmitted & outgoingQueue;
+}
+
 //======================================================================================================
 //
 //		WirelessNetworkInterface(class)
@@ -253,7 +283,7 @@ WirelessNetworkInterface::WirelessNetworkInterface(BaseSimulator::BuildingBlock
 #ifndef NDEBUG
     OUTPUT << "WirelessNetworkInterface constructor" << endl;
 #endif
-    dataRate = new StaticRate(defaultDataRate);
+    dataRate = new StaticRate(getDefaultDataRate());
     // arbitrary values, please adjust to fit your simulated radio equipment
     transmitPower = power;
     receptionThreshold = threshold; 
@@ -261,8 +291,6 @@ WirelessNetworkInterface::WirelessNetworkInterface(BaseSimulator::BuildingBlock
     collisionOccuring = false;
     transmitting = false;
     receiving = false;
-    channelAvailability = true;
-    first = true;
 }
 
 WirelessNetworkInterface::~WirelessNetworkInterface(){
@@ -279,12 +307,49 @@ float WirelessNetworkInterface::getReceptionThreshold() {
     return(receptionThreshold);
 }
 
+void WirelessNetworkInterface::saveState(StateSnapshot &s) {
+    NetworkInterface::saveState(s);
+    s.save(collisionOccuring);
+    s.save(transmitting);
+    s.save(receiving);
+    s.save(messageBeingReceived);
+    s.save(messageBeingTransmitted);
+    // outgoingQueue, generator and lastSequenceNumbers are saved when modified
+    s.save(nbSensed);
+    s.save(channelBusy);
+    s.save(busySince);
+    s.save(backoffSlots);
+    s.save(countingDown);
+    s.save(countdownStart);
+    s.save(nbRetries);
+    s.save(macVersion);
+    s.save(messageAwaitingAck);
+    s.save(nextSequenceNumber);
+}
+
+void WirelessNetworkInterface::checkpoint(CheckpointArchive &a) {
+    NetworkInterface::checkpoint(a);
+    a & transmitPower & receptionThreshold & collisionOccuring & transmitting & receiving
+      & messageBeingReceived & messageBeingTransmitted & outgoingQueue & generator;
+    a & nbSensed & channelBusy & busySince & backoffSlots & countingDown & countdownStart & nbRetries & macVersion
+      & messageAwaitingAck & nextSequenceNumber & lastSequenceNumbers;
+    if (a.isLoading()) invalidateLinks();
+}
+
+BaseSimulator::uintRNG& WirelessNetworkInterface::getGenerator() {
+    hostBlock->willModify(generator);
+    return generator;
+}
+
+void WirelessNetworkInterface::reseed(ruint seed) {
+    generator = uintRNG(seed ^ WIRELESS_SEED_MASK);
+}
+
 // Effectively start the transmission
-// Do not call this function directly, it is called automatically when the previous transmission in the outgoing queue terminates
+// Do not call this function directly, it is called automatically when the backoff of the message at the head of the outgoing queue expires
 void WirelessNetworkInterface::send(){
     WirelessMessagePtr msg;
     stringstream info;
-    Time transmissionDuration;
     
     if (outgoingQueue.size()==0) {
         info << "*** ERROR *** [block " << hostBlock->blockId << ",wireless interface " << globalId <<"] : The outgoing buffer of this interface should not be empty !";
@@ -292,10 +357,14 @@ void WirelessNetworkInterface::send(){
         exit(EXIT_FAILURE);
     }
     
+    hostBlock->willModify(outgoingQueue);
     msg = outgoingQueue.front();
     outgoingQueue.pop_front();
+    transmit(msg);
+}
 
-    transmissionDuration = getTransmissionDuration(msg);
+void WirelessNetworkInterface::transmit(WirelessMessagePtr msg) {
+    Time transmissionDuration = getTransmissionDuration(msg);
     messageBeingTransmitted = msg;
     messageBeingTransmitted->sourceInterface = this;
     
@@ -305,37 +374,149 @@ void WirelessNetworkInterface::send(){
     /*	info << "*** sending (interface " << localId << " of block " << hostBlock->blockId << ")";
      getScheduler()->trace(info.str());*/
     transmitting = true;
+    updateChannelState();
     BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceStopTransmittingEvent(BaseSimulator::getScheduler()->now()+transmissionDuration, this));
 }
 
+void WirelessNetworkInterface::stopTransmit() {
+    WirelessMessagePtr msg = messageBeingTransmitted;
+    Time now = BaseSimulator::getScheduler()->now();
+    const WirelessMacParameters &mac = getMacParameters();
+
+    messageBeingTransmitted.reset();
+    availabilityDate = now;
+    transmitting = false;
+    updateChannelState();
+    if (msg->type == WIRELESS_MAC_ACK) return;
+
+    if (mac.ack && msg->destinationId != WIRELESS_BROADCAST_ID) {
+        // The acknowledgment is sent after sifs, and must be received within a slot of its end
+        messageAwaitingAck = msg;
+        Time timeout = now + mac.sifs + getTransmissionDuration(WIRELESS_MAC_ACK_SIZE) + mac.slotTime
+            + 2 * getPropagationDelay();
+        BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceAckTimeoutEvent(timeout, this, ++macVersion));
+    } else {
+        endOfExchange();
+    }
+}
+
+unsigned int WirelessNetworkInterface::getContentionWindow() {
+    const WirelessMacParameters &mac = getMacParameters();
+    // Doubled from cwMin + 1 slots at every retransmission, without overflowing the shift
+    if (nbRetries >= 32) return mac.cwMax;
+    uint64_t cw = ((uint64_t)mac.cwMin + 1) << nbRetries;
+    return (unsigned int)min(cw - 1, (uint64_t)mac.cwMax);
+}
+
+void WirelessNetworkInterface::startContention(Time date) {
+    std::uniform_int_distribution<int> distribution(0, getContentionWindow());
+    backoffSlots = distribution(getGenerator());
+    countingDown = false;
+    if (!channelBusy) resumeCountdown(date);
+}
+
+void WirelessNetworkInterface::resumeCountdown(Time date) {
+    const WirelessMacParameters &mac = getMacParameters();
+    countdownStart = date;
+    countingDown = true;
+    BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceChannelListeningEvent(date + mac.difs + backoffSlots * mac.slotTime, this, ++macVersion));
+}
+
+void WirelessNetworkInterface::updateChannelState() {
+    bool busy = nbSensed > 0 || transmitting;
+    if (busy == channelBusy) return;
+
+    Time now = BaseSimulator::getScheduler()->now();
+    channelBusy = busy;
+    if (busy) {
+        busySince = now;
+        if (countingDown) {
+            // Freezes the backoff: the slots elapsed after the interframe space are consumed, the pending event is discarded
+            const WirelessMacParameters &mac = getMacParameters();
+            Time elapsed = now > countdownStart + mac.difs ? now - countdownStart - mac.difs : 0;
+            backoffSlots -= (int)min(elapsed / mac.slotTime, (Time)backoffSlots);
+            countingDown = false;
+            macVersion++;
+        }
+    } else {
+        StatsIndividual::addChannelBusyTime(hostBlock->stats, now - busySince);
+        if (backoffSlots >= 0) resumeCountdown(max(now, availabilityDate));
+    }
+}
+
+void WirelessNetworkInterface::endOfExchange() {
+    nbRetries = 0;
+    if (outgoingQueue.size() > 0) startContention(max(BaseSimulator::getScheduler()->now(), availabilityDate));
+}
+
+void WirelessNetworkInterface::backoffExpired(uint32_t version) {
+    if (version != macVersion || !countingDown) return;
+    countingDown = false;
+    backoffSlots = -1;
+    send();
+}
+
+void WirelessNetworkInterface::ackTimeout(uint32_t version) {
+    stringstream info;
+    if (version != macVersion || messageAwaitingAck == NULL) return;
+
+    WirelessMessagePtr msg = messageAwaitingAck;
+    messageAwaitingAck.reset();
+    if (nbRetries < getMacParameters().retryLimit) {
+        nbRetries++;
+        StatsIndividual::incMacRetryCount(hostBlock->stats);
+        info << "no acknowledgment, retransmission " << nbRetries;
+        hostBlock->willModify(outgoingQueue);
+        outgoingQueue.push_front(msg);
+        startContention(BaseSimulator::getScheduler()->now());
+    } else {
+        info << "no acknowledgment, message dropped after " << nbRetries << " retransmissions";
+        endOfExchange();
+    }
+    getScheduler()->trace(info.str());
+}
+
+void WirelessNetworkInterface::sendAck(WirelessMessagePtr ack) {
+    // A half-duplex interface cannot acknowledge while it transmits
+    if (!transmitting) transmit(ack);
+}
+
 void WirelessNetworkInterface::startReceive(WirelessMessagePtr msg) {
     stringstream info;
-    float distance;
     float receivedPower = 0;
     float snr = 0;
     float noiseFloor = -130;
-    Vector3D vec1;
-    Vector3D vec2;
+    bool sensed, detected, decodable; // above the sensitivity, above the threshold, and with a sufficient snr
     Time transmissionDuration = getTransmissionDuration(msg);
-    vec1=msg->sourceInterface->hostBlock->getPositionVector();
-    vec2=this->hostBlock->getPositionVector();
-    distance = sqrt(pow(abs(vec1.pt[0] - vec2.pt[0]),2)+pow(abs(vec1.pt[1] - vec2.pt[1]),2))*10;
-    
-    receivedPower = pathLoss(msg->sourceInterface->getTransmitPower(), distance, 1.0, 1.0, 1.0) + shadowing(SHADOWING_EXPONENT, distance, SHADOWING_DEVIATION);
-    //info << "Message received with : " << receivedPower << endl;
+    ChannelModel *channel = getChannelModel();
+
+    if (channel->getType() == ChannelModel::UNIT_DISK) {
+        // Fast path: heard and decodable within the disk, not sensed beyond it
+        sensed = detected = decodable = static_cast<UnitDiskChannelModel*>(channel)->covers(msg->sourceInterface->hostBlock->position, hostBlock->position);
+    } else {
+        receivedPower = getLinkBudget(msg->sourceInterface) + channel->getShadowing(getGenerator());
+        //info << "Message received with : " << receivedPower << endl;
+        sensed = receivedPower > receptionSensitivity;
+        if (receivedPower < receptionThreshold) noiseFloor = receivedPower;
+        snr = receivedPower - noiseFloor;
+        detected = receivedPower >= receptionThreshold;
+        decodable = detected && snr >= 15;
+    }
 
-    if (receivedPower > receptionSensitivity){
-	channelAvailability = false;
+    if (sensed){
+	nbSensed++;
+	updateChannelState();
 	BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceIdleEvent(BaseSimulator::getScheduler()->now()+transmissionDuration, this));
-	if (receivedPower < receptionThreshold) noiseFloor = receivedPower;
-	else if (receivedPower >= receptionThreshold) {
-		snr = receivedPower - noiseFloor;
+	// A half-duplex interface does not receive while it transmits
+	if (detected && !transmitting) {
 		info << "snr : "<<snr;
-		if(!this->isReceiving() && snr >= 15 && (msg->destinationId == this->hostBlock->blockId || msg->destinationId ==255)) { 
+		if(!this->isReceiving() && decodable && (msg->destinationId == this->hostBlock->blockId || msg->destinationId == WIRELESS_BROADCAST_ID)) { 
 			receiving = true;
+			messageBeingReceived = msg;
         		BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceStopReceiveEvent(BaseSimulator::getScheduler()->now()+transmissionDuration, this));
 		}
-		else if (this->isReceiving() || snr < 15){
+		else if (this->isReceiving()){
+			// Overlaps the message being received
 			collisionOccuring = true;
 		}
     	}
@@ -345,19 +526,53 @@ void WirelessNetworkInterface::startReceive(WirelessMessagePtr msg) {
 
 void WirelessNetworkInterface::stopReceive() {
     stringstream info;
+    WirelessMessagePtr msg = messageBeingReceived;
     receiving = false;
-    if (!collisionOccuring) {
-        this->hostBlock->scheduleLocalEvent(EventPtr(new WirelessNetworkInterfaceMessageReceivedEvent(BaseSimulator::getScheduler()->now(),this,messageBeingReceived)));
-    }	
-    else {
+    messageBeingReceived.reset();
+    if (collisionOccuring) {
 	collisionOccuring = false;
+	StatsIndividual::incMacCollisionCount(hostBlock->stats);
 	info << "A COLLISION HAS OCCURED!";
 	getScheduler()->trace(info.str());
+	return;
+    }
+
+    if (msg->type == WIRELESS_MAC_ACK) {
+        // Acknowledgments are handled here, and never reach the block code
+        if (messageAwaitingAck != NULL && msg->sourceInterface->hostBlock->blockId == messageAwaitingAck->destinationId) {
+            messageAwaitingAck.reset();
+            macVersion++;
+            endOfExchange();
+        }
+        return;
     }
+    const WirelessMacParameters &mac = getMacParameters();
+    if (mac.ack && msg->destinationId == hostBlock->blockId) {
+        bID source = msg->sourceInterface->hostBlock->blockId;
+        WirelessMessage *ack = new WirelessMessage(source);
+        ack->type = WIRELESS_MAC_ACK;
+        BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceSendAckEvent(BaseSimulator::getScheduler()->now() + mac.sifs, this, WirelessMessagePtr(ack)));
+        // Retransmission of a message received, whose acknowledgment was lost: acknowledged again, but delivered once
+        auto last = lastSequenceNumbers.find(source);
+        if (last != lastSequenceNumbers.end() && last->second == msg->sequenceNumber) {
+            info << "duplicate of message " << msg->sequenceNumber << " from " << source << " dropped";
+            getScheduler()->trace(info.str());
+            return;
+        }
+        hostBlock->willModify(lastSequenceNumbers);
+        lastSequenceNumbers[source] = msg->sequenceNumber;
+    }
+    this->hostBlock->scheduleLocalEvent(makeEventPtr(new WirelessNetworkInterfaceMessageReceivedEvent(BaseSimulator::getScheduler()->now(),this,msg)));
+}
+
+void WirelessNetworkInterface::stopSensing() {
+    nbSensed--;
+    updateChannelState();
 }
 
 void WirelessNetworkInterface::setTransmitPower(int power){
     this->transmitPower = power;
+    linkVersion++;
 }
 
 float WirelessNetworkInterface::getTransmitPower(){
@@ -366,40 +581,65 @@ float WirelessNetworkInterface::getTransmitPower(){
 
 
 Time WirelessNetworkInterface::getTransmissionDuration(WirelessMessagePtr &m) {
+    return getTransmissionDuration(m->size());
+}
+
+Time WirelessNetworkInterface::getTransmissionDuration(unsigned int size) {
+    if (hostBlock->undoLog) dataRate->saveState(*hostBlock->undoLog);
     double rate = dataRate->get();
-    Time transmissionDuration = (m->size()*8000000ULL)/rate;
+    Time transmissionDuration = (size*8000000ULL)/rate;
     //cerr << "TransmissionDuration: " << transmissionDuration << endl;
     return transmissionDuration;
 }
 
+Time WirelessNetworkInterface::getOngoingBusyTime() {
+    return channelBusy ? BaseSimulator::getScheduler()->now() - busySince : 0;
+}
+
 bool WirelessNetworkInterface::addToOutgoingBuffer(WirelessMessagePtr msg) {
     stringstream info;
+    msg->sequenceNumber = ++nextSequenceNumber;
+    hostBlock->willModify(outgoingQueue);
     outgoingQueue.push_back(msg);
     //BaseSimulator::utils::StatsIndividual::incOutgoingMessageQueueSize(hostBlock->stats);
     if (availabilityDate < BaseSimulator::getScheduler()->now()) availabilityDate = BaseSimulator::getScheduler()->now();
-    if (outgoingQueue.size() == 1 && messageBeingTransmitted == NULL) {
+    if (outgoingQueue.size() == 1 && backoffSlots < 0 && messageAwaitingAck == NULL
+        && (messageBeingTransmitted == NULL || messageBeingTransmitted->type == WIRELESS_MAC_ACK)) {
         //
-        // Scheduling this event instead of directly calling send() allows for taking into account processing time
+        // The backoff counts down from the availability date, which allows for taking into account processing time
         //
-	BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceChannelListeningEvent(availabilityDate,this));
+	startContention(availabilityDate);
     }
     // as long as there is no limit to the buffer size, this function will return true
     return(true);
 }
 
-float WirelessNetworkInterface::pathLoss(float power, float distance, float gain, float tHeight, float rHeight){
-//Compute the path loss using the two-ray ground model
-	float receivedPower = power + 10 * log10(pow(tHeight,2)*pow(rHeight,2)) - 25 * log10(distance);
-	return receivedPower;
+double WirelessNetworkInterface::getMaxRange(float sensitivity) {
+	return getChannelModel()->getMaxRange(transmitPower, sensitivity);
 }
 
-float WirelessNetworkInterface::shadowing(float exponent, float distance, float deviation){
-	stringstream info;
-	std::random_device rand;
-	std::default_random_engine generator(rand());
-	std::normal_distribution<double> distribution(0, deviation);
-	float shadowing =  distribution(generator);
-	info << "shadowing : " << shadowing;
-	//getScheduler()->trace(info.str());
-	return shadowing;
+float WirelessNetworkInterface::getLinkBudget(WirelessNetworkInterface *source) {
+	bID sourceId = source->hostBlock->blockId;
+	auto it = linkBudgets.find(sourceId);
+	if (it != linkBudgets.end() && it->second.sourceVersion == source->linkVersion) {
+		return it->second.power;
+	}
+
+	Vector3D vec1 = source->hostBlock->getPositionVector();
+	Vector3D vec2 = hostBlock->getPositionVector();
+	double distance = sqrt(pow(abs(vec1.pt[0] - vec2.pt[0]),2)+pow(abs(vec1.pt[1] - vec2.pt[1]),2));
+	ChannelModel *channel = getChannelModel();
+	LinkBudget budget { source->linkVersion, channel->getLinkBudget(source->getTransmitPower(), distance) };
+	if (channel->getWallAttenuation() > 0) {
+		// Walls do not move, the attenuation is cached with the budget
+		int nbWalls = getWorld()->getObstacleGrid().countWalls(source->hostBlock->position, hostBlock->position);
+		budget.power -= nbWalls * channel->getWallAttenuation();
+	}
+	if (it != linkBudgets.end()) {
+		it->second = budget;
+	} else {
+		if (linkBudgets.size() >= WIRELESS_LINK_CACHE_MAX_SIZE) linkBudgets.clear();
+		linkBudgets.emplace(sourceId, budget);
+	}
+	return budget.power;
 }
@@ -9,11 +9,14 @@
 #define NETWORK_H_
 
 #include <deque>
+#include <atomic>
+#include <unordered_map>
 #include <string.h>
 
 #include "tDefs.h"
 #include "rate.h"
 #include "buildingBlock.h"
+#include "simulationContext.h"
 
 using namespace std;
 
@@ -41,9 +44,6 @@ typedef std::shared_ptr<WirelessMessage> WirelessMessagePtr;
 //===========================================================================================================
 
 class Message {
-protected:
-	static uint64_t nextId;
-	static uint64_t nbMessages;
 public:
 	uint64_t id;
 	unsigned int type;
@@ -110,15 +110,13 @@ class P2PMessageOf:public P2PMessage {
 //===========================================================================================================
 
 class WirelessMessage {
-protected:
-    static uint64_t nextId;
-    static uint64_t nbMessages;
 public:
     uint64_t id;
     unsigned int type;
 
     WirelessNetworkInterface *sourceInterface;
     bID destinationId;
+    uint32_t sequenceNumber; //!< Number of the message among those sent by its source interface, kept by its retransmissions
    
     WirelessMessage(bID destId);
     virtual ~WirelessMessage();
@@ -151,11 +149,13 @@ class WirelessMessageOf:public WirelessMessage {
 //===========================================================================================================
 class NetworkInterface {
 protected :
-	static unsigned int nextId;
-	static int defaultDataRate;
-
 	BaseSimulator::Rate* dataRate;
 public:
+	//!< @brief Returns the data rate (bit/s) of the interfaces of the simulation of the calling thread that are created without rate
+	static inline int getDefaultDataRate() { return BaseSimulator::SimulationContext::current().defaultDataRate; };
+	//!< @brief Sets the data rate (bit/s) of the interfaces created without rate for the simulation of the calling thread
+	static void setDefaultDataRate(int r) { BaseSimulator::SimulationContext::current().defaultDataRate = r; };
+
 	unsigned int globalId;
 	unsigned int localId;
 	BaseSimulator::BuildingBlock * hostBlock;
@@ -164,6 +164,10 @@ protected :
 	NetworkInterface(BaseSimulator::BuildingBlock *b);
 	virtual ~NetworkInterface() = 0;
 	virtual void send() = 0;
+	//!< @brief Saves the state of the interface modified by its events (see BuildingBlock::saveState)
+	virtual void saveState(BaseSimulator::StateSnapshot &s);
+	//!< @brief Saves or restores the state of the interface into a checkpoint file (see BuildingBlock::checkpoint)
+	virtual void checkpoint(BaseSimulator::CheckpointArchive &a);
 };
 
 
@@ -194,6 +198,10 @@ class P2PNetworkInterface : public NetworkInterface {
 	
 	void setDataRate(BaseSimulator::Rate* r); 
 	Time getTransmissionDuration(MessagePtr &m);
+	//!< @brief Returns a lower bound of the transmission duration of a message of size bytes, 0 if the data rate is unbounded
+	Time getMinTransmissionDuration(unsigned int size);
+	void saveState(BaseSimulator::StateSnapshot &s);
+	void checkpoint(BaseSimulator::CheckpointArchive &a);
 
 };
 
@@ -203,7 +211,57 @@ class P2PNetworkInterface : public NetworkInterface {
 //
 //==========================================================================================================
 
+#define WIRELESS_LINK_CACHE_MAX_SIZE 4096 //!< Number of link budgets above which the cache of an interface is emptied
+#define WIRELESS_BROADCAST_ID 255 //!< Destination identifier of the messages sent to every module in range
+
+/**
+ * @brief Wireless interface of a module, with a CSMA/CA medium access control (see WirelessMacParameters)
+ *
+ *  The channel is busy for an interface while it senses the transmissions of other interfaces, or transmits. The
+ *  backoff of the message at the head of the outgoing queue counts down while the channel is idle, and is frozen,
+ *  by the number of slots elapsed, as soon as it becomes busy. Every change of the state of the medium access
+ *  control costs O(1): the pending backoff or acknowledgment timeout event is discarded by incrementing macVersion
+ *  rather than searched in the event list.
+ */
+
 class WirelessNetworkInterface : public NetworkInterface {
+    //!< Received power of the transmissions of a source, before shadowing
+    struct LinkBudget {
+        uint32_t sourceVersion; //!< linkVersion of the source when the budget was computed
+        float power; //!< Mean received power (dBm)
+    };
+    std::unordered_map<bID, LinkBudget> linkBudgets; //!< Link budgets of the sources heard, by block id
+    uint32_t linkVersion = 0; //!< Incremented when the block moves or the transmit power changes
+    BaseSimulator::uintRNG generator; //!< Random generator of the interface: shadowing of the receptions and backoffs
+
+    //!< @brief Returns the mean received power of the transmissions of source, from the cache if it is up to date
+    float getLinkBudget(WirelessNetworkInterface *source);
+
+    // Medium access control
+    unsigned int nbSensed = 0; //!< Number of transmissions of other interfaces being sensed
+    bool channelBusy = false; //!< true while a transmission is sensed or sent by the interface
+    Time busySince = 0; //!< Date at which the channel became busy
+    int backoffSlots = -1; //!< Remaining backoff slots of the message at the head of the queue, -1 if none is pending
+    bool countingDown = false; //!< true while the interframe space, then the backoff, count down
+    Time countdownStart = 0; //!< Date at which the countdown started or resumed
+    unsigned int nbRetries = 0; //!< Number of retransmissions of the message being sent
+    uint32_t macVersion = 0; //!< Version of the pending backoff or acknowledgment timeout event, the others are discarded
+    WirelessMessagePtr messageAwaitingAck; //!< Message sent and not acknowledged yet, NULL if none
+    uint32_t nextSequenceNumber = 0; //!< Sequence number of the last message queued for sending
+    std::unordered_map<bID, uint32_t> lastSequenceNumbers; //!< Sequence number of the last message acknowledged to each source
+
+    //!< @brief Returns the contention window (slots), doubled at every retransmission
+    unsigned int getContentionWindow();
+    //!< @brief Draws the backoff of the message at the head of the queue, which counts down from date if the channel is idle
+    void startContention(Time date);
+    //!< @brief Starts the countdown of the pending backoff, after the interframe space
+    void resumeCountdown(Time date);
+    //!< @brief Updates the busy state of the channel, freezing or resuming the backoff, after a transmission starts or ends
+    void updateChannelState();
+    //!< @brief Ends the sending of the current message, acknowledged or dropped, and contends for the next one
+    void endOfExchange();
+    //!< @brief Starts the transmission of msg
+    void transmit(WirelessMessagePtr msg);
 protected:
     float transmitPower;
     float receptionThreshold;
@@ -211,10 +269,8 @@ class WirelessNetworkInterface : public NetworkInterface {
     bool collisionOccuring;
     bool transmitting;
     bool receiving;
-    bool channelAvailability;
     WirelessMessagePtr messageBeingReceived;
 public:
-    bool first;
     WirelessMessagePtr messageBeingTransmitted;
     deque<WirelessMessagePtr> outgoingQueue;
     WirelessNetworkInterface(BaseSimulator::BuildingBlock *b, float power, float threshold, float sensitivity);
@@ -227,14 +283,60 @@ class WirelessNetworkInterface : public NetworkInterface {
     virtual void send();
     void startReceive(WirelessMessagePtr msg);
     void stopReceive();
+    //!< @brief Ends the transmission of messageBeingTransmitted (see WirelessNetworkInterfaceStopTransmittingEvent)
+    void stopTransmit();
+    //!< @brief Ends the sensing of a transmission of another interface (see WirelessNetworkInterfaceIdleEvent)
+    void stopSensing();
+    //!< @brief Sends the message at the head of the queue if the backoff of the given version has expired (see
+    //!<  WirelessNetworkInterfaceChannelListeningEvent)
+    void backoffExpired(uint32_t version);
+    //!< @brief Retransmits or drops the message awaiting the acknowledgment of the given version (see
+    //!<  WirelessNetworkInterfaceAckTimeoutEvent)
+    void ackTimeout(uint32_t version);
+    //!< @brief Sends an acknowledgment, without contention (see WirelessNetworkInterfaceSendAckEvent)
+    void sendAck(WirelessMessagePtr ack);
+    //!< @brief Getter for the version of the pending backoff or acknowledgment timeout event
+    uint32_t getMacVersion() { return macVersion; };
     void setTransmitPower(int power);
-    void setAvailability(bool availability) { channelAvailability = availability;};
-    bool getAvailability(){return channelAvailability;};
+    //!< @brief Returns true if the channel is idle: the interface neither senses nor sends any transmission
+    bool getAvailability(){return !channelBusy;};
     float getTransmitPower();
-    float pathLoss(float power, float distance, float gain, float tHeight, float rHeight); 
-    float shadowing(float exponent, float distance, float deviation);
+    //!< @brief Returns the distance (in cells, in the plane) beyond which no transmission of this interface can reach
+    //!<  an interface of the given sensitivity (dBm), whatever the shadowing
+    double getMaxRange(float sensitivity);
+    //!< @brief Getter for the power (dBm) below which a transmission is not sensed
+    float getReceptionSensitivity() { return receptionSensitivity; };
+    //!< @brief Invalidates the link budgets involving this interface, called when its block moves
+    void invalidateLinks() { linkVersion++; linkBudgets.clear(); };
+    //!< @brief Re-creates the random generator of the interface from the seed of the block
+    void reseed(BaseSimulator::ruint seed);
+    //!< @brief Getter for the random generator of the interface, seeded from the simulation seed (see -a), to draw
+    //!<  from it (saved on first draw by a speculative event, see BuildingBlock::willModify)
+    BaseSimulator::uintRNG& getGenerator();
     Time getTransmissionDuration(WirelessMessagePtr &m);
+    //!< @brief Returns the duration of the transmission of a message of size bytes
+    Time getTransmissionDuration(unsigned int size);
+    //!< @brief Returns the time elapsed since the channel became busy, 0 if it is idle (see StatsIndividual::getStats)
+    Time getOngoingBusyTime();
     bool isTransmitting(){return transmitting;};
     bool isReceiving(){return receiving;};
+    void saveState(BaseSimulator::StateSnapshot &s);
+    void checkpoint(BaseSimulator::CheckpointArchive &a);
+
+    //!< @brief Sets the delay between the start of a transmission and the start of its reception (us), 0 by default
+    //!<  (configuration file, <wireless propagationDelay="..."/>)
+    static void setPropagationDelay(Time d) { BaseSimulator::SimulationContext::current().propagationDelay = d; };
+    //!< @brief Getter for the propagation delay of the wireless medium of the simulation
+    static inline Time getPropagationDelay() { return BaseSimulator::SimulationContext::current().propagationDelay; };
+    //!< @brief Sets the radio channel model of the simulation, which takes ownership of it (configuration file,
+    //!<  <wireless channel="..."/>)
+    static void setChannelModel(BaseSimulator::ChannelModel *m) { BaseSimulator::SimulationContext::current().channelModel.reset(m); };
+    //!< @brief Getter for the radio channel model of the simulation, two-ray ground by default
+    static inline BaseSimulator::ChannelModel* getChannelModel() { return BaseSimulator::SimulationContext::current().channelModel.get(); };
+    //!< @brief Sets the parameters of the medium access control of the simulation (configuration file,
+    //!<  <wireless ack="true" slotTime="..."/>)
+    static void setMacParameters(const BaseSimulator::WirelessMacParameters &p) { BaseSimulator::SimulationContext::current().mac = p; };
+    //!< @brief Getter for the parameters of the medium access control of the simulation
+    static inline const BaseSimulator::WirelessMacParameters& getMacParameters() { return BaseSimulator::SimulationContext::current().mac; };
 };
 #endif /* NETWORK_H_ */
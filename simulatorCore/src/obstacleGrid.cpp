@@ -0,0 +1,61 @@
+/*! @file obstacleGrid.cpp
+ * @brief Walls of the world between adjacent cells, and the number of walls crossed by a straight line between two
+ *  cells, used by the wireless interfaces to attenuate the signals going through walls
+ * @date 17/10/2026
+ */
+
+#include "obstacleGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+namespace BaseSimulator {
+
+bool ObstacleGrid::addWall(const Cell3DPosition &a, const Cell3DPosition &b) {
+	int dx = b[0] - a[0], dy = b[1] - a[1];
+	if (dy == 0 && abs(dx) == 1) {
+		verticalWalls.insert(cellKey(min(a[0], b[0]), a[1]));
+	} else if (dx == 0 && abs(dy) == 1) {
+		horizontalWalls.insert(cellKey(a[0], min(a[1], b[1])));
+	} else {
+		return false;
+	}
+	return true;
+}
+
+int ObstacleGrid::countWalls(const Cell3DPosition &a, const Cell3DPosition &b) const {
+	if (verticalWalls.empty() && horizontalWalls.empty()) return 0;
+
+	int64_t dx = abs(b[0] - a[0]), dy = abs(b[1] - a[1]);
+	int sx = b[0] > a[0] ? 1 : -1, sy = b[1] > a[1] ? 1 : -1;
+	int32_t x = a[0], y = a[1];
+	int nbWalls = 0;
+	// The line from the center of a to the center of b leaves the current cell through a vertical side after
+	// (2 * ix + 1) / (2 * dx) of its length, through a horizontal side after (2 * iy + 1) / (2 * dy)
+	for (int64_t ix = 0, iy = 0; ix < dx || iy < dy; ) {
+		int64_t toVertical = (2 * ix + 1) * dy, toHorizontal = (2 * iy + 1) * dx;
+		if (ix < dx && iy < dy && toVertical == toHorizontal) {
+			// Through a corner: around it by the side with the fewest walls
+			int xFirst = verticalWall(x, y, sx) + horizontalWall(x + sx, y, sy);
+			int yFirst = horizontalWall(x, y, sy) + verticalWall(x, y + sy, sx);
+			nbWalls += min(xFirst, yFirst);
+			x += sx;
+			y += sy;
+			ix++;
+			iy++;
+		} else if (iy == dy || (ix < dx && toVertical < toHorizontal)) {
+			nbWalls += verticalWall(x, y, sx);
+			x += sx;
+			ix++;
+		} else {
+			nbWalls += horizontalWall(x, y, sy);
+			y += sy;
+			iy++;
+		}
+	}
+	return nbWalls;
+}
+
+} // namespace BaseSimulator
@@ -0,0 +1,59 @@
+/*! @file obstacleGrid.h
+ * @brief Walls of the world between adjacent cells, and the number of walls crossed by a straight line between two
+ *  cells, used by the wireless interfaces to attenuate the signals going through walls
+ * @date 17/10/2026
+ */
+
+#ifndef OBSTACLEGRID_H__
+#define OBSTACLEGRID_H__
+
+#include <cstdint>
+#include <unordered_set>
+
+#include "cell3DPosition.h"
+
+namespace BaseSimulator {
+
+/**
+ * @brief Walls of the obstacle list of the configuration, in the plane (x, y)
+ *
+ *  An obstacle between two adjacent cells is a wall on their common side, as drawn by MultiRobotsWorld. Walls are
+ *  stored by the side of the grid they cover, so that the walls crossed by the line between the centers of two
+ *  cells are found by walking the cells along the line (grid DDA), in time proportional to the distance between
+ *  the cells, whatever the number of walls.
+ */
+class ObstacleGrid {
+	std::unordered_set<uint64_t> verticalWalls; //!< Walls between cells (x, y) and (x + 1, y), by key of (x, y)
+	std::unordered_set<uint64_t> horizontalWalls; //!< Walls between cells (x, y) and (x, y + 1), by key of (x, y)
+
+	//!< @brief Returns the key of the cell of coordinates (x, y)
+	static inline uint64_t cellKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+	//!< @brief Returns 1 if there is a wall between cells (x, y) and (x + sx, y), 0 otherwise
+	inline int verticalWall(int32_t x, int32_t y, int sx) const {
+		return verticalWalls.count(cellKey(sx > 0 ? x : x - 1, y));
+	}
+	//!< @brief Returns 1 if there is a wall between cells (x, y) and (x, y + sy), 0 otherwise
+	inline int horizontalWall(int32_t x, int32_t y, int sy) const {
+		return horizontalWalls.count(cellKey(x, sy > 0 ? y : y - 1));
+	}
+public:
+	/**
+	 * @brief Adds a wall between two cells
+	 * @return false if the cells are not adjacent in the plane, the wall is then ignored
+	 */
+	bool addWall(const Cell3DPosition &a, const Cell3DPosition &b);
+	//!< @brief Returns the number of walls
+	size_t size() const { return verticalWalls.size() + horizontalWalls.size(); }
+
+	/**
+	 * @brief Returns the number of walls crossed by the line between the centers of two cells
+	 *
+	 *  A line going exactly through a corner of the grid crosses the walls of the most open of the two ways around
+	 *  the corner, so that the count does not depend on the direction of the line.
+	 */
+	int countWalls(const Cell3DPosition &a, const Cell3DPosition &b) const;
+};
+
+} // namespace BaseSimulator
+
+#endif // OBSTACLEGRID_H__
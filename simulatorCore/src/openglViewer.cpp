@@ -25,7 +25,6 @@
 //
 //===========================================================================================================
 
-bool GlutContext::GUIisEnabled = true;
 
 int GlutContext::screenWidth = 1024;
 int GlutContext::screenHeight = 800;
@@ -37,6 +36,7 @@ int GlutContext::lastMousePos[2];
 //bool GlutContext::showLinks=false;
 bool GlutContext::fullScreenMode=false;
 bool GlutContext::saveScreenMode=false;
+bool GlutContext::showEventHeatmap=false;
 bool GlutContext::mustSaveImage=false;
 GlutSlidingMainWindow *GlutContext::mainWindow=NULL;
 GlutSlidingDebugWindow *GlutContext::debugWindow=NULL;
@@ -48,7 +48,7 @@ int GlutContext::previousTime = 0;
 float GlutContext::fps = 0;
 
 void GlutContext::init(int argc, char **argv) {
-	if (GUIisEnabled) {
+	if (isGUIEnabled()) {
 		glutInit(&argc,argv);
 		glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE,GLUT_ACTION_CONTINUE_EXECUTION);
 		glutInitDisplayMode(GLUT_RGBA | GLUT_DEPTH | GLUT_DOUBLE);
@@ -97,7 +97,7 @@ void GlutContext::init(int argc, char **argv) {
 }
 
 void GlutContext::deleteContext() {
-	if (GUIisEnabled) {
+	if (isGUIEnabled()) {
 		delete mainWindow;
 		delete debugWindow;
 		delete popup;
@@ -312,6 +312,7 @@ void GlutContext::keyboardFunc(unsigned char c, int x, int y)
             break;
 		case 's' : saveScreenMode=!saveScreenMode; break;
 		case 'S' : saveScreen((char *)("capture.ppm")); break;
+		case 'e' : showEventHeatmap=!showEventHeatmap; break;
         case 'B' : 
 			World *world = BaseSimulator::getWorld();
             world->toggleBackground();
@@ -502,7 +503,7 @@ int GlutContext::processHits(GLint hits, GLuint *buffer) {
 }
 
 void GlutContext::mainLoop() {
-	if (GUIisEnabled) {
+	if (isGUIEnabled()) {
 		glutMainLoop();
 	} else {
 //    cout << "r+[ENTER] to run simulation" << endl;
@@ -531,7 +532,7 @@ void GlutContext::mainLoop() {
 }
 
 void GlutContext::addTrace(const string &message,int id,const Color &color) {
-	if (GUIisEnabled && mainWindow)
+	if (isGUIEnabled() && mainWindow)
 		mainWindow->addTrace(id,message,color);
 }
 
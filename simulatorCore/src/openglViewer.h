@@ -15,6 +15,7 @@
 #include "camera.h"
 #include "glBlock.h"
 #include "interface.h"
+#include "simulationContext.h"
 
 #ifndef GLUT
 #define GLUT
@@ -29,7 +30,10 @@ class GlutContext;
 class GlutContext {
     static int keyboardModifier;
 public :
-    static bool GUIisEnabled; //!< Enable / Disable GLUT graphical simulation, enabled by default
+    //!< @brief Returns true if the simulation of the calling thread uses the GLUT graphical interface (default), false in terminal mode
+    static inline bool isGUIEnabled() { return BaseSimulator::SimulationContext::current().guiEnabled; };
+    //!< @brief Enables or disables the graphical interface for the simulation of the calling thread
+    static void setGUIEnabled(bool e) { BaseSimulator::SimulationContext::current().guiEnabled = e; };
     static GlutSlidingMainWindow *mainWindow;
     static GlutSlidingDebugWindow *debugWindow;
     static GlutPopupWindow *popup;
@@ -39,6 +43,7 @@ public :
     static int initialScreenWidth, initialScreenHeight;
     static bool fullScreenMode;
     static bool saveScreenMode;
+    static bool showEventHeatmap; //!< If true, worlds supporting it color modules by number of processed events (requires -i)
     static int lastMotionTime;
     static int lastMousePos[2];
     static bool mustSaveImage;
@@ -0,0 +1,138 @@
+/*! @file parallelEngine.cpp
+ * @brief Base class of the engines that execute simulation events on several threads (see -P)
+ * @date 17/10/2026
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "parallelEngine.h"
+#include "conservativeEngine.h"
+#include "timeWarpEngine.h"
+#include "world.h"
+#include "network.h"
+#include "trace.h"
+#include "statsIndividual.h"
+
+using namespace std;
+
+namespace BaseSimulator {
+
+thread_local WorkerContext *ParallelEngine::current = NULL;
+
+ParallelEngine *ParallelEngine::create(int type, Scheduler *s, unsigned int n) {
+	switch (type) {
+	case PARALLEL_ENGINE_CONSERVATIVE: return new ConservativeEngine(s, n);
+	case PARALLEL_ENGINE_OPTIMISTIC: return new TimeWarpEngine(s, n);
+	default: return NULL;
+	}
+}
+
+int ParallelEngine::parseType(const string &name) {
+	if (name == "conservative") return PARALLEL_ENGINE_CONSERVATIVE;
+	if (name == "optimistic") return PARALLEL_ENGINE_OPTIMISTIC;
+	return -1;
+}
+
+ParallelEngine::ParallelEngine(Scheduler *s, unsigned int n) : scheduler(s), nbWorkers(n) {
+}
+
+ParallelEngine::~ParallelEngine() {
+	stop();
+}
+
+void ParallelEngine::start() {
+	// Closed log file: set its failure state once, so that concurrent writes to OUTPUT do not modify it
+	if (!getLogFile().is_open()) {
+		getLogFile().setstate(ios::badbit);
+	}
+
+	stopping = false;
+	for (unsigned int i = 1; i < nbWorkers; i++) {
+		threads.push_back(thread(&ParallelEngine::workerLoop, this, i));
+	}
+}
+
+void ParallelEngine::stop() {
+	{
+		lock_guard<mutex> lock(mutex_workers);
+		stopping = true;
+	}
+	cvStart.notify_all();
+	for (thread &t : threads) {
+		t.join();
+	}
+	threads.clear();
+}
+
+void ParallelEngine::workerLoop(unsigned int i) {
+	scheduler->getContext()->bind();
+	uint64_t done = 0;
+	for (;;) {
+		{
+			unique_lock<mutex> lock(mutex_workers);
+			cvStart.wait(lock, [this, done] { return stopping || round != done; });
+			if (stopping) return;
+			done = round;
+		}
+
+		processPartition(i);
+
+		{
+			lock_guard<mutex> lock(mutex_workers);
+			if (--pending == 0) cvDone.notify_one();
+		}
+	}
+}
+
+void ParallelEngine::runWorkers() {
+	{
+		lock_guard<mutex> lock(mutex_workers);
+		round++;
+		pending = nbWorkers - 1;
+	}
+	cvStart.notify_all();
+
+	processPartition(0);
+
+	unique_lock<mutex> lock(mutex_workers);
+	cvDone.wait(lock, [this] { return pending == 0; });
+}
+
+uint64_t ParallelEngine::consumeTimed(Event *ev) {
+	if (!utils::StatsIndividual::isEnabled()) {
+		ev->consume();
+		return 0;
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	ev->consume();
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+}
+
+void ParallelEngine::countEvent(Event *ev, uint64_t ns) {
+	// The concerned module of an event is its owner: only the worker of its partition updates its statistics
+	BuildingBlock *bb = utils::StatsIndividual::isEnabled() ? ev->getConcernedBlock() : NULL;
+	if (bb) {
+		utils::StatsIndividual::incEventCount(bb->stats, ns);
+	}
+}
+
+Time ParallelEngine::computeLookahead() {
+	Time lookahead = TIME_MAX;
+
+	for (auto &it : getWorld()->getMap()) {
+		BuildingBlock *bb = it.second;
+		for (int i = 0; i < bb->getNbInterfaces(); i++) {
+			lookahead = min(lookahead, bb->getInterface(i)->getMinTransmissionDuration(PARALLEL_MIN_MESSAGE_SIZE));
+		}
+	}
+
+	// Without propagation delay, wireless transmissions have no owner: the earliest one that an event can cause is the
+	// end of the backoff of a message it enqueues, after the interframe space
+	Time d = WirelessNetworkInterface::getPropagationDelay();
+	lookahead = min(lookahead, d > 0 ? d : WirelessNetworkInterface::getMacParameters().difs);
+
+	return lookahead;
+}
+
+} // BaseSimulator namespace
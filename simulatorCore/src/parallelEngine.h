@@ -0,0 +1,172 @@
+/*! @file parallelEngine.h
+ * @brief Base class of the engines that execute simulation events on several threads (see -P)
+ *  Modules are partitioned across worker threads, each worker processing the events owned by the modules of its
+ *  partition (see Event::getOwnerBlock). Events without owner are processed alone by the scheduler thread.
+ * @date 17/10/2026
+ */
+
+#ifndef PARALLELENGINE_H_
+#define PARALLELENGINE_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <string>
+
+#include "events.h"
+#include "tDefs.h"
+
+// Parallel engine implementations (defines the synchronization protocol between the worker threads)
+#define PARALLEL_ENGINE_CONSERVATIVE	1 //!< Window-based conservative synchronization (YAWNS). (Default)
+#define PARALLEL_ENGINE_OPTIMISTIC		2 //!< Optimistic synchronization with rollbacks (Time Warp)
+
+#define PARALLEL_MIN_MESSAGE_SIZE 1 //!< Smallest message size assumed when deriving the lookahead of P2P links (bytes)
+
+namespace BaseSimulator {
+
+class Scheduler;
+
+//!< State of a worker thread, accessible to the simulation code running on it through ParallelEngine::getWorker
+struct WorkerContext {
+	unsigned int index = 0; //!< index of the worker, which is also the index of the partition it processes
+	Time date = 0; //!< date of the event being processed by the worker
+	uint64_t nbEvents = 0; //!< number of events processed by the worker since the beginning of the simulation
+	uint64_t nbMessages = 0; //!< messages sent by the worker, not yet added to the StatsCollector
+	uint64_t nbMotions = 0; //!< motions processed by the worker, not yet added to the StatsCollector
+	string violation; //!< description of the first operation that the engine cannot process in parallel, empty if none
+};
+
+/**
+ * @brief Abstract parallel execution engine
+ *  Owns a pool of worker threads. The scheduler thread acts as worker 0, so that an engine with n workers only
+ *  starts n-1 threads. Subclasses implement the synchronization protocol between partitions.
+ */
+class ParallelEngine {
+protected:
+	static thread_local WorkerContext *current; //!< Context of the worker running on the calling thread, NULL outside of workers
+
+	Scheduler *scheduler; //!< Scheduler for which events are processed
+	unsigned int nbWorkers; //!< Number of workers, including the scheduler thread
+
+	std::vector<std::thread> threads; //!< Worker threads 1 to nbWorkers-1
+	std::mutex mutex_workers; //!< Protects the fields below
+	std::condition_variable cvStart; //!< Signals workers that a new round has been started, or that they must stop
+	std::condition_variable cvDone; //!< Signals the scheduler thread that all workers have finished the current round
+	uint64_t round = 0; //!< Number of rounds started so far
+	unsigned int pending = 0; //!< Number of workers that have not finished the current round
+	bool stopping = false; //!< True when workers have to exit
+
+	//!< @brief Main loop of worker thread i
+	void workerLoop(unsigned int i);
+
+	/**
+	 * @brief Executes processPartition concurrently on every worker, and returns once all of them have finished.
+	 *  Must be called by the scheduler thread, which processes partition 0 itself.
+	 */
+	void runWorkers();
+
+	/**
+	 * @brief Processes the events of partition i for the current round. Called concurrently by all the workers
+	 * @param i index of the partition, and of the calling worker
+	 */
+	virtual void processPartition(unsigned int i) = 0;
+
+	/**
+	 * @brief Returns the smallest delay between an event of a module and the events it can schedule for another
+	 *  module: the minimum transmission duration over all P2P interfaces of the world, and the propagation delay
+	 *  of wireless messages. 0 if one of the P2P interfaces has an unbounded data rate.
+	 */
+	static Time computeLookahead();
+
+	/**
+	 * @brief Processes ev, and times it if the statistics of the modules are enabled (see -i)
+	 * @return processing time of ev (ns), 0 if the statistics of the modules are disabled
+	 */
+	static uint64_t consumeTimed(Event *ev);
+	//!< @brief Adds ev, processed in ns nanoseconds, to the statistics of its module if they are enabled (see -i)
+	static void countEvent(Event *ev, uint64_t ns);
+	//!< @brief Processes ev, and adds it to the statistics of its module if they are enabled (see -i)
+	static inline void consumeCounted(Event *ev) { countEvent(ev, consumeTimed(ev)); };
+public:
+	/**
+	 * @brief Constructor, does not start the worker threads yet (see start)
+	 * @param s scheduler for which events will be processed
+	 * @param n number of workers, including the scheduler thread
+	 */
+	ParallelEngine(Scheduler *s, unsigned int n);
+	//!< @brief Stops and joins the worker threads
+	virtual ~ParallelEngine();
+
+	/**
+	 * @brief Returns false, after printing why, if the engine cannot process the events of the world (its block codes
+	 *  cannot be rolled back, for instance). The scheduler then falls back to the conservative engine
+	 */
+	virtual bool canProcess() { return true; };
+	//!< @brief Prepares the engine and starts the worker threads. Called by the scheduler thread before processing events
+	virtual void start();
+	//!< @brief Stops the worker threads, and waits for their termination
+	virtual void stop();
+
+	//!< @brief Returns the context of the worker running on the calling thread, NULL if called from another thread
+	static inline WorkerContext *getWorker() { return current; };
+	//!< @brief Getter for ParallelEngine::nbWorkers
+	inline unsigned int getNbWorkers() const { return nbWorkers; };
+	//!< @brief Returns the index of the partition that contains module bb
+	inline unsigned int partitionOf(const BuildingBlock *bb) const { return bb->blockId % nbWorkers; };
+
+	/**
+	 * @brief Processes the next events of the event list, which must not be empty. Called by the scheduler thread
+	 *  in place of the processing of a single event in the sequential event loop.
+	 */
+	virtual void step() = 0;
+
+	//!< @brief Returns true if the engine holds events that are not in the event list of the scheduler
+	virtual bool hasPendingEvents() const { return false; };
+
+	/**
+	 * @brief Inserts an event scheduled by a worker while it processes its partition
+	 * @param pev event to schedule, its date has already been validated by the scheduler
+	 * @return false if the calling thread is not a worker of this engine (event left untouched), true otherwise
+	 */
+	virtual bool schedule(EventPtr &pev) = 0;
+
+	/**
+	 * @brief Cancels an event, on behalf of a worker while it processes its partition, or of the scheduler thread
+	 *  for an event that is not in the event list (see Scheduler::cancel)
+	 * @param pev event to cancel, not cancelled yet
+	 * @return true if the event was pending and has been cancelled, false otherwise
+	 */
+	virtual bool cancel(EventPtr &pev) = 0;
+
+	/**
+	 * @brief Holds a trace line emitted by a worker while it processes a speculative event, until the event is
+	 *  committed (see Scheduler::trace)
+	 * @param line formatted trace line
+	 * @return false if the line can be printed right away, true if the engine holds it
+	 */
+	virtual bool holdTrace(const string &line) { return false; };
+
+	//!< @brief Returns a printable name for the engine
+	virtual const string getName() const = 0;
+
+	/**
+	 * @brief Instantiates a new parallel engine of the requested implementation
+	 * @param type one of the PARALLEL_ENGINE_* constants
+	 * @param s scheduler for which events will be processed
+	 * @param n number of workers, including the scheduler thread
+	 * @return a pointer to the newly allocated engine, or NULL if type is unknown
+	 */
+	static ParallelEngine *create(int type, Scheduler *s, unsigned int n);
+	/**
+	 * @brief Parses the name of an engine implementation, as given on the command line
+	 * @param name one of "conservative", "optimistic"
+	 * @return the corresponding PARALLEL_ENGINE_* constant, or -1 if name is unknown
+	 */
+	static int parseType(const string &name);
+};
+
+} // BaseSimulator namespace
+
+#endif /* PARALLELENGINE_H_ */
@@ -80,6 +80,11 @@ GNoiseQClock::~GNoiseQClock () {
   delete noise;
 }
 
+void GNoiseQClock::saveState(StateSnapshot &s) {
+  s.save(referencePoints);
+  noise->saveState(s);
+}
+
 Time GNoiseQClock::getTime(Time simTime) {
   double localTime = 0;
   double noise_SimTime = 0;
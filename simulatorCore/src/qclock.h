@@ -115,6 +115,9 @@ class GNoiseQClock : public QClock {
 
   Time getTime(Time simTime);
   Time getSimulationTime(Time localTime);
+  void saveState(StateSnapshot &s);
+  // The noise generator is opaque, its state cannot be saved
+  bool checkpoint(CheckpointArchive &a) { return false; };
 
  protected:
    /**
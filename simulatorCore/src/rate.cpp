@@ -1,5 +1,6 @@
 #include <iostream>
 #include "rate.h"
+#include "checkpoint.h"
 
 using namespace std;
 using namespace BaseSimulator::utils;
@@ -30,16 +31,29 @@ double StaticRate::get() {
   return value;
 }
 
+double StaticRate::getMax() {
+  return value;
+}
+
 RandomRate::RandomRate() {
   generator = Random::getUniformDoubleRNG(0,0,0);
+  max = 0;
 }
 
 RandomRate::RandomRate(doubleRNG &g) {
   generator = g;
+  max = std::numeric_limits<double>::infinity();
+}
+
+RandomRate::RandomRate(doubleRNG &g, double m) {
+  generator = g;
+  max = m;
 }
 
 RandomRate::RandomRate(const RandomRate &rr) : Rate(rr) {
   generator = rr.generator;
+  max = rr.max;
+  draws = rr.draws;
 }
 
 RandomRate::~RandomRate() {
@@ -47,7 +61,29 @@ RandomRate::~RandomRate() {
 }
   
 double RandomRate::get() {
+  draws++;
   return generator();
 }
 
+double RandomRate::getMax() {
+  return max;
+}
+
+void RandomRate::saveState(StateSnapshot &s) {
+  s.saveOnce(generator);
+  s.saveOnce(draws);
+}
+
+void RandomRate::checkpoint(CheckpointArchive &a) {
+  // doubleRNG hides its engine: replay the draws on the generator re-created from the same seed
+  uint64_t n = draws;
+  a & n;
+  if (a.isLoading()) {
+    if (n < draws) {
+      throw CheckpointException("random rate drawn beyond the checkpoint");
+    }
+    while (draws < n) get();
+  }
+}
+
 }
@@ -1,9 +1,14 @@
 #ifndef RATE_H_
 #define RATE_H_
 
+#include <limits>
+
 #include "random.h"
+#include "stateSnapshot.h"
 
 namespace BaseSimulator {
+
+class CheckpointArchive;
   
 class Rate {
  public:
@@ -12,6 +17,13 @@ class Rate {
   virtual ~Rate();
 
   virtual double get() = 0;
+  // Upper bound of the values returned by get(), infinity if unknown (used to derive the lookahead of parallel runs)
+  virtual double getMax() { return std::numeric_limits<double>::infinity(); }
+  // Saves the state modified by get(), if any, unless already saved in s (called before the first draw of each
+  // speculative event by the optimistic parallel engine, see BuildingBlock::willModify)
+  virtual void saveState(StateSnapshot &s) {}
+  // Saves or restores the state modified by get(), if any (see Checkpoint)
+  virtual void checkpoint(CheckpointArchive &a) {}
 };
 
 class StaticRate : public Rate {
@@ -24,18 +36,25 @@ class StaticRate : public Rate {
   ~StaticRate();
 
   double get();
+  double getMax();
 };
 
 class RandomRate : public Rate {
  protected:
   doubleRNG generator;
+  double max; // upper bound of the generated values, infinity if unknown
+  uint64_t draws = 0; // number of values generated, replayed to restore the opaque generator from a checkpoint
  public:
   RandomRate();
   RandomRate(doubleRNG &g);
+  RandomRate(doubleRNG &g, double m);
   RandomRate(const RandomRate &rr);
   ~RandomRate();
   
   double get();
+  double getMax();
+  void saveState(StateSnapshot &s);
+  void checkpoint(CheckpointArchive &a);
 };
 
 }
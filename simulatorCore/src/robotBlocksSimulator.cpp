@@ -31,7 +31,7 @@ RobotBlocksSimulator::~RobotBlocksSimulator() {
 }
 
 void RobotBlocksSimulator::createSimulator(int argc, char *argv[], BlockCodeBuilder bcb) {
-	simulator =  new RobotBlocksSimulator(argc, argv, bcb);
+	Simulator *simulator = new RobotBlocksSimulator(argc, argv, bcb);
 	simulator->parseConfiguration(argc, argv);
 	simulator->startSimulation();
 }
@@ -40,7 +40,7 @@ void RobotBlocksSimulator::loadWorld(const Cell3DPosition &gridSize, const Vecto
 									int argc, char *argv[]) {
     world = new RobotBlocksWorld(gridSize, gridScale, argc,argv);
 
-    if (GlutContext::GUIisEnabled)
+    if (GlutContext::isGUIEnabled())
 		world->loadTextures("../../simulatorCore/resources/textures/latticeTextures");
 	
     World::setWorld(world);
@@ -29,8 +29,7 @@ class RobotBlocksSimulator : public BaseSimulator::Simulator {
     static void createSimulator(int argc, char *argv[], BlockCodeBuilder bcb);
 
     static RobotBlocksSimulator* getSimulator() {
-        assert(simulator != NULL);
-        return((RobotBlocksSimulator*)simulator);
+        return((RobotBlocksSimulator*)Simulator::getSimulator());
     }
 
     virtual void loadWorld(const Cell3DPosition &gridSize, const Vector3D &gridScale,
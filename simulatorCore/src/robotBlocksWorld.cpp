@@ -25,7 +25,7 @@ RobotBlocksWorld::RobotBlocksWorld(const Cell3DPosition &gridSize, const Vector3
 								   int argc, char *argv[]):World(argc, argv) {
 	OUTPUT << "\033[1;31mRobotBlocksWorld constructor\033[0m" << endl;
 
-	if (GlutContext::GUIisEnabled) {
+	if (GlutContext::isGUIEnabled()) {
 		objBlock = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/robotBlocksTextures",
 											"robotBlock.obj");
 		objBlockForPicking = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/robotBlocksTextures",
@@ -43,7 +43,7 @@ RobotBlocksWorld::~RobotBlocksWorld() {
 }
 
 void RobotBlocksWorld::deleteWorld() {
-	delete((RobotBlocksWorld*)world);
+	World::deleteWorld();
 }
 
 void RobotBlocksWorld::addBlock(bID blockId, BlockCodeBuilder bcb, const Cell3DPosition &pos,
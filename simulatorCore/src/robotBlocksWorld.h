@@ -33,8 +33,7 @@ class RobotBlocksWorld : public BaseSimulator::World {
 
     static void deleteWorld();
     static RobotBlocksWorld* getWorld() {
-        assert(world != NULL);
-        return((RobotBlocksWorld*)world);
+        return((RobotBlocksWorld*)World::getWorld());
     }
 
     void printInfo() {
@@ -235,8 +235,8 @@ void Rotation2DStopEvent::consume() {
     StatsIndividual::incMotionCount(rb->stats);
 
     Scheduler *scheduler = getScheduler();
-    concernedBlock->scheduleLocalEvent(EventPtr(new Rotation2DEndEvent(scheduler->now()+COM_DELAY,rb)));
-    //concernedBlock->blockCode->processLocalEvent(EventPtr(new Rotation2DEndEvent(scheduler->now()+COM_DELAY,rb)));
+    concernedBlock->scheduleLocalEvent(makeEventPtr(new Rotation2DEndEvent(scheduler->now()+COM_DELAY,rb)));
+    //concernedBlock->blockCode->processLocalEvent(makeEventPtr(new Rotation2DEndEvent(scheduler->now()+COM_DELAY,rb)));
 }
 
 const string Rotation2DStopEvent::getEventName() {
@@ -56,6 +56,8 @@ class Rotation2DStartEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -77,6 +79,8 @@ class Rotation2DStepEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -95,6 +99,8 @@ class Rotation2DStopEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -111,6 +117,8 @@ class Rotation2DEndEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 #endif
@@ -79,6 +79,8 @@ class Rotation3DStartEvent : public BlockEvent {
 	void consumeBlockEvent() {};
 	void consume();
 	const virtual string getEventName();
+	// Moves the module in the world, which modifies its neighbors
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -96,6 +98,8 @@ class Rotation3DStepEvent : public BlockEvent {
 	void consumeBlockEvent() {};
 	void consume();
 	const virtual string getEventName();
+	// Moves the module in the world, which modifies its neighbors
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -113,6 +117,8 @@ class Rotation3DStopEvent : public BlockEvent {
 	void consumeBlockEvent() {};
 	void consume();
 	const virtual string getEventName();
+	// Moves the module in the world, which modifies its neighbors
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -129,6 +135,8 @@ class Rotation3DEndEvent : public BlockEvent {
 	void consumeBlockEvent() {};
 	void consume();
 	const virtual string getEventName();
+	// Moves the module in the world, which modifies its neighbors
+	BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 #endif /* ROTATIONS3DEVENTS_H_ */
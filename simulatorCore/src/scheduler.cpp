@@ -15,13 +15,18 @@
 #include "trace.h"
 #include "stdint.h"
 #include "statsIndividual.h"
+#include "eventProfiler.h"
+#include "simulator.h"
+#include "world.h"
+#include "checkpoint.h"
+#include "eventTrace.h"
+#include "statsTimeSeries.h"
 
 using namespace std;
 using namespace BaseSimulator::utils;
 
 namespace BaseSimulator {
 
-Scheduler *Scheduler::scheduler=NULL;
 std::mutex Scheduler::delMutex;
 
 Scheduler::Scheduler() {
@@ -32,45 +37,96 @@ Scheduler::Scheduler() {
 		exit(EXIT_FAILURE);
 	}
 
-	if (scheduler == NULL) {
-		scheduler = this;
+	context = &SimulationContext::current();
+	if (context->scheduler == NULL) {
+		context->scheduler = this;
 	} else {
 		ERRPUT << "\033[1;31m" << "Only one Scheduler instance can be created, aborting !" << "\033[0m" << endl;
 		exit(EXIT_FAILURE);
 	}
 
 	sem_schedulerStart = new LightweightSemaphore(0);
+	eventsQueue = EventQueue::create(SCHEDULER_QUEUE_QUATERNARY_HEAP);
 }
 
 Scheduler::~Scheduler() {
 	OUTPUT << "Scheduler destructor" << endl;
 	removeKeywords();
-	if (schedulerThread)
-		delete schedulerThread;
+	joinSchedulerThread();
+	delete schedulerThread;
 	delete sem_schedulerStart;
+	delete parallelEngine;
+	delete eventTrace;
+	delete statsSeries;
+	delete eventsQueue;
 }
 
-bool Scheduler::schedule(Event *ev) {
+void Scheduler::setEventQueue(int type) {
+	EventQueue *newQueue = EventQueue::create(type);
+	if (newQueue == NULL) {
+		ERRPUT << "\033[1;31m" << "ERROR : Unknown event queue type " << type << "\033[0m" << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	lock();
+	while (!eventsQueue->empty()) {
+		newQueue->push(eventsQueue->pop());
+	}
+	delete eventsQueue;
+	eventsQueue = newQueue;
+	unlock();
+
+	OUTPUT << "Scheduler: using " << eventsQueue->getName() << " event queue" << endl;
+}
+
+void Scheduler::setStatsTimeSeries(StatsTimeSeries *series) {
+	delete statsSeries;
+	statsSeries = series;
+}
+
+void Scheduler::setEventTrace(EventTrace *trace) {
+	delete eventTrace;
+	eventTrace = trace;
+}
+
+void Scheduler::setParallelism(unsigned int nbThreads, int type) {
+	delete parallelEngine;
+	parallelEngine = NULL;
+	if (nbThreads > 1) {
+		parallelEngine = ParallelEngine::create(type, this, nbThreads);
+		if (parallelEngine == NULL) {
+			ERRPUT << "\033[1;31m" << "ERROR : Unknown parallel engine type " << type << "\033[0m" << endl;
+			exit(EXIT_FAILURE);
+		}
+		OUTPUT << "Scheduler: using " << parallelEngine->getName() << " parallel engine with " << nbThreads << " threads" << endl;
+	}
+}
+
+EventHandle Scheduler::scheduleCancellable(Event *ev) {
 	assert(ev != NULL);
-	stringstream info;
+	EventPtr pev = makeEventPtr(ev);
+	EventHandle handle(pev);
+	return scheduleEvent(std::move(pev)) ? handle : EventHandle();
+}
 
-	EventPtr pev(ev);
+bool Scheduler::scheduleEvent(EventPtr pev) {
+	stringstream info;
 
-	static bool possibleOverflow = false;
-	static bool tooLate = false;
+	static atomic<bool> possibleOverflow(false);
+	static atomic<bool> tooLate(false);
 	/*info << "Schedule a " << pev->getEventName() << " (" << ev->id << ")";
 	trace(info.str());*/
 
-	if (pev->date < Scheduler::currentDate) {
+	if (pev->date < now()) {
 	        if (!possibleOverflow) {
 	            cerr << "WARNING: Attempt to schedule an event in the past (possible overflow detected?)!" << endl;
 	            possibleOverflow = true;
 	        }
 		OUTPUT << "ERROR : An event cannot be scheduled in the past !\n";
-		OUTPUT << "current time : " << Scheduler::currentDate << endl;
+		OUTPUT << "current time : " << now() << endl;
 		OUTPUT << "ev->eventDate : " << pev->date << endl;
 		OUTPUT << "ev->getEventName() : " << pev->getEventName() << endl;
-		return(false);
+		return false;
 	}
 
 	if (pev->date > maximumDate) {
@@ -81,58 +137,451 @@ bool Scheduler::schedule(Event *ev) {
 		OUTPUT << "WARNING : An event should not be scheduled beyond the end of simulation date !\n";
 		OUTPUT << "pev->date : " << pev->date << endl;
 		OUTPUT << "maximumDate : " << maximumDate << endl;
-		return(false);
+		return false;
+	}
+
+	// Events scheduled by the workers of a parallel engine are handled by the engine
+	if (parallelSection && parallelEngine->schedule(pev)) {
+		return true;
+	}
+
+	if (singleProducer) {
+		if (this_thread::get_id() == producerThread) {
+			insertEvent(std::move(pev));
+		} else {
+			inbox.push(std::move(pev));
+			wakeUp();
+		}
+		return true;
 	}
 
 	lock();
 
-	eventsMap.insert(pair<Time, EventPtr>(pev->date,pev));
+	insertEvent(std::move(pev));
+	bool waiting = waitingForEvents;
+
+	unlock();
+
+	if (waiting) {
+		eventsAvailable.notify_one();
+	}
+
+	return true;
+}
+
+void Scheduler::acquireEventList() {
+	if (singleProducer) {
+		producerThread = this_thread::get_id();
+		drainInbox();
+	}
+}
 
-	eventsMapSize++;
+bool Scheduler::cancel(const EventHandle &h) {
+	EventPtr pev = h.lock();
+	if (!pev || pev->cancelled) return false;
 
-	StatsCollector::getInstance().updateLargestEventsQueueSize(eventsMapSize);
+	// Events held by a parallel engine, or cancelled by one of its workers
+	if (parallelEngine && (parallelSection || !pev->queued)) {
+		return parallelEngine->cancel(pev);
+	}
 
+	// Events scheduled by other threads in single-producer mode are only queued once transferred from the inbox
+	lock();
+	drainInbox();
+	bool found = pev->queued;
+	if (found) {
+		eventsQueue->cancel(pev.get());
+	} else {
+		// Events extracted with the current batch, not processed yet
+		for (size_t i = batchNext; i < batch.size(); i++) {
+			if (batch[i] == pev) {
+				pev->cancelled = true;
+				found = true;
+				break;
+			}
+		}
+	}
+	if (found) {
+		eventsMapSize--;
+	}
 	unlock();
+	return found;
+}
+
+void Scheduler::run() {
+	state = RUNNING;
+	acquireEventList();
+
+	auto systemStartTime = chrono::steady_clock::now();
+	if (statsSeries) {
+		statsSeries->start(currentDate);
+	}
+	cout << "\033[1;33m" << "Scheduler : start order received " << 0 << "\033[0m" << endl;
+
+	switch (schedulerMode) {
+		case SCHEDULER_MODE_FASTEST:
+			if (!runFastest()) {
+				break;
+			}
+
+			// Warm start over, continue in realtime mode without restarting
+			cout << "\033[1;33m" << "Scheduler : warm start over at date " << currentDate << " ("
+				 << StatsCollector::getInstance().getEventsCount() << " events), switching to realtime mode"
+				 << "\033[0m" << endl;
+			schedulerMode = SCHEDULER_MODE_REALTIME;
+			// fall through
+		case SCHEDULER_MODE_REALTIME:
+			runRealtime();
+			break;
+		default:
+			cout << "ERROR : Scheduler mode not recognized !!" << endl;
+	}
+
+	auto elapsedTime = chrono::steady_clock::now() - systemStartTime;
+
+	if (statsSeries) {
+		statsSeries->finish(currentDate, eventsMapSize);
+	}
+	if (eventTrace) {
+		try {
+			eventTrace->finish();
+		} catch (EventTraceException &e) {
+			cerr << "error: event trace: " << e.what() << endl;
+		}
+	}
+
+	cout << "\033[1;33m" << "Scheduler end : " << chrono::duration_cast<chrono::microseconds>(elapsedTime).count() << "\033[0m" << endl;
+
+	StatsCollector::getInstance().updateElapsedTime(currentDate, chrono::duration_cast<chrono::microseconds>(elapsedTime).count());
+	StatsCollector::getInstance().setLivingCounters(Event::getNbLivingEvents(), Message::getNbMessages());
+	StatsCollector::getInstance().setEndEventsQueueSize(eventsQueue->size());
+
+	// if simulation is a regression testing run, export configuration before leaving
+	if (Simulator::isRegrTesting() && !terminate.load())
+		getWorld()->exportConfiguration();
 
-	return(true);
+	// if autoStop is enabled, terminate simulation
+	if (willAutoStop() && !terminate.load()) {
+		glutLeaveMainLoop();
+	}
+
+	printStats();
+}
+
+bool Scheduler::runFastest() {
+	bool warmStartEnded = false;
+
+	if (parallelEngine) {
+		if (!parallelEngine->canProcess()) {
+			setParallelism(parallelEngine->getNbWorkers(), PARALLEL_ENGINE_CONSERVATIVE);
+		}
+		parallelEngine->start();
+	}
+
+	while (!terminate.load() && state != ENDED) {
+		// Check that we have not reached the maximum simulation date, if there is one
+		if (currentDate > maximumDate) {
+			cout << "\033[1;33m" << "Scheduler : maximum simulation date (" << maximumDate
+				 << ") has been reached. Terminating..." << "\033[0m" << endl;
+			break;
+		}
+
+		drainInbox();
+		pollExternal();
+
+		if (warmStart && warmStartOver()) {
+			warmStartEnded = true;
+			break;
+		}
+
+		if (!hasPendingEvents()) {
+			if (idle()) continue;
+			break;
+		}
+
+		if (checkpointDate != TIME_MAX && eventsQueue->top()->date >= checkpointDate) {
+			saveCheckpoint();
+		}
+
+		if (parallelEngine) {
+			// Processes a window or a round of events concurrently, or a single event
+			parallelEngine->step();
+		} else {
+			// All the events of the current date at once, without going back to the event list
+			processBatch();
+		}
+
+		pauseIfRequested();
+	}
+
+	if (parallelEngine) {
+		parallelEngine->stop();
+	}
+
+	return warmStartEnded;
+}
+
+void Scheduler::runRealtime() {
+	cout << "Realtime mode scheduler (speed x" << realtimeSpeed << ")\n";
+	startRealtimeClock();
+	// Sleeps until the next date is due, then dispatches all its events at once
+	while (waitForRealtimeEvent()) {
+		processBatch();
+	}
+}
+
+void Scheduler::processBatch() {
+	waitForDispatch();
+	if (batchDispatch) {
+		eventsQueue->popBatch(batch);
+		StatsCollector::getInstance().addBatch(batch.size());
+	} else {
+		batch.push_back(eventsQueue->pop());
+	}
+	currentDate = batch.front()->date;
+	if (statsSeries && currentDate >= statsSeries->getNextDate()) {
+		statsSeries->sample(currentDate, eventsMapSize);
+	}
+
+	EventProfiler &profiler = EventProfiler::getInstance();
+	bool timed = profiler.enable || StatsIndividual::isEnabled();
+	batchNext = 0;
+	while (batchNext < batch.size()) {
+		EventPtr pev = std::move(batch[batchNext++]);
+		if (pev->cancelled) continue;
+		if (eventTrace && !traceEvent(pev.get())) {
+			// Diverged from the recorded trace: stops before processing the event
+			batch[--batchNext] = std::move(pev);
+			state = ENDED;
+			break;
+		}
+		if (timed) {
+			BuildingBlock *bb = pev->getConcernedBlock();
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			pev->consume();
+			uint64_t ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+			if (profiler.enable) {
+				profiler.record(pev->eventType, [&pev]() { return pev->getEventName(); }, ns);
+			}
+			if (bb) {
+				StatsIndividual::incEventCount(bb->stats, ns);
+			}
+		} else {
+			pev->consume();
+		}
+		StatsCollector::getInstance().incEventsCount();
+		eventsMapSize--;
+
+		if (terminate.load()) break;
+	}
+	if (batchNext < batch.size()) {
+		// Stopped early: the events left go back to the event list, in which they are still counted and can be cancelled
+		if (!singleProducer) lock();
+		for (size_t i = batchNext; i < batch.size(); i++) {
+			if (!batch[i]->cancelled) eventsQueue->push(std::move(batch[i]));
+		}
+		if (!singleProducer) unlock();
+	}
+	batch.clear();
+	batchNext = 0;
+}
+
+bool Scheduler::traceEvent(Event *pev) {
+	try {
+		return eventTrace->process(pev);
+	} catch (EventTraceException &e) {
+		cerr << "error: event trace disabled: " << e.what() << endl;
+		delete eventTrace;
+		eventTrace = NULL;
+		return true;
+	}
+}
+
+void Scheduler::saveCheckpoint() {
+	checkpointDate = TIME_MAX;
+	try {
+		Checkpoint::save(checkpointFile);
+		cout << "\033[1;33m" << "Scheduler : checkpoint saved to " << checkpointFile << " at date " << currentDate
+			 << "\033[0m" << endl;
+	} catch (CheckpointException &e) {
+		cerr << "error: checkpoint not saved: " << e.what() << endl;
+	}
+}
+
+void Scheduler::checkpoint(CheckpointArchive &a) {
+	vector<EventPtr> events;
+
+	// The event list cannot be iterated: empty it, and push the events back in the same order
+	lock();
+	drainInbox();
+	while (!eventsQueue->empty()) {
+		events.push_back(eventsQueue->pop());
+	}
+	try {
+		a & currentDate & events;
+	} catch (CheckpointException&) {
+		if (a.isLoading()) events.clear();
+		for (EventPtr &pev : events) eventsQueue->push(std::move(pev));
+		unlock();
+		throw;
+	}
+	for (EventPtr &pev : events) eventsQueue->push(std::move(pev));
+	eventsMapSize = eventsQueue->size();
+	unlock();
+}
+
+bool Scheduler::warmStartOver() {
+	// Nothing left to fast-forward through: wait for new events in realtime
+	if (eventsQueue->empty()) return true;
+	if (eventsQueue->top()->date >= warmStartDate) return true;
+	if (warmStartEvents && StatsCollector::getInstance().getEventsCount() >= warmStartEvents) return true;
+	return warmStartCondition && warmStartCondition();
+}
+
+void Scheduler::startRealtimeClock() {
+	lock();
+	realtimeOrigin = chrono::steady_clock::now();
+	realtimeOriginDate = currentDate;
+	realtimeLag = 0;
+	unlock();
+}
+
+bool Scheduler::waitForRealtimeEvent() {
+	for (;;) {
+		if (terminate.load() || state == ENDED) return false;
+
+		if (pauseIfRequested()) {
+			// Resume from the date reached before the pause
+			startRealtimeClock();
+		}
+		pollExternal();
+
+		unique_lock<mutex> guard(mutex_schedule);
+		drainInbox();
+		if (eventsQueue->empty()) {
+			guard.unlock();
+			if (!idle()) return false;
+			continue;
+		}
+
+		chrono::steady_clock::time_point due = realtimeDueTime(eventsQueue->top()->date);
+		chrono::steady_clock::time_point t = chrono::steady_clock::now();
+		if (t >= due) {
+			realtimeLag = chrono::duration_cast<chrono::microseconds>(t - due).count();
+			StatsCollector::getInstance().addRealtimeLag(realtimeLag);
+			return true;
+		}
+
+		if (externalPollPeriod > 0) {
+			due = min(due, t + chrono::microseconds(externalPollPeriod));
+		}
+		waitingForEvents = true;
+		eventsAvailable.wait_until(guard, due);
+		waitingForEvents = false;
+	}
+}
+
+Time Scheduler::realtimeDate() {
+	lock_guard<mutex> guard(mutex_schedule);
+	chrono::steady_clock::time_point t = chrono::steady_clock::now();
+	if (t <= realtimeOrigin) return realtimeOriginDate;
+	return realtimeOriginDate + (Time)(chrono::duration_cast<chrono::microseconds>(t - realtimeOrigin).count() * realtimeSpeed);
+}
+
+bool Scheduler::idle() {
+	if (schedulerLength != SCHEDULER_LENGTH_INFINITE) return false;
+
+	// Sleep until another thread schedules an event, or the scheduler is instructed to terminate
+	unique_lock<mutex> guard(mutex_schedule);
+	drainInbox();
+	while (eventsQueue->empty() && !terminate.load()) {
+		waitingForEvents = true;
+		eventsAvailable.wait(guard);
+		waitingForEvents = false;
+		drainInbox();
+	}
+	return true;
+}
+
+void Scheduler::wakeUp() {
+	// Taking the lock ensures that the scheduler thread is either waiting, or has not checked its wake up conditions yet
+	mutex_schedule.lock();
+	mutex_schedule.unlock();
+	eventsAvailable.notify_all();
+}
+
+void Scheduler::setRealtimeSpeed(double speed) {
+	assert(speed > 0);
+	lock();
+	// Keep the simulated date reached so far by the realtime clock, and continue from there at the new pace
+	chrono::steady_clock::time_point t = chrono::steady_clock::now();
+	if (t > realtimeOrigin) {
+		realtimeOriginDate += (Time)(chrono::duration_cast<chrono::microseconds>(t - realtimeOrigin).count() * realtimeSpeed);
+	}
+	realtimeOrigin = t;
+	realtimeSpeed = speed;
+	unlock();
+	eventsAvailable.notify_all();
 }
 
 void Scheduler::removeEventsToBlock(BuildingBlock *bb) {
 	lock();
-	multimap<Time,EventPtr>::iterator im = eventsMap.begin();
-	BuildingBlock *cb=NULL;
-	OUTPUT << bb << endl;
-	while (im!=eventsMap.end()) {
-		cb=(*im).second->getConcernedBlock();
-		OUTPUT << cb << endl;
-		if (cb==bb) {
-			multimap<Time,EventPtr>::iterator im2 = im;
-			if(im != eventsMap.begin()) {
-				im--;
-				eventsMap.erase(im2);
-			} else {
-				eventsMap.erase(im2);
-				im = eventsMap.begin();
-			}
-		} else im++;
+	drainInbox();
+	eventsMapSize -= eventsQueue->removeEventsOf(bb);
+	for (size_t i = batchNext; i < batch.size(); i++) {
+		if (!batch[i]->cancelled && batch[i]->getConcernedBlock() == bb) {
+			batch[i]->cancelled = true;
+			eventsMapSize--;
+		}
 	}
 	unlock();
 }
 
 void Scheduler::trace(string message, bID id,const Color &color) {
-	if (GlutContext::GUIisEnabled) {
-		mutex_trace.lock();
+	ostringstream line;
+	line.precision(6);
+	line << fixed << (double)(now())/1000000 << " #" << id << ": " << message << endl;
+	// Traces of speculative events are printed once committed, rolled back events print nothing
+	if (parallelSection && parallelEngine->holdTrace(line.str())) return;
+
+	// Traces can be emitted concurrently by the workers of a parallel engine
+	lock_guard<mutex> lock(mutex_trace);
+
+	if (GlutContext::isGUIEnabled()) {
 		GlutContext::addTrace(message,id,color);
-		mutex_trace.unlock();
 	}
-	
-	OUTPUT.precision(6);
-	OUTPUT << fixed << (double)(currentDate)/1000000 << " #" << id << ": " << message << endl;
+	OUTPUT << line.str();
+}
+
+void Scheduler::printTrace(const string &lines) {
+	lock_guard<mutex> lock(mutex_trace);
+	OUTPUT << lines;
 }
 
 void Scheduler::start(int mode) {   
-	scheduler->schedulerMode = mode;
-	scheduler->sem_schedulerStart->signal();	
+	schedulerMode = mode;
+	sem_schedulerStart->signal();	
+}
+
+void Scheduler::runInCallingThread() {
+	run();
+	terminate.store(true);
+}
+
+void Scheduler::cancelStart() {
+	state = ENDED;
+	sem_schedulerStart->signal();
+	joinSchedulerThread();
+}
+
+void Scheduler::joinSchedulerThread() {
+	if (schedulerThread && schedulerThread->joinable()) {
+		if (schedulerThread->get_id() == this_thread::get_id()) {
+			schedulerThread->detach();
+		} else {
+			schedulerThread->join();
+		}
+	}
 }
 
 void Scheduler::stop(Time date) {
@@ -194,8 +643,16 @@ bool Scheduler::debug(const string &command,bID &id,string &result) {
 
 void Scheduler::printStats() {
   cout << StatsCollector::getInstance();
-  if (StatsIndividual::enable) {
+  if (StatsIndividual::isEnabled()) {
     cout << StatsIndividual::getStats();
+    cout << StatsIndividual::getHotspots(STATS_INDIVIDUAL_HOTSPOTS);
+  }
+  EventProfiler &profiler = EventProfiler::getInstance();
+  if (profiler.enable) {
+    cout << profiler;
+    if (!profiler.csvFile.empty() && !profiler.writeCSV(profiler.csvFile)) {
+      cerr << "error: cannot write event profile to " << profiler.csvFile << endl;
+    }
   }
 }
 
@@ -16,18 +16,26 @@
 #include <thread>
 #include <functional>
 #include <mutex>
+#include <chrono>
+#include <condition_variable>
 
 #include "sema.h"
 #include "events.h"
+#include "simulationContext.h"
+#include "eventQueue.h"
+#include "mpscQueue.h"
+#include "parallelEngine.h"
 #include "statsCollector.h"
 
 using namespace std;
 
 // Scheduler execution modes (defines the pace at which the event list is processed)
 #define SCHEDULER_MODE_FASTEST		1 //!< Execute events as fast as possible. (Default in terminal mode)
-#define SCHEDULER_MODE_REALTIME		2 //!< Execute events in a realistic fashion. Sleep for a while after processing an event, so that execution can be analysed in the graphical window. 
+#define SCHEDULER_MODE_REALTIME		2 //!< Execute events in a realistic fashion. Sleep until the date of the next event is reached by the wall clock (scaled by the realtime speed), so that execution can be analysed in the graphical window.
 #define SCHEDULER_MODE_DEBUG		3 //!< Debugger mode, execute events in steps. Not Implemented Yet!
 
+#define SCHEDULER_REALTIME_SPEED_DEFAULT	1.0 //!< Default pace of the realtime mode, in simulated seconds per second of wall-clock time
+
 // Scheduler termination modes (defines the conditions for the scheduler to terminate)
 #define SCHEDULER_LENGTH_DEFAULT		1 //!< Scheduler stops when all events have been processed. (Or when maximum possible date for time type is reached)
 #define SCHEDULER_LENGTH_BOUNDED		2 //!< Scheduler stops when all events have been processed OR when a specific date (deadline) has been reached
@@ -35,6 +43,9 @@ using namespace std;
 
 namespace BaseSimulator {
 
+class EventTrace;
+namespace utils { class StatsTimeSeries; }
+
 //!< A keyword for the debugger (incomplete feature)
 class Keyword {
 public :
@@ -55,23 +66,55 @@ template <typename T> class KeywordT:public Keyword {
  *  Scheduler is executed on a separate thread 
  */
 class Scheduler {
+	friend class ConservativeEngine;
+	friend class TimeWarpEngine;
 protected:
-	static Scheduler *scheduler; //!< Static pointer to the single scheduler instance
+	SimulationContext *context; //!< Simulation of the scheduler, to which the threads it creates are bound
 	static std::mutex delMutex; //!< Static mutex used to ensure non-concurrent deletion of the instance of the scheduler
 	int schedulerMode; //!< Execution mode of the scheduler (1: Fastest, 2: Realtime, 3: Debug)
 	int schedulerLength; //!< Termination mode of the scheduler (1:Default, 2: Bounded, 3: Infinite)
 	LightweightSemaphore *sem_schedulerStart; //!< Semaphore used to synchronise scheduler thread start
-	std::thread *schedulerThread; //!< Thread for scheduler execution
+	std::thread *schedulerThread = NULL; //!< Thread for scheduler execution, joined and deleted by the thread owning the scheduler (see joinSchedulerThread)
 	vector <Keyword*> tabKeywords; //!< Collection of keywords for debugging (incomplete feature)
 
 	Time currentDate = 0; //!< Current discrete date of the scheduler in (us)
 	Time maximumDate = TIME_MAX; //!< Maximum possible date that the scheduler can reach before it terminates (Defaults to maximum value for discrette time type)
-	multimap<Time,EventPtr> eventsMap; //!< Collection of event lists indexed by date
+	EventQueue *eventsQueue; //!< Pending events, ordered by date (see EventQueue)
 	int eventsMapSize = 0; //!< Number of events in the event list
 	int largestEventsMapSize = 0; //!< Maximum size that the event list has reached during current simulation
 	std::mutex mutex_schedule;	  //!< Mutex to ensure mutual exclusion during event list modification
 	std::mutex mutex_trace;		  //!< Mutex to ensure mutual exclusion of trace buffer modification
 
+	bool singleProducer = false; //!< If true, the event list is only modified by the scheduler thread, without locking (see setSingleProducer)
+	std::thread::id producerThread; //!< Thread allowed to modify the event list directly in single-producer mode
+	MPSCQueue<EventPtr> inbox; //!< Events scheduled by other threads in single-producer mode, waiting to be transferred into the event list
+
+	bool batchDispatch = true; //!< If false, events are extracted from the event list one at a time, instead of one date at a time (see processBatch)
+	Time externalPollPeriod = 0; //!< Maximum delay (us) between two calls to pollExternal while waiting in realtime mode, 0 if there is nothing to poll
+	vector<EventPtr> batch; //!< Events of the current date, extracted at once from the event list and being dispatched (see EventQueue::popBatch)
+	size_t batchNext = 0; //!< Index in batch of the next event to dispatch
+
+	double realtimeSpeed = SCHEDULER_REALTIME_SPEED_DEFAULT; //!< Pace of the realtime mode, in simulated seconds per second of wall-clock time (see setRealtimeSpeed)
+	std::chrono::steady_clock::time_point realtimeOrigin; //!< Wall-clock time at which the realtime mode was at date realtimeOriginDate
+	Time realtimeOriginDate = 0; //!< Simulated date at which the realtime clock has been (re)started
+	Time realtimeLag = 0; //!< Delay (us, wall-clock) of the last events dispatched in realtime mode, relatively to their due time
+	std::condition_variable eventsAvailable; //!< Wakes up the scheduler thread waiting for the next event date in realtime mode, or for new events when idle
+	bool waitingForEvents = false; //!< True while the scheduler thread waits on eventsAvailable, protected by mutex_schedule
+
+	bool warmStart = false; //!< If true, the fastest mode switches to the realtime mode once the warm start is over (see setWarmStartDate)
+	Time warmStartDate = TIME_MAX; //!< The warm start is over when the next event reaches this date
+	uint64_t warmStartEvents = 0; //!< The warm start is over when this number of events has been processed (0 for no limit)
+	std::function<bool()> warmStartCondition; //!< The warm start is over when this predicate returns true (none by default)
+
+	Time checkpointDate = TIME_MAX; //!< The state of the simulation is saved once the next event reaches this date (see setCheckpoint)
+	string checkpointFile; //!< File into which the state of the simulation is saved
+
+	EventTrace *eventTrace = NULL; //!< Trace recording or verifying the processed events, NULL if disabled (see setEventTrace)
+	utils::StatsTimeSeries *statsSeries = NULL; //!< Periodic snapshots of the statistics, NULL if disabled (see setStatsTimeSeries)
+
+	ParallelEngine *parallelEngine = NULL; //!< Engine processing events on several threads, NULL for a sequential execution (see setParallelism)
+	bool parallelSection = false; //!< True while workers of the parallel engine are processing events concurrently
+
 	bool autoStart = false;		//!< Indicates if the scheduler has to wait for user input to start (false = yes, true = no)
 	bool autoStop = false;		//!< Indicates if the simulation has to terminate at scheduler end (Graphical window closes if true)
 	
@@ -79,6 +122,135 @@ class Scheduler {
 	virtual ~Scheduler();
 
 	Time debugDate; //!< Current date of debugger (incomplete feature)
+
+	/**
+	 * @brief Adds pev to the event list, or ignores it (see schedule)
+	 * @return true if the event has been added to the event list, false otherwise
+	 */
+	virtual bool scheduleEvent(EventPtr pev);
+
+	/**
+	 * @brief Inserts pev into the event list and updates the queue size statistics. Caller must own the event list
+	 *  Events cancelled before reaching the event list (see cancel) are dropped.
+	 */
+	inline void insertEvent(EventPtr pev) {
+		if (pev->cancelled) return;
+		eventsQueue->push(std::move(pev));
+		eventsMapSize++;
+		utils::StatsCollector::getInstance().updateLargestEventsQueueSize(eventsMapSize);
+	}
+
+	/**
+	 * @brief Marks the calling thread as the only producer of the event list (single-producer mode only),
+	 *  and transfers the events scheduled beforehand by other threads. Must be called by the scheduler thread
+	 *  before it starts processing events.
+	 */
+	void acquireEventList();
+
+	/**
+	 * @brief Dispatch loop shared by all schedulers, to be called by the scheduler thread once the start order has been
+	 *  received. Processes events according to Scheduler::schedulerMode until a termination condition is reached,
+	 *  then collects and prints the simulation statistics. Simulation-specific parts are delegated to the strategy
+	 *  hooks below (pollExternal, waitForDispatch, idle and waitWhilePaused).
+	 */
+	void run();
+
+	/**
+	 * @brief Fastest mode: processes events without waiting, until a termination condition is reached
+	 * @return true if the loop ended because the warm start is over (see setWarmStartDate)
+	 */
+	bool runFastest();
+
+	//!< @brief Realtime mode: processes events when the wall clock reaches their date, until a termination condition is reached
+	void runRealtime();
+
+	/**
+	 * @brief Extracts the events of the earliest date from the event list, and processes them in order
+	 *  Events of the batch that are cancelled before being processed are skipped (see cancel). Stops early if the
+	 *  scheduler has been instructed to terminate, or if the event trace diverges, and puts the events left back in
+	 *  the event list. Extracts a single event if batchDispatch is false.
+	 */
+	void processBatch();
+
+	//!< @brief Strategy hook, called between two dates to process inputs received from outside of the scheduler (VM commands for instance)
+	virtual void pollExternal() {}
+
+	//!< @brief Strategy hook, called before extracting the next events from the non-empty event list. May block until
+	//!<  external components are ready to process them, and schedule new events meanwhile
+	virtual void waitForDispatch() {}
+
+	/**
+	 * @brief Strategy hook, called when no event is pending
+	 *  By default, sleeps until another thread schedules an event in infinite termination mode, and stops the
+	 *  scheduler otherwise.
+	 * @return true if the scheduler keeps running, false if it has to stop
+	 */
+	virtual bool idle();
+
+	//!< @brief Strategy hook, called while state is PAUSED, returns when the simulation can be resumed. Waits for a
+	//!<  new start order by default
+	virtual void waitWhilePaused() { sem_schedulerStart->wait(); }
+
+	//!< @brief Suspends the scheduler if a pause has been requested (see waitWhilePaused)
+	//!< @return true if the scheduler has been paused
+	inline bool pauseIfRequested() {
+		if (state != PAUSED) return false;
+		waitWhilePaused();
+		setState(RUNNING);
+		return true;
+	}
+
+	//!< @brief Starts the realtime clock: the current date is reached now, following dates at realtimeSpeed
+	void startRealtimeClock();
+
+	/**
+	 * @brief Realtime mode: sleeps until the wall clock reaches the due time of the earliest event, without polling
+	 *  The scheduler thread is woken up early when an event is scheduled by another thread (which may be due sooner),
+	 *  when the speed changes, or when the scheduler is instructed to terminate, and every externalPollPeriod if
+	 *  needed. Handles pause requests and empty event lists (see idle). Records the lag of the earliest event
+	 *  relatively to its due time (see StatsCollector::addRealtimeLag).
+	 * @return true if the earliest event is due, false if the scheduler has to stop (terminated, or no more events)
+	 */
+	bool waitForRealtimeEvent();
+
+	//!< @brief Returns the date reached by the realtime clock (realtime mode only)
+	Time realtimeDate();
+
+	//!< @brief Wakes up the scheduler thread if it is waiting for the next event in realtime mode, or for new events
+	void wakeUp();
+
+	//!< @brief Returns the wall-clock time at which an event of the given date is due in realtime mode. Caller must hold mutex_schedule
+	inline std::chrono::steady_clock::time_point realtimeDueTime(Time date) {
+		Time delta = date > realtimeOriginDate ? date - realtimeOriginDate : 0;
+		return realtimeOrigin + std::chrono::microseconds((Time)(delta / realtimeSpeed));
+	}
+
+	/**
+	 * @brief Checks the warm start criteria before processing the next date in fastest mode
+	 * @return true if the warm start is over: a criterion has been met (see setWarmStartDate, setWarmStartEvents and
+	 *  setWarmStartCondition), or there is no pending event left to fast-forward through
+	 */
+	bool warmStartOver();
+
+	//!< @brief Saves the state of the simulation into checkpointFile, reports and ignores failures (see Checkpoint::save)
+	void saveCheckpoint();
+
+	/**
+	 * @brief Records pev into the event trace, or compares it with the trace (see EventTrace::process). Reports
+	 *  trace errors, after which the trace is disabled
+	 * @return false if the simulation has diverged from the trace
+	 */
+	bool traceEvent(Event *pev);
+
+	/**
+	 * @brief Transfers events scheduled by other threads into the event list (single-producer mode only). Outside of
+	 *  the main loop of the scheduler thread, must be called under Scheduler::mutex_schedule
+	 */
+	inline void drainInbox() {
+		if (!inbox.empty()) {
+			inbox.consumeAll([this](EventPtr &&pev) { insertEvent(std::move(pev)); });
+		}
+	}
 public:
 	//!< Defines possible states of the scheduler
 	enum State {
@@ -91,14 +263,16 @@ class Scheduler {
 	State state;				//!< Current state of the scheduler accoring to the State enum
 	atomic<bool> terminate{false}; //!< Indicates if the scheduler has been instructed to terminate. Atomic value used for synchronising deletion of the scheduler and other simulation components. If terminate equals true, it means that other components are waiting for the scheduler to terminate before they can be deleted. Scheduler will finish processing current event and terminate.
 
-	//!< @brief Static getter for the global instance of Scheduler
+	//!< @brief Static getter for the instance of Scheduler of the simulation of the calling thread
 	static Scheduler* getScheduler() {
+		Scheduler *scheduler = SimulationContext::current().scheduler;
 		assert(scheduler != NULL);
 		return(scheduler);
 	}
 
 	//!< @brief Global function for triggering scheduler deletion (Takes a bit of synchronisation, see Scheduler::terminate)
 	static void deleteScheduler() {
+		Scheduler *&scheduler = SimulationContext::current().scheduler;
 		// Ensure Scheduler has not been deleted yet
 		if (scheduler != NULL) {
 			// Take the deletion lock
@@ -108,6 +282,7 @@ class Scheduler {
 				// If scheduler is not yet in termination mode (means it is still running), instruct it to terminate
 				if (!scheduler->terminate.load()) {
 					scheduler->terminate.store(true);
+					scheduler->wakeUp();
 
 					// In case scheduler thread if waiting on semaphore before start, release it
 					if (scheduler->state == NOTSTARTED) {
@@ -116,7 +291,7 @@ class Scheduler {
 					}					   
 						
 					// Wait until scheduler termination
-					scheduler->schedulerThread->join();
+					scheduler->joinSchedulerThread();
 				}
 
 				// Scheduler can now be safely deleted
@@ -151,6 +326,92 @@ class Scheduler {
 	//!< @brief Getter for Scheduler::schedulerMode
 	inline int getSchedulerMode() { return schedulerMode; }
 
+	/**
+	 * @brief Selects the data structure used for storing pending events
+	 * @param type one of the SCHEDULER_QUEUE_* constants (see eventQueue.h)
+	 *  Events that are already scheduled are transferred to the new queue, in the same order.
+	 */
+	void setEventQueue(int type);
+	//!< @brief Getter for Scheduler::eventsQueue
+	inline EventQueue *getEventQueue() { return eventsQueue; }
+
+	/**
+	 * @brief Enables or disables single-producer mode.
+	 *  In single-producer mode, the scheduler thread schedules events without taking Scheduler::mutex_schedule. Events
+	 *  scheduled from any other thread (GUI for instance) are pushed to a lock-free inbox, and are transferred into
+	 *  the event list by the scheduler thread before processing the next event. Must be set before scheduler start.
+	 */
+	inline void setSingleProducer(bool sp) { singleProducer = sp; }
+	//!< @brief Getter for Scheduler::singleProducer
+	inline bool isSingleProducer() { return singleProducer; }
+
+	/**
+	 * @brief Sets the number of threads used for processing events
+	 * @param nbThreads number of threads, including the scheduler thread. 1 for a sequential execution (default)
+	 * @param type one of the PARALLEL_ENGINE_* constants, engine used with more than one thread (see parallelEngine.h)
+	 *  Only supported in terminal mode, by the CPPScheduler. Must be set before scheduler start.
+	 */
+	void setParallelism(unsigned int nbThreads, int type = PARALLEL_ENGINE_CONSERVATIVE);
+	//!< @brief Returns true if events remain to be processed, in the event list or in the parallel engine
+	inline bool hasPendingEvents() {
+		return !eventsQueue->empty() || (parallelEngine && parallelEngine->hasPendingEvents());
+	}
+	//!< @brief Getter for Scheduler::parallelEngine
+	inline ParallelEngine *getParallelEngine() { return parallelEngine; }
+
+	/**
+	 * @brief Sets the pace of the realtime mode
+	 * @param speed simulated seconds per second of wall-clock time (10 runs ten times faster than realtime), > 0
+	 *  Can be changed while the scheduler runs, the events already late remain so.
+	 */
+	void setRealtimeSpeed(double speed);
+	//!< @brief Getter for Scheduler::realtimeSpeed
+	inline double getRealtimeSpeed() { return realtimeSpeed; }
+	//!< @brief Getter for Scheduler::realtimeLag, how far behind the wall clock the realtime mode is running (us)
+	inline Time getRealtimeLag() { return realtimeLag; }
+
+	/**
+	 * @brief Warm start: the scheduler runs in fastest mode until the next event reaches date, then switches to
+	 *  the realtime mode without restarting. Must be set before scheduler start, and combined with the fastest mode.
+	 *  Several warm start criteria can be combined, the first one met ends the warm start.
+	 */
+	inline void setWarmStartDate(Time date) { warmStart = true; warmStartDate = date; }
+	//!< @brief Warm start (see setWarmStartDate) ending when nbEvents events have been processed
+	inline void setWarmStartEvents(uint64_t nbEvents) { warmStart = true; warmStartEvents = nbEvents; }
+	//!< @brief Warm start (see setWarmStartDate) ending when condition returns true, evaluated by the scheduler thread before each date
+	inline void setWarmStartCondition(std::function<bool()> condition) { warmStart = true; warmStartCondition = condition; }
+	//!< @brief Returns true if a warm start has been requested (see setWarmStartDate)
+	inline bool hasWarmStart() { return warmStart; }
+
+	/**
+	 * @brief Saves the state of the simulation into file once, in fastest mode, when the next event reaches date,
+	 *  so that the simulation can be resumed from that date (see Checkpoint). Must be set before scheduler start.
+	 *  Not supported by parallel executions.
+	 */
+	inline void setCheckpoint(Time date, const string &file) { checkpointDate = date; checkpointFile = file; }
+	//!< @brief Returns true if a checkpoint has been requested (see setCheckpoint)
+	inline bool hasCheckpoint() { return checkpointDate != TIME_MAX; }
+
+	/**
+	 * @brief Records the events processed by the scheduler into trace, or verifies them against it, and stops the
+	 *  simulation at the first divergence (see EventTrace). Takes ownership of trace. Must be set before scheduler
+	 *  start. Not supported by parallel executions.
+	 */
+	void setEventTrace(EventTrace *trace);
+
+	/**
+	 * @brief Writes periodic snapshots of the statistics during the simulation (see StatsTimeSeries). Takes ownership
+	 *  of series. Must be set before scheduler start. Not supported by parallel executions.
+	 */
+	void setStatsTimeSeries(utils::StatsTimeSeries *series);
+
+	/**
+	 * @brief Saves or restores the current date and the pending events of the scheduler (see Checkpoint)
+	 *  When restoring, the pending events are replaced by the ones of the checkpoint.
+	 * @param a archive in which the events are saved, or from which they are restored
+	 */
+	void checkpoint(CheckpointArchive &a);
+
 	//!< @brief Setter for Scheduler::autoStart
 	inline void setAutoStart(bool as) { autoStart = as; }
 	//!< @brief Getter for Scheduler::autoStart
@@ -164,16 +425,43 @@ class Scheduler {
 	/** @brief Schedule a new event ev
 	 *  @param ev event to schedule
 	 *	Adds the event to the event list corresponding to its date (ev->date), or ignore it if event date is in the past,
-	 *   or after the maximum simulation date. Event list update done in mutual exclusion.
-	 *  @return true if event has been added to the event list, false otherwise 
+	 *   or after the maximum simulation date. Event list update done in mutual exclusion, or without locking by the
+	 *   scheduler thread in single-producer mode (see setSingleProducer).
+	 *  @return true if event has been added to the event list, false otherwise
+	 */
+	inline bool schedule(Event *ev) {
+		assert(ev != NULL);
+		return scheduleEvent(makeEventPtr(ev));
+	}
+
+	/** @brief Schedule a new event ev, that can be cancelled later (see cancel)
+	 *  @param ev event to schedule
+	 *	Same as schedule, which saves the cost of the handle for the events that are never cancelled.
+	 *  @return a handle on the event, that can be used to cancel it, and converts to true if the event has been
+	 *   added to the event list, false otherwise
 	 */
-	virtual bool schedule(Event *ev);
+	EventHandle scheduleCancellable(Event *ev);
+
+	/** @brief Cancel a scheduled event
+	 *  @param h handle on the event, as returned by scheduleCancellable
+	 *	The event is marked as cancelled in O(1), and discarded when it reaches the top of the event list (see
+	 *	 EventQueue::cancel). Must be called by the scheduler thread, typically by a block code cancelling one of its
+	 *	 timers. In parallel executions, a block code can only cancel the events of its own module.
+	 *  @return true if the event was pending and has been cancelled, false if it has already been processed or cancelled
+	 */
+	bool cancel(const EventHandle &h);
 
 
 	/** @brief Return current scheduler date
-	 *  @return Scheduler::currentDate
+	 *  @return Scheduler::currentDate, or the date of the event being processed by the calling worker in parallel sections
 	 */   	
-	inline Time now() { return(currentDate); };
+	inline Time now() {
+		if (parallelSection) {
+			WorkerContext *w = ParallelEngine::getWorker();
+			if (w) return w->date;
+		}
+		return(currentDate);
+	};
 
 	/** @brief Print a block-relative colored message to the console
 	 *  @param message String to print
@@ -181,11 +469,14 @@ class Scheduler {
 	 *  @param color color of the message, WHITE by default
 	 */
 	virtual void trace(string message,bID id=0,const Color &color=WHITE);
+	//!< @brief Prints trace lines formatted by trace, held by a parallel engine until now (see ParallelEngine::holdTrace)
+	void printTrace(const string &lines);
 
 	/** @brief Remove all events relative to module bb from events list, in case of module deletion for example
 	 *  @param bb module from which the events have to be cleared
+	 *	Costs O(number of events of bb), using the index of the events of each module (see EventQueue::removeEventsOf).
 	 */
-	void removeEventsToBlock(BuildingBlock *bb);
+	virtual void removeEventsToBlock(BuildingBlock *bb);
 
 	//!< @brief Lock the event list mutex
 	inline void lock() { mutex_schedule.lock(); };
@@ -195,6 +486,16 @@ class Scheduler {
 	//!< @brief Start scheduler execution according to the specified mode	
 	virtual void start(int mode);
 
+	/**
+	 * @brief Runs the scheduler to completion in the calling thread, instead of the scheduler thread
+	 *  Used by batch worker processes, which only inherit the thread that forked them (see BatchRunner). The
+	 *  scheduler must not have been started.
+	 */
+	void runInCallingThread();
+
+	//!< @brief Terminates the scheduler thread of a scheduler that has not been started, without processing any event
+	void cancelStart();
+
 	//!< @attention Related to debugger, not completely implemented yet. (incomplete feature)
 	//!< @todo Document when debugger is implemented
 	virtual void stop(Time date);
@@ -209,6 +510,8 @@ class Scheduler {
 	inline void setState (State s) { state = s; };
 	//!< @brief Getter for scheduler state
 	inline State getState () { return state; };
+	//!< @brief Returns the simulation this scheduler belongs to
+	inline SimulationContext* getContext() { return context; };
 
 	//!< @brief Returns the number of events that have been generated
 	inline int getNbreMessages() { return Event::getNextId(); };
@@ -216,9 +519,16 @@ class Scheduler {
 	//!< @brief Used to synchronise the Scheduler thread with the graphical interface, or other simulation components
 	//!<  (destructors), to ensure that scheduler is effectively stopped before releasing memory
 	inline void waitForSchedulerEnd() {
-		schedulerThread->join();
+		joinSchedulerThread();
     }
 
+	/**
+	 * @brief Waits for the end of the scheduler thread, if it has not been joined yet. Only the thread owning the
+	 *  scheduler joins it: the scheduler thread never resets Scheduler::schedulerThread, which is deleted with the
+	 *  scheduler. Called from the scheduler thread itself, detaches it instead.
+	 */
+	void joinSchedulerThread();
+
 	//!< @attention Related to debugger, not completely implemented yet. (incomplete feature)
 	//!< @todo Document when debugger is implemented
     void addKeyword(Keyword *kw) {
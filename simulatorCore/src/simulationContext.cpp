@@ -0,0 +1,14 @@
+/*! @file simulationContext.cpp
+ * @brief Owns the state of a simulation that would otherwise be global to the process, so that several simulations
+ *  can run in the same process
+ * @date 17/10/2026
+ */
+
+#include "simulationContext.h"
+
+namespace BaseSimulator {
+
+SimulationContext SimulationContext::defaultContext;
+thread_local SimulationContext *SimulationContext::currentContext = &SimulationContext::defaultContext;
+
+} // namespace BaseSimulator
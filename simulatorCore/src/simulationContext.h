@@ -0,0 +1,96 @@
+/*! @file simulationContext.h
+ * @brief Owns the state of a simulation that would otherwise be global to the process, so that several simulations
+ *  can run in the same process
+ * @date 17/10/2026
+ */
+
+#ifndef SIMULATIONCONTEXT_H__
+#define SIMULATIONCONTEXT_H__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <fstream>
+
+#include "tDefs.h"
+#include "statsCollector.h"
+#include "eventProfiler.h"
+#include "channelModel.h"
+#include "wirelessMac.h"
+
+namespace BaseSimulator {
+
+class Simulator;
+class Scheduler;
+class World;
+
+/**
+ * @brief State of a single simulation: its simulator, scheduler and world instances, identifier counters and
+ *  statistics
+ *
+ *  Every thread is bound to a context: the default context, unless it called bind(). The static accessors of the
+ *  core (Simulator::getSimulator(), getScheduler(), getWorld(), StatsCollector::getInstance()...) return the
+ *  instances of the context of the calling thread, hence block codes, events and interfaces reach the simulation
+ *  they belong to without holding a reference to it. The threads created by a simulation (scheduler thread,
+ *  workers of a parallel engine) are bound to its context.
+ *
+ *  Several simulations can then run concurrently, one per thread, in terminal mode:
+ *  @code
+ *  std::thread t([&]() {
+ *      SimulationContext context;
+ *      context.bind();
+ *      BlinkyBlocks::createSimulator(argc, argv, MyBlockCode::buildNewBlockCode);
+ *      BaseSimulator::deleteSimulator();
+ *  });
+ *  @endcode
+ *  The command line options that would conflict between simulations (-t, -g, -i, -e, -l) are stored in the context
+ *  of the simulation that parses them. Each simulation has its own log file, but all of them open simulation.log
+ *  in the working directory: run concurrent simulations with -l from different directories. Block codes must keep
+ *  the data their modules share in userData, rather than in static variables.
+ *  @attention The graphical interface is global to the process: at most one simulation can run without -t
+ */
+class SimulationContext {
+	static thread_local SimulationContext *currentContext; //!< Context the calling thread is bound to
+	static SimulationContext defaultContext; //!< Context of the threads that did not call bind()
+public:
+	Simulator *simulator = NULL; //!< Simulator instance (see Simulator::getSimulator)
+	Scheduler *scheduler = NULL; //!< Scheduler instance (see Scheduler::getScheduler)
+	World *world = NULL; //!< World instance, owning the blocks (see World::getWorld)
+
+	bID nextBlockId = 0; //!< Identifier of the next block created without identifier
+	bool userConfigHasBeenParsed = false; //!< Indicates if the user configuration has already been parsed by blockCode->parseUserElements, which is performed once, by the first block
+	std::atomic<int> nextEventId{0}; //!< atomic, events can be created concurrently by a parallel engine
+	std::atomic<unsigned int> nbLivingEvents{0}; //!< Number of events in memory
+	std::atomic<uint64_t> nextMessageId{0}; //!< atomic, messages can be created concurrently by a parallel engine
+	std::atomic<uint64_t> nbMessages{0}; //!< Number of messages in memory
+	std::atomic<uint64_t> nextWirelessMessageId{0}; //!< Identifier of the next wireless message
+	std::atomic<uint64_t> nbWirelessMessages{0}; //!< Number of wireless messages in memory
+	unsigned int nextInterfaceId = 0; //!< Global identifier of the next network interface
+	Time propagationDelay = 0; //!< See WirelessNetworkInterface::getPropagationDelay
+	std::unique_ptr<ChannelModel> channelModel { new TwoRayChannelModel() }; //!< See WirelessNetworkInterface::getChannelModel
+	WirelessMacParameters mac; //!< See WirelessNetworkInterface::getMacParameters
+	int defaultDataRate = 1000000; //!< See NetworkInterface::getDefaultDataRate
+
+	bool guiEnabled = true; //!< See GlutContext::isGUIEnabled (option -t)
+	bool regrTesting = false; //!< See Simulator::isRegrTesting (option -g)
+	bool statsIndividual = false; //!< See utils::StatsIndividual::isEnabled (option -i)
+	std::ofstream logFile; //!< See OUTPUT (option -l)
+	std::shared_ptr<void> userData; //!< Data shared by the modules of the block code, parameters parsed from the configuration for instance (see BlockCode::parseUserElements)
+
+	utils::StatsCollector stats; //!< Global statistics (see StatsCollector::getInstance)
+	utils::EventProfiler profiler; //!< Per event type profile (see EventProfiler::getInstance)
+
+	SimulationContext() {};
+	SimulationContext(SimulationContext const&) = delete; //<! Copying a context is not allowed
+	void operator=(SimulationContext const&) = delete; //<! Copying a context is not allowed
+
+	//!< @brief Returns the context the calling thread is bound to
+	static inline SimulationContext& current() { return *currentContext; };
+
+	//!< @brief Binds the calling thread to this context, until it binds another one
+	inline void bind() { currentContext = this; };
+};
+
+} // namespace BaseSimulator
+
+#endif // SIMULATIONCONTEXT_H__
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <climits>
 #include <unordered_set>
+#include <thread>
 
 #include "trace.h"
 #include "meldInterpretVM.h"
@@ -17,6 +18,11 @@
 #include "cppScheduler.h"
 #include "openglViewer.h"
 #include "utils.h"
+#include "eventProfiler.h"
+#include "batchRunner.h"
+#include "checkpoint.h"
+#include "eventTrace.h"
+#include "statsTimeSeries.h"
 
 #ifdef ENABLE_MELDPROCESS
 #include "meldProcessVM.h"
@@ -28,26 +34,29 @@ using namespace std;
 
 namespace BaseSimulator {
 
-Simulator* simulator = NULL;
-
-Simulator* Simulator::simulator = NULL;
-
 Simulator::Type	Simulator::type = CPP; // CPP code by default
-bool Simulator::regrTesting = false; // No regression testing by default
+//!< Simulation that uses the graphical interface, which is global to the process, NULL if none
+static std::atomic<Simulator*> guiSimulator{NULL};
   
 Simulator::Simulator(int argc, char *argv[], BlockCodeBuilder _bcb): bcb(_bcb), cmdLine(argc,argv) {
 	OUTPUT << "\033[1;34m" << "Simulator constructor" << "\033[0m" << endl;
 	
 	// Ensure that only one instance of simulator is running at once
-	if (simulator == NULL) {
-		simulator = this;
-		BaseSimulator::simulator = simulator;
+	if (SimulationContext::current().simulator == NULL) {
+		SimulationContext::current().simulator = this;
 	} else {
 		ERRPUT << "\033[1;31m" << "Only one Simulator instance can be created, aborting !"
 			   << "\033[0m" << endl;
 		exit(EXIT_FAILURE);
 	}
 
+	// Concurrent simulations must run in terminal mode, but one of them
+	Simulator *none = NULL;
+	if (GlutContext::isGUIEnabled() && !guiSimulator.compare_exchange_strong(none, this)) {
+		cerr << "error: the graphical interface is already used by another simulation, use -t" << endl;
+		exit(EXIT_FAILURE);
+	}
+
 	// Ensure that the configuration file exists and is well-formed
 
 	string confFileName = cmdLine.getConfigFile();
@@ -59,8 +68,17 @@ Simulator::Simulator(int argc, char *argv[], BlockCodeBuilder _bcb): bcb(_bcb),
 	if (cmdLine.isSimulationSeedSet()) {
 	  seed = cmdLine.getSimulationSeed();
 	}
+
+	// A checkpoint is restored into the world built with the seed of the simulation that saved it (see -a in startSimulation)
+	if (cmdLine.resumeRequested()) {
+	  try {
+		seed = Checkpoint::readSeed(cmdLine.getResumeFile());
+	  } catch (CheckpointException &e) {
+		cerr << "error: cannot resume from " << cmdLine.getResumeFile() << ": " << e.what() << endl;
+		exit(EXIT_FAILURE);
+	  }
+	}
 	
-	int rseed = 0;
 	if (seed < 0) {
 	  random_device rd;
 	  mt19937 gen(rd());
@@ -93,6 +111,9 @@ Simulator::~Simulator() {
 	OUTPUT << "\033[1;34m"  << "Simulator destructor" << "\033[0m" << endl;
 	delete xmlDoc;
 
+	Simulator *self = this;
+	guiSimulator.compare_exchange_strong(self, NULL);
+
 #ifdef ENABLE_MELDPROCESS
 	if (getType() == MELDPROCESS) {
 		if(MeldProcess::MeldProcessVM::isInDebuggingMode()) {
@@ -106,6 +127,7 @@ Simulator::~Simulator() {
 }
 
 void Simulator::deleteSimulator() {
+    Simulator *&simulator = SimulationContext::current().simulator;
     delete simulator;
     simulator = NULL;
 }
@@ -138,7 +160,7 @@ void Simulator::loadScheduler(int schedulerMaxDate) {
 	
 	// Set the scheduler execution mode on start, if enabled	
 	if (sm != CMD_LINE_UNDEFINED) {
-		if (!GlutContext::GUIisEnabled && sm == SCHEDULER_MODE_REALTIME) {
+		if (!GlutContext::isGUIEnabled() && sm == SCHEDULER_MODE_REALTIME && getType() != CPP) {
 			cerr << "error: Realtime mode cannot be used when in terminal mode" << endl;
 			exit(EXIT_FAILURE);
 		}				   
@@ -147,9 +169,14 @@ void Simulator::loadScheduler(int schedulerMaxDate) {
 		scheduler->setAutoStart(true);		
 	}
 
-	if (!GlutContext::GUIisEnabled) {
+	if (!GlutContext::isGUIEnabled()) {
 		// If GUI disabled, and no mode specified, set fastest mode by default (Normally REALTIME)
-		scheduler->setSchedulerMode(SCHEDULER_MODE_FASTEST);
+		if (sm == CMD_LINE_UNDEFINED)
+			scheduler->setSchedulerMode(SCHEDULER_MODE_FASTEST);
+
+		// All events are then scheduled from the scheduler thread, event list does not need locking
+		if (getType() == CPP)
+			scheduler->setSingleProducer(true);
 	}
 	
 	// Set the scheduler termination mode
@@ -159,6 +186,110 @@ void Simulator::loadScheduler(int schedulerMaxDate) {
 	if (sl == SCHEDULER_LENGTH_BOUNDED) {
 		scheduler->setMaximumDate(cmdLine.getMaximumDate());
 	}
+
+	// Set the pace of the realtime mode
+	scheduler->setRealtimeSpeed(cmdLine.getRealtimeSpeed());
+
+	// Fast-forward in fastest mode until the warm start is over, then switch to realtime mode
+	if (cmdLine.warmStartRequested()) {
+		if (sm == SCHEDULER_MODE_FASTEST) {
+			cerr << "error: warm start (-w/-W) ends in realtime mode, and cannot be combined with -R" << endl;
+			exit(EXIT_FAILURE);
+		} else {
+			if (cmdLine.getWarmStartDate() != TIME_MAX)
+				scheduler->setWarmStartDate(cmdLine.getWarmStartDate());
+			if (cmdLine.getWarmStartEvents() != 0)
+				scheduler->setWarmStartEvents(cmdLine.getWarmStartEvents());
+			scheduler->setSchedulerMode(SCHEDULER_MODE_FASTEST);
+			scheduler->setAutoStart(true);
+		}
+	}
+
+	// Select the event queue implementation, if specified
+	if (cmdLine.getEventQueue() != CMD_LINE_UNDEFINED) {
+		if (getType() == MELDPROCESS) {
+			cerr << "warning: MeldProcess scheduler requires the map event queue, ignoring -q" << endl;
+		} else {
+			scheduler->setEventQueue(cmdLine.getEventQueue());
+		}
+	}
+
+	// Run a batch of simulations, if requested
+	if (cmdLine.batchRequested()) {
+		if (GlutContext::isGUIEnabled() || getType() == MELDPROCESS) {
+			cerr << "error: batch runs (-b) are only supported in terminal mode (-t), and not for MeldProcess" << endl;
+			exit(EXIT_FAILURE);
+		} else if (sm == SCHEDULER_MODE_REALTIME || scheduler->hasWarmStart()) {
+			cerr << "error: batch runs (-b) are run in fastest mode, and cannot be combined with -r, -w or -W" << endl;
+			exit(EXIT_FAILURE);
+		} else if (getLogFile().is_open()) {
+			cerr << "error: batch runs (-b) cannot be combined with the log file (-l)" << endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	// Save or restore checkpoints, if requested. Only the events of the core and C++ block codes can be saved
+	if (cmdLine.checkpointRequested() || cmdLine.resumeRequested()) {
+		if (getType() != CPP) {
+			cerr << "error: checkpoints (-K, -C) are only supported for C++ block codes" << endl;
+			exit(EXIT_FAILURE);
+		} else if (cmdLine.checkpointRequested() && cmdLine.getNbThreads() > 1) {
+			cerr << "error: checkpoints (-K) cannot be saved by parallel executions (-P)" << endl;
+			exit(EXIT_FAILURE);
+		} else if (cmdLine.checkpointRequested() && sm == SCHEDULER_MODE_REALTIME && !scheduler->hasWarmStart()) {
+			cerr << "error: checkpoints (-K) are saved in fastest mode, and cannot be combined with -r without warm start" << endl;
+			exit(EXIT_FAILURE);
+		} else if (cmdLine.checkpointRequested() && cmdLine.batchRequested()) {
+			cerr << "error: checkpoints (-K) cannot be saved by batch runs (-b)" << endl;
+			exit(EXIT_FAILURE);
+		}
+		if (cmdLine.checkpointRequested()) {
+			scheduler->setCheckpoint(cmdLine.getCheckpointDate(), cmdLine.getCheckpointFile());
+		}
+	}
+
+	// Record or verify the trace of the processed events, if requested. It is opened in startSimulation, once the
+	// checkpoint to resume from, if any, has set the number of events already processed
+	if (cmdLine.traceRequested() && cmdLine.batchRequested()) {
+		cerr << "error: event traces (-Y, -V) cannot be combined with batch runs (-b)" << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	// Write periodic snapshots of the statistics, if requested
+	if (cmdLine.statsTimeSeriesRequested()) {
+		if (cmdLine.batchRequested()) {
+			cerr << "error: statistics snapshots (-S) cannot be combined with batch runs (-b)" << endl;
+			exit(EXIT_FAILURE);
+		}
+		utils::StatsTimeSeries *series = new utils::StatsTimeSeries(cmdLine.getStatsPeriod(), cmdLine.getStatsFile());
+		if (!series->isOpen()) {
+			cerr << "error: cannot write statistics time series to " << cmdLine.getStatsFile() << endl;
+			exit(EXIT_FAILURE);
+		}
+		scheduler->setStatsTimeSeries(series);
+	}
+
+	// Process events on several threads, if requested
+	if (cmdLine.getNbThreads() > 1) {
+		if (GlutContext::isGUIEnabled() || getType() != CPP || sm == SCHEDULER_MODE_REALTIME
+			|| scheduler->hasWarmStart()) {
+			cerr << "warning: parallel execution is only supported for C++ block codes in terminal mode (-t), in fastest mode without warm start, ignoring -P" << endl;
+		} else if (getLogFile().is_open()) {
+			cerr << "error: parallel execution (-P) cannot be combined with the log file (-l)" << endl;
+			exit(EXIT_FAILURE);
+		} else if (utils::EventProfiler::getInstance().enable) {
+			cerr << "error: parallel execution (-P) cannot be combined with the event profiler (-e)" << endl;
+			exit(EXIT_FAILURE);
+		} else if (cmdLine.traceRequested()) {
+			cerr << "error: parallel execution (-P) cannot be combined with event traces (-Y, -V)" << endl;
+			exit(EXIT_FAILURE);
+		} else if (cmdLine.statsTimeSeriesRequested()) {
+			cerr << "error: parallel execution (-P) cannot be combined with statistics snapshots (-S)" << endl;
+			exit(EXIT_FAILURE);
+		} else {
+			scheduler->setParallelism(cmdLine.getNbThreads(), cmdLine.getParallelEngine());
+		}
+	}
 }
 
 void Simulator::parseConfiguration(int argc, char*argv[]) {
@@ -177,6 +308,7 @@ void Simulator::parseConfiguration(int argc, char*argv[]) {
 	parseBlockList();
 	parseObstacles();
 	parseTarget();
+	parseWireless();
 }
 
 Simulator::IDScheme Simulator::determineIDScheme() {
@@ -490,7 +622,7 @@ void Simulator::parseWorld(int argc, char*argv[]) {
 }
 
 void Simulator::parseCameraAndSpotlight() {
-	if (GlutContext::GUIisEnabled) {		
+	if (GlutContext::isGUIEnabled()) {		
 		// loading the camera parameters
 		TiXmlNode *nodeConfig = xmlWorldNode->FirstChild("camera");
 		if (nodeConfig) {
@@ -707,6 +839,53 @@ void Simulator::parseTarget() {
 	}
 }
 
+void Simulator::parseWireless() {
+	TiXmlNode *nodeWireless = xmlWorldNode->FirstChild("wireless");
+	TiXmlElement* element = nodeWireless ? nodeWireless->ToElement() : NULL;
+	if (element) {
+		const char *attr = element->Attribute("propagationDelay");
+		if (attr) {
+			WirelessNetworkInterface::setPropagationDelay(atoll(attr));
+			OUTPUT << "wireless propagation delay : " << WirelessNetworkInterface::getPropagationDelay() << " us" << endl;
+		}
+	}
+
+	ChannelModel *channel = ChannelModel::create(element);
+	if (channel == NULL) {
+		const char *name = element->Attribute("channel");
+		cerr << "error: unknown wireless channel model " << (name ? name : "twoRay")
+			 << " or invalid parameter, expected freeSpace, twoRay, logDistance or unitDisk" << endl;
+		exit(EXIT_FAILURE);
+	}
+	WirelessNetworkInterface::setChannelModel(channel);
+	OUTPUT << "wireless channel model : " << channel->getName() << endl;
+
+	// Medium access control, parameters that are not set keep their default value
+	WirelessMacParameters mac;
+	if (element) {
+		auto value = [element](const char *attribute, int defaultValue) {
+			const char *attr = element->Attribute(attribute);
+			return attr ? max(atoi(attr), 0) : defaultValue;
+		};
+		const char *attr = element->Attribute("ack");
+		if (attr) mac.ack = string(attr) == "true";
+		mac.slotTime = value("slotTime", mac.slotTime);
+		mac.sifs = value("sifs", mac.sifs);
+		mac.difs = value("difs", mac.difs);
+		mac.cwMin = value("cwMin", mac.cwMin);
+		mac.cwMax = value("cwMax", mac.cwMax);
+		mac.retryLimit = value("retryLimit", mac.retryLimit);
+	}
+	if (mac.slotTime == 0 || mac.cwMax < mac.cwMin) {
+		cerr << "error: invalid wireless medium access control parameters, expected slotTime > 0 and cwMin <= cwMax"
+			 << endl;
+		exit(EXIT_FAILURE);
+	}
+	WirelessNetworkInterface::setMacParameters(mac);
+	OUTPUT << "wireless medium access control : CSMA/CA, " << (mac.ack ? "with" : "without")
+		   << " acknowledgments" << endl;
+}
+
 void Simulator::parseObstacles() {
 // loading the obstacles
 	TiXmlNode *nodeObstacle = xmlWorldNode->FirstChild("obstacleList");
@@ -774,6 +953,50 @@ void Simulator::startSimulation(void) {
 	Scheduler *scheduler = getScheduler();
 	//scheduler->sem_schedulerStart->post();
 	scheduler->setState(Scheduler::NOTSTARTED);
+
+	// Resume from a checkpoint, replacing the initial events
+	if (cmdLine.resumeRequested()) {
+		try {
+			Checkpoint::load(cmdLine.getResumeFile());
+		} catch (CheckpointException &e) {
+			cerr << "error: cannot resume from " << cmdLine.getResumeFile() << ": " << e.what() << endl;
+			exit(EXIT_FAILURE);
+		}
+		cout << "\033[1;33m" << "Resumed from checkpoint " << cmdLine.getResumeFile() << " at date "
+			 << scheduler->now() << "\033[0m" << endl;
+
+		// Another seed branches a new run from the restored state
+		if (cmdLine.isSimulationSeedSet() && cmdLine.getSimulationSeed() != rseed) {
+			reseed(cmdLine.getSimulationSeed());
+			cerr << "Seed: " << rseed << endl;
+		}
+	}
+
+	// Record or verify the trace of the processed events, from the checkpoint the run resumes from, if any
+	if (cmdLine.traceRequested()) {
+		try {
+			scheduler->setEventTrace(new EventTrace(cmdLine.getTraceFile(), cmdLine.isTraceVerify(), rseed,
+													StatsCollector::getInstance().getEventsCount()));
+		} catch (EventTraceException &e) {
+			cerr << "error: " << e.what() << endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	// Run the batch of simulations with successive seeds, in worker processes, instead of the simulation itself
+	if (cmdLine.batchRequested()) {
+		int nbProcesses = cmdLine.getBatchProcesses();
+		if (nbProcesses == 0)
+			nbProcesses = max(1u, thread::hardware_concurrency());
+		BatchRunner batch(rseed, cmdLine.getBatchRuns(), nbProcesses);
+		bool success = batch.run();
+
+		scheduler->cancelStart();
+		deleteScheduler();
+		if (!success) exit(EXIT_FAILURE);
+		return;
+	}
+
 	if (scheduler->willAutoStart())
 		scheduler->start(scheduler->getSchedulerMode()); 
 
@@ -785,4 +1008,20 @@ ruint Simulator::getRandomUint() {
   return generator();
 }
 
+void Simulator::checkpoint(CheckpointArchive &a) {
+	a & generator;
+}
+
+void Simulator::reseed(int s) {
+	seed = rseed = s;
+	generator = uintRNG((ruint)rseed);
+
+	// Same draws as the blocks constructors, in order of identifier
+	for (auto &idBlock : world->getMap()) {
+		ruint blockSeed = getRandomUint();
+		blockSeed *= idBlock.first;
+		idBlock.second->reseed(blockSeed);
+	}
+}
+
 } // Simulator namespace
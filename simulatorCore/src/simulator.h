@@ -26,8 +26,6 @@ namespace BaseSimulator {
 
 class Simulator;
 
-extern Simulator *simulator;
-
 /*! @class Simulator
  *  @brief Simulator is responsible for creating and configuring the core components of simulation (i.e. World, Scheduler), by parsing the configuration file and interpreting the command line args
  *
@@ -37,10 +35,15 @@ class Simulator {
 	enum Type {CPP = 0, MELDPROCESS = 1, MELDINTERPRET = 2};
 	enum IDScheme {ORDERED = 0, MANUAL, RANDOM};
 
-	static bool regrTesting;			//!< Indicates if this simulation instance is performing regression testing
+	//!< @brief Indicates if the simulation of the calling thread is performing regression testing (option -g)
 	//!< (causes configuration export before simulator termination)
+	static inline bool isRegrTesting() { return SimulationContext::current().regrTesting; };
+	//!< @brief Enables or disables regression testing for the simulation of the calling thread
+	static void setRegrTesting(bool r) { SimulationContext::current().regrTesting = r; };
 
+	//!< @brief Returns the instance of Simulator of the simulation of the calling thread
 	static Simulator* getSimulator() {
+		Simulator *simulator = SimulationContext::current().simulator;
 		assert(simulator != NULL);
 		return(simulator);
 	}
@@ -76,6 +79,24 @@ class Simulator {
 	 */
 	ruint getRandomUint();
 
+	/*!
+	 *  @brief Re-creates the simulation and block random generators from seed, as if the simulation had been started
+	 *   with it (see BatchRunner)
+	 *
+	 *  @param s the new simulation seed
+	 */
+	void reseed(int s);
+
+	//!< @brief Returns the seed of the simulation random generator
+	inline int getSeed() { return rseed; }
+
+	/*!
+	 *  @brief Saves or restores the state of the simulation random generator (see Checkpoint)
+	 *
+	 *  @param a archive in which the state is saved, or from which it is restored
+	 */
+	void checkpoint(CheckpointArchive &a);
+
 	/*
 	 * @brief Sets the simulation seed
 	 */
@@ -92,9 +113,9 @@ class Simulator {
 	static Type type;			//!< Type of simulation, i.e. language of the user program
 
 	int seed = DEFAULT_SIMULATION_SEED; //!< Simulation seed, used for every randomized operation, except for the id distribution
+	int rseed = 0; //!< Seed of the simulation random generator (randomly drawn if seed is negative)
 	uintRNG generator; //!< Simulation random generator, used for every randomized operation, except for the id distribution
 	
-	static Simulator *simulator; //!< Static member for accessing *this* simulator
 	Scheduler *scheduler;		//!< Scheduler to be instantiated and configured
 	World *world;				//!< Simulation world to be instantiated and configured
 
@@ -210,6 +231,9 @@ class Simulator {
 	//<! @brief Parses the configuration for target information, and instantiate them
 	void parseTarget();
 
+	//<! @brief Parses the configuration of the wireless medium (<wireless propagationDelay="..."/>, in us)
+	void parseWireless();
+
 	/*! @fn virtual void loadWorld(int lx, int ly, int lz, int argc, char *argv[])
 	 *  @brief Calls the createWorld function from the target world subclass to instantiate it
 	 *
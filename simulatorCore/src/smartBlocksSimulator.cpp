@@ -25,7 +25,7 @@ SmartBlocksSimulator::~SmartBlocksSimulator() {
 }
 
 void SmartBlocksSimulator::createSimulator(int argc, char *argv[], BlockCodeBuilder bcb) {
-    simulator =  new SmartBlocksSimulator(argc, argv, bcb);
+    Simulator *simulator = new SmartBlocksSimulator(argc, argv, bcb);
 	simulator->parseConfiguration(argc, argv);
 	simulator->startSimulation();
 }
@@ -34,7 +34,7 @@ void SmartBlocksSimulator::loadWorld(const Cell3DPosition &gridSize, const Vecto
 									 int argc, char *argv[]) {
     world = new SmartBlocksWorld(gridSize, gridScale, argc,argv);
 
-	if (GlutContext::GUIisEnabled)
+	if (GlutContext::isGUIEnabled())
 		world->loadTextures("../../simulatorCore/resources/textures/latticeTextures");
 	
     World::setWorld(world);
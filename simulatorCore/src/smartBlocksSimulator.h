@@ -26,8 +26,7 @@ class SmartBlocksSimulator : public BaseSimulator::Simulator {
 	static void createSimulator(int argc, char *argv[], BlockCodeBuilder bcb);   
 
 	static SmartBlocksSimulator* getSimulator() {
-		assert(simulator != NULL);
-		return((SmartBlocksSimulator*)simulator);
+		return((SmartBlocksSimulator*)Simulator::getSimulator());
 	}
 
     virtual void loadWorld(const Cell3DPosition &gridSize, const Vector3D &gridScale,
@@ -22,7 +22,7 @@ SmartBlocksWorld::SmartBlocksWorld(const Cell3DPosition &gridSize, const Vector3
                                    int argc, char *argv[]):World(argc, argv) {
     cout << "\033[1;31mSmartBlocksWorld constructor\033[0m" << endl;
 
-    if (GlutContext::GUIisEnabled) {
+    if (GlutContext::isGUIEnabled()) {
         objBlock = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/smartBlocksTextures",
                                             "smartBlockSimple.obj");
         objBlockForPicking = new ObjLoader::ObjLoader("../../simulatorCore/resources/textures/smartBlocksTextures",
@@ -39,8 +39,7 @@ SmartBlocksWorld::~SmartBlocksWorld() {
 }
 
 void SmartBlocksWorld::deleteWorld() {
-    delete((SmartBlocksWorld*)world);
-    world=NULL;
+    World::deleteWorld();
 }
 
 void SmartBlocksWorld::addBlock(bID blockId, BlockCodeBuilder bcb,
@@ -175,7 +174,7 @@ void SmartBlocksWorld::glDrawSpecificBg() {
 }
 
 void SmartBlocksWorld::loadTextures(const string &str) {
-    if (GlutContext::GUIisEnabled) {
+    if (GlutContext::isGUIEnabled()) {
         //string path = str+"/circuit.tga";
         string path = str+"/bois.tga";
         int lx,ly;
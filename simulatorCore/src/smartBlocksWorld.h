@@ -29,8 +29,7 @@ class SmartBlocksWorld : public BaseSimulator::World {
 
     static void deleteWorld();
     static SmartBlocksWorld* getWorld() {
-        assert(world != NULL);
-        return((SmartBlocksWorld*)world);
+        return((SmartBlocksWorld*)World::getWorld());
     }
 
     void printInfo() {
@@ -0,0 +1,135 @@
+/*! @file stateSnapshot.h
+ * @brief Saved state of a module, used by the optimistic parallel engine to undo the events it rolls back
+ * @date 17/10/2026
+ */
+
+#ifndef STATESNAPSHOT_H_
+#define STATESNAPSHOT_H_
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+#define STATESNAPSHOT_RESERVED_ITEMS	32	//!< Number of saved values for which room is made at the first save
+#define STATESNAPSHOT_RESERVED_BYTES	512	//!< Size (bytes) of the copies of plain values for which room is made at the first save
+
+namespace BaseSimulator {
+
+/**
+ * @brief Undo log of the variables of a module
+ *  Each call to save records the address of a variable along with a copy of its current value. restore writes the
+ *  saved values back, in the reverse order of the calls to save. Only the variables that the processing of an event
+ *  can modify have to be saved (see BuildingBlock::saveState and BlockCode::saveState).
+ *
+ *  Plain values (trivially copyable) are copied into a single buffer, other values (containers, smart pointers...)
+ *  into an entry of their own. Large variables that events rarely modify are better saved by saveOnce, just before
+ *  they are modified (see BuildingBlock::willModify).
+ */
+class StateSnapshot {
+	//!< A saved value that is not plain, able to write itself back
+	struct Entry {
+		virtual ~Entry() {};
+		virtual void restore() = 0;
+	};
+
+	//!< Copy of a variable of any copy-assignable type
+	template<class T>
+	struct Value : public Entry {
+		T *address;
+		T value;
+		Value(T &v) : address(&v), value(v) {};
+		void restore() { *address = value; };
+	};
+
+	//!< Arbitrary restoration code, for variables that are not assignable (atomics, for instance)
+	struct Action : public Entry {
+		std::function<void()> action;
+		Action(const std::function<void()> &a) : action(a) {};
+		void restore() { action(); };
+	};
+
+	//!< A saved value: an entry, or a plain copy stored in bytes
+	struct Item {
+		const void *address; //!< address of the variable, NULL for actions
+		size_t size; //!< size of the plain copy, 0 for entries
+		size_t offset; //!< offset of the plain copy in bytes
+		std::unique_ptr<Entry> entry; //!< entry, NULL for plain copies
+	};
+
+	std::vector<Item> items; //!< saved values, in saving order
+	std::vector<uint8_t> bytes; //!< plain copies of the saved values
+
+	inline void reserve() {
+		if (items.capacity() == 0) {
+			items.reserve(STATESNAPSHOT_RESERVED_ITEMS);
+			bytes.reserve(STATESNAPSHOT_RESERVED_BYTES);
+		}
+	};
+
+	template<class T>
+	inline void saveValue(T &v, std::true_type) { save(&v, sizeof(T)); };
+	template<class T>
+	inline void saveValue(T &v, std::false_type) {
+		reserve();
+		items.push_back(Item { &v, 0, 0, std::unique_ptr<Entry>(new Value<T>(v)) });
+	};
+public:
+	StateSnapshot() {};
+	StateSnapshot(const StateSnapshot&) = delete;
+	StateSnapshot& operator=(const StateSnapshot&) = delete;
+
+	//!< @brief Saves the current value of variable v, which must outlive the snapshot
+	template<class T>
+	inline void save(T &v) { saveValue(v, std::is_trivially_copyable<T>()); };
+	//!< @brief Saves the size bytes located at address
+	inline void save(void *address, size_t size) {
+		reserve();
+		size_t offset = bytes.size();
+		bytes.resize(offset + size);
+		memcpy(bytes.data() + offset, address, size);
+		items.push_back(Item { address, size, offset, nullptr });
+	};
+	//!< @brief Registers a function that will be called on restoration, in the same order as the saved values
+	inline void onRestore(const std::function<void()> &action) {
+		reserve();
+		items.push_back(Item { NULL, 0, 0, std::unique_ptr<Entry>(new Action(action)) });
+	};
+
+	//!< @brief Returns true if variable v has already been saved in the snapshot
+	template<class T>
+	inline bool contains(const T &v) const {
+		for (const Item &item : items) {
+			if (item.address == &v) return true;
+		}
+		return false;
+	};
+	//!< @brief Saves the current value of variable v, unless it has already been saved in the snapshot
+	template<class T>
+	inline void saveOnce(T &v) { if (!contains(v)) save(v); };
+
+	//!< @brief Writes every saved value back to its variable, the last saved value first
+	void restore() {
+		for (auto it = items.rbegin(); it != items.rend(); ++it) {
+			if (it->entry) {
+				it->entry->restore();
+			} else {
+				memcpy(const_cast<void*>(it->address), bytes.data() + it->offset, it->size);
+			}
+		}
+	};
+
+	//!< @brief Discards the saved values
+	inline void clear() {
+		items.clear();
+		bytes.clear();
+	};
+	//!< @brief Returns the number of saved values
+	inline size_t size() const { return items.size(); };
+};
+
+} // BaseSimulator namespace
+
+#endif /* STATESNAPSHOT_H_ */
@@ -1,6 +1,6 @@
 /*! @file statsCollector.cpp
  * @brief Provides a mean to store useful number statistics about VisibleSim at runtime
- * Implemented following the singleton design pattern.
+ * One instance per simulation, owned by its SimulationContext.
  * @author Pierre Thalamy
  * @date 22/07/2016
  */
@@ -8,14 +8,41 @@
 #include "statsCollector.h"
 
 #include <iomanip>
+#include <sys/resource.h>
 
 #include "world.h"
+#include "parallelEngine.h"
+#include "simulationContext.h"
+#include "checkpoint.h"
 
 using namespace std;
 
 namespace BaseSimulator {
 namespace utils {
 
+StatsCollector& StatsCollector::getInstance() {
+    return SimulationContext::current().stats;
+}
+
+void StatsCollector::incMsgCount(uint64_t n) {
+    // Parallel engines add the counts of their workers once the corresponding events are validated
+    WorkerContext *w = ParallelEngine::getWorker();
+    if (w) w->nbMessages += n;
+    else messagesProcessed += n;
+}
+
+void StatsCollector::incMotionCount(uint64_t n) {
+    WorkerContext *w = ParallelEngine::getWorker();
+    if (w) w->nbMotions += n;
+    else motionsProcessed += n;
+}
+
+void StatsCollector::checkpoint(CheckpointArchive &a) {
+    // Time counters are not saved: they measure the run that prints them
+    a & messagesProcessed & motionsProcessed & eventsProcessed & largestEventsQueueSize
+      & nbBatches & batchedEvents & largestBatchSize;
+}
+
 ostream& operator<<(ostream& out,const StatsCollector &sc) {
     out << endl << "=== GLOBAL STATISTICS ===" << endl;
     out << "Number of robots: " << getWorld()->getSize() << endl;
@@ -26,9 +53,24 @@ ostream& operator<<(ostream& out,const StatsCollector &sc) {
     out << "Number of motions processed: " << sc.motionsProcessed << endl;
     out << "Maximum sized reached by the events list: " << sc.largestEventsQueueSize << endl;
     out << "Size of the events list at the end: " << sc.endEventsQueueSize << endl;
+    if (sc.nbBatches > 0) {
+        out << "Batches of simultaneous events: " << sc.nbBatches << " (mean size "
+            << (double)sc.batchedEvents / sc.nbBatches << ", largest " << sc.largestBatchSize << ")" << endl;
+    }
+    if (sc.nbRealtimeDates > 0) {
+        out << "Realtime lag behind wall clock: mean " << (double)sc.cumulatedRealtimeLag / sc.nbRealtimeDates
+            << " us, largest " << sc.largestRealtimeLag << " us" << endl;
+    }
     out << "Events(s) left in memory before destroying Scheduler: " << sc.nbLivingEvents << endl;
     out << "Message(s) left in memory before destroying Scheduler: " << sc.nbLivingMessages << endl;
     out << "Number of events processed per second: " << sc.computeEventPerSec() << endl;
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        usage.ru_maxrss /= 1024; // bytes on macOS, kilobytes elsewhere
+#endif
+        out << "Peak memory usage: " << usage.ru_maxrss << " kB" << endl;
+    }
     return out;
 }
 
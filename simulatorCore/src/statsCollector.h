@@ -1,6 +1,6 @@
 /*! @file statsCollector.h
  * @brief Provides a mean to store useful number statistics about VisibleSim at runtime
- * Implemented following the singleton design pattern.
+ * One instance per simulation, owned by its SimulationContext.
  * @author Pierre Thalamy
  * @date 22/07/2016
  */
@@ -14,23 +14,23 @@
 #include "tDefs.h"
 
 namespace BaseSimulator {
+class SimulationContext;
+class CheckpointArchive;
+
 namespace utils {
 
-//!< Singleton-based global statistics collection class
+//!< Global statistics collection class, one instance per simulation
 //!< @attention Any access to StatsCollector must be done through the getInstance() function
 class StatsCollector {
 /************************************************************
  *                   Module Description
  ************************************************************/    
 public:
-    //<! @brief Used to get the singleton instance of StatsCollector.
-    //!< Allocate it on first call, return existing instance on all subsequent calls
-    //<! @return singleton instance of StatsCollector
-    static StatsCollector& getInstance() {
-        static StatsCollector instance;
-        return instance;
-    };
+    //<! @brief Used to get the instance of StatsCollector of the simulation.
+    //<! @return instance of StatsCollector owned by the SimulationContext of the calling thread
+    static StatsCollector& getInstance();
 private:
+    friend class BaseSimulator::SimulationContext;
     StatsCollector() {};        //!< Constructor. Nothing to be done.
     StatsCollector(StatsCollector const&); //<! Disable copy constructor. (Copying instance is not allowed)
     void operator=(StatsCollector const&); //<! Disable assignment operator. (Copying instance is not allowed)
@@ -50,6 +50,12 @@ class StatsCollector {
     uint64_t nbLivingEvents = 0; //!< Total number of events still in memory at scheduler end
     uint64_t largestEventsQueueSize = 0; //!< Largest size of the scheduler's event
     uint64_t endEventsQueueSize = 0; //!< Size of the events queue at scheduler end
+    uint64_t nbBatches = 0; //!< Number of batches of simultaneous events dispatched by the scheduler
+    uint64_t batchedEvents = 0; //!< Total number of events extracted in batches
+    uint64_t largestBatchSize = 0; //!< Size of the largest batch of simultaneous events
+    uint64_t nbRealtimeDates = 0; //!< Number of dates dispatched in realtime mode
+    Time cumulatedRealtimeLag = 0; //!< Sum of the delays of realtime dates relatively to the wall clock (us)
+    Time largestRealtimeLag = 0; //!< Largest delay of a realtime date relatively to the wall clock (us)
     // Time
     Time simulatedElapsedTime = 0; //!< Duration of simulation in discrete simulator time
     double realElapsedTime = 0; //!< Duration of simulation in real time (us)
@@ -57,12 +63,24 @@ class StatsCollector {
     //!< @brief Returns the number of events processed per seconds, calculated from realElapsedTime (in microseconds)
     inline double computeEventPerSec() const {  return realElapsedTime ? eventsProcessed / (realElapsedTime / 1000000) : 0; };
 public:
-    //!< Increments processed message count by 1
-    inline void incMsgCount() { messagesProcessed++; };
-    //!< Increments processed motion count by 1
-    inline void incMotionCount() { motionsProcessed++; };
-    //!< Increments processed event count by 1
-    inline void incEventsCount() { eventsProcessed++; };
+    //!< Increments processed message count by n (1 by default). Counted by the worker when called from a parallel engine worker
+    void incMsgCount(uint64_t n = 1);
+    //!< Increments processed motion count by n (1 by default). Counted by the worker when called from a parallel engine worker
+    void incMotionCount(uint64_t n = 1);
+    //!< Increments processed event count by n (1 by default)
+    inline void incEventsCount(uint64_t n = 1) { eventsProcessed += n; };
+    //!< Returns the number of events processed so far
+    inline uint64_t getEventsCount() const { return eventsProcessed; };
+    //!< Returns the number of messages processed so far
+    inline uint64_t getMsgCount() const { return messagesProcessed; };
+    //!< Returns the number of motions processed so far
+    inline uint64_t getMotionCount() const { return motionsProcessed; };
+    //!< Returns the maximum size reached by the events queue
+    inline uint64_t getLargestEventsQueueSize() const { return largestEventsQueueSize; };
+    //!< Returns the duration of the simulation in simulated time (us), once the scheduler has ended
+    inline Time getSimulatedElapsedTime() const { return simulatedElapsedTime; };
+    //!< Returns the duration of the simulation in real time (us), once the scheduler has ended
+    inline double getRealElapsedTime() const { return realElapsedTime; };
     //!< Updates both elapsed times
     inline void updateElapsedTime(Time simTime, Time realTime)
         { simulatedElapsedTime = simTime; realElapsedTime = realTime; };
@@ -74,6 +92,21 @@ class StatsCollector {
         {  largestEventsQueueSize = largestEventsQueueSize < newSize ? newSize : largestEventsQueueSize; };
     inline void setEndEventsQueueSize(uint64_t endSize) 
         {  endEventsQueueSize = endSize; };
+    //!< Counts a batch of size simultaneous events, extracted at once from the events queue
+    inline void addBatch(uint64_t size) {
+        nbBatches++;
+        batchedEvents += size;
+        largestBatchSize = largestBatchSize < size ? size : largestBatchSize;
+    };
+    //!< Counts a date dispatched in realtime mode, lag us after the wall-clock time at which it was due
+    inline void addRealtimeLag(Time lag) {
+        nbRealtimeDates++;
+        cumulatedRealtimeLag += lag;
+        largestRealtimeLag = largestRealtimeLag < lag ? lag : largestRealtimeLag;
+    };
+
+    //!< Saves or restores the counters of the simulation events, messages, motions and batches (see Checkpoint)
+    void checkpoint(CheckpointArchive &a);
 
     //!< Prints collected statistics to an ouput stream
     friend std::ostream& operator<<(std::ostream& out,const StatsCollector &sc);
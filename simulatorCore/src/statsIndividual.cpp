@@ -5,17 +5,20 @@
  */
 
 #include <cmath>
+#include <algorithm>
 
 #include "statsIndividual.h"
 #include "buildingBlock.h"
 #include "world.h"
+#include "scheduler.h"
+#include "network.h"
+#include "stateSnapshot.h"
 
 using namespace std;
 
 namespace BaseSimulator {
 namespace utils {
 
-bool StatsIndividual::enable = false;
   
 StatsIndividual::StatsIndividual(StatsIndividual const&si) {
  sentMessages = si.sentMessages;
@@ -28,7 +31,14 @@ StatsIndividual::StatsIndividual(StatsIndividual const&si) {
  maxOutgoingMessageQueueSize = si.maxOutgoingMessageQueueSize;
  maxIncommingMessageQueueSize = si.maxIncommingMessageQueueSize;
 
+ macCollisions = si.macCollisions;
+ macRetries = si.macRetries;
+ channelBusyTime = si.channelBusyTime;
+
  motions = si.motions;
+
+ events = si.events;
+ eventsTime = si.eventsTime;
 }
 
 void StatsIndividual::incSentMessageCount(StatsIndividual *s) {
@@ -79,12 +89,49 @@ void StatsIndividual::updateQueueSizeStats() {
   maxMessageQueueSize = max(maxMessageQueueSize,messageQueueSize);
 }
 
+void StatsIndividual::incMacCollisionCount(StatsIndividual *s) {
+  if (s) {
+    s->macCollisions++;
+  }
+}
+
+void StatsIndividual::incMacRetryCount(StatsIndividual *s) {
+  if (s) {
+    s->macRetries++;
+  }
+}
+
+void StatsIndividual::addChannelBusyTime(StatsIndividual *s, uint64_t t) {
+  if (s) {
+    s->channelBusyTime += t;
+  }
+}
+
 void StatsIndividual::incMotionCount(StatsIndividual *s) {
   if (s) {
     s->motions++;
   }
 }
 
+void StatsIndividual::incEventCount(StatsIndividual *s, uint64_t ns) {
+  if (s) {
+    s->events++;
+    s->eventsTime += ns;
+  }
+}
+
+void StatsIndividual::saveState(StatsIndividual *s, StateSnapshot &snapshot) {
+  if (s) {
+    StatsIndividual saved(*s);
+    snapshot.onRestore([s, saved] {
+        uint64_t events = s->events, eventsTime = s->eventsTime;
+        *s = saved;
+        s->events = events;
+        s->eventsTime = eventsTime;
+      });
+  }
+}
+
 #define MIN_INDEX 0
 #define SUM_INDEX 1
 #define MAX_INDEX 2
@@ -107,6 +154,10 @@ long double StatsIndividual::compute3(long double m, uint64_t v) {
 string StatsIndividual::formatStat(string n, uint64_t s[3], long double m, long double sd, string f) {
     return n + ": " + to_string(s[MIN_INDEX]) + " " + to_string(m) + " " + to_string(s[MAX_INDEX]) + " " + to_string(sd) + f; 
 }
+
+uint64_t StatsIndividual::getChannelBusyTime(BuildingBlock *bb) {
+  return bb->stats->channelBusyTime + bb->getWirelessNetworkInterface()->getOngoingBusyTime();
+}
   
 string StatsIndividual::getStats() {
   // min mean max sd
@@ -132,10 +183,30 @@ string StatsIndividual::getStats() {
   long double mimqsm = 0;
   long double mimqssd = 0;
     
+  uint64_t mc[3] = {UINT64_MAX,0,0};
+  long double mcm = 0;
+  long double mcsd = 0;
+
+  uint64_t mr[3] = {UINT64_MAX,0,0};
+  long double mrm = 0;
+  long double mrsd = 0;
+
+  uint64_t cb[3] = {UINT64_MAX,0,0};
+  long double cbm = 0;
+  long double cbsd = 0;
+
   uint64_t m[3] = {UINT64_MAX,0,0};
   long double mm = 0;
   long double msd = 0;
 
+  uint64_t e[3] = {UINT64_MAX,0,0};
+  long double em = 0;
+  long double esd = 0;
+
+  uint64_t et[3] = {UINT64_MAX,0,0};
+  long double etm = 0;
+  long double etsd = 0;
+
   // Stats computation, over all modules
   int size = getWorld()->getSize();
   map<bID,BuildingBlock*> &modules = getWorld()->getMap();
@@ -149,7 +220,12 @@ string StatsIndividual::getStats() {
     compute1(mmqs,st->maxMessageQueueSize);
     compute1(momqs,st->maxOutgoingMessageQueueSize);
     compute1(mimqs,st->maxIncommingMessageQueueSize);
+    compute1(mc,st->macCollisions);
+    compute1(mr,st->macRetries);
+    compute1(cb,getChannelBusyTime(it->second));
     compute1(m,st->motions);
+    compute1(e,st->events);
+    compute1(et,st->eventsTime / 1000);
   }
 
   // Mean
@@ -158,7 +234,12 @@ string StatsIndividual::getStats() {
   mmqsm = compute2(mmqs,size);
   momqsm = compute2(momqs,size);
   mimqsm = compute2(mimqs,size);
+  mcm = compute2(mc,size);
+  mrm = compute2(mr,size);
+  cbm = compute2(cb,size);
   mm = compute2(m,size);
+  em = compute2(e,size);
+  etm = compute2(et,size);
   
   // Standard-Deviation computation
   // First, variance computation:
@@ -169,7 +250,12 @@ string StatsIndividual::getStats() {
     mmqssd += compute3(mmqsm,st->maxMessageQueueSize);
     momqssd += compute3(momqsm,st->maxOutgoingMessageQueueSize);
     mimqssd += compute3(mimqsm,st->maxIncommingMessageQueueSize);
+    mcsd += compute3(mcm,st->macCollisions);
+    mrsd += compute3(mrm,st->macRetries);
+    cbsd += compute3(cbm,getChannelBusyTime(it->second));
     msd += compute3(mm,st->motions);
+    esd += compute3(em,st->events);
+    etsd += compute3(etm,st->eventsTime / 1000);
   }
 
   // Standard-deviation from variance: divide the variance by size
@@ -179,14 +265,24 @@ string StatsIndividual::getStats() {
   mmqssd /= size;
   momqssd /= size;
   mimqssd /= size;
+  mcsd /= size;
+  mrsd /= size;
+  cbsd /= size;
   msd /= size;
+  esd /= size;
+  etsd /= size;
   
   smsd = sqrt(smsd);
   rmsd = sqrt(rmsd);
   mmqssd = sqrt(mmqssd);
   momqssd = sqrt(momqssd);
   mimqssd = sqrt(mimqssd);
+  mcsd = sqrt(mcsd);
+  mrsd = sqrt(mrsd);
+  cbsd = sqrt(cbsd);
   msd = sqrt(msd);
+  esd = sqrt(esd);
+  etsd = sqrt(etsd);
   
   // Result string formatting
   s += "=== STATISTICS PER MODULE ===\n";
@@ -196,7 +292,37 @@ string StatsIndividual::getStats() {
   s += formatStat("Maximum message queue size",mmqs,mmqsm,mmqssd,"\n");
   s += formatStat("Maximum outgoing message queue size",momqs,momqsm,momqssd,"\n");
   s += formatStat("Maximum incomming message queue size",mimqs,mimqsm,mimqssd,"\n");
+  s += formatStat("Wireless collisions",mc,mcm,mcsd,"\n");
+  s += formatStat("Wireless retransmissions",mr,mrm,mrsd,"\n");
+  s += formatStat("Wireless channel busy time (us)",cb,cbm,cbsd,"\n");
+  // Channel utilization: fraction of the simulated time during which the channel was busy, for the mean module
+  Time now = getScheduler()->now();
+  s += "Mean wireless channel utilization: " + to_string(now > 0 ? 100 * cbm / now : 0) + "%\n";
   s += formatStat("Motions",m,mm,msd,"\n");
+  s += formatStat("Processed events",e,em,esd,"\n");
+  s += formatStat("Event processing time (us)",et,etm,etsd,"\n");
+  return s;
+}
+
+string StatsIndividual::getHotspots(size_t n) {
+  vector<BuildingBlock*> hotspots;
+  map<bID,BuildingBlock*> &modules = getWorld()->getMap();
+  for (map<bID,BuildingBlock*>::iterator it = modules.begin(); it != modules.end(); ++it) {
+    if (it->second->stats) hotspots.push_back(it->second);
+  }
+
+  n = min(n, hotspots.size());
+  partial_sort(hotspots.begin(), hotspots.begin() + n, hotspots.end(),
+               [](BuildingBlock *a, BuildingBlock *b) { return a->stats->events > b->stats->events; });
+
+  string s;
+  s += "=== HOTSPOT MODULES ===\n";
+  s += "Format: \"#id: processed events, event processing time (us), sent messages, received messages\"\n";
+  for (size_t i = 0; i < n; i++) {
+    StatsIndividual *st = hotspots[i]->stats;
+    s += "#" + to_string(hotspots[i]->blockId) + ": " + to_string(st->events) + " " + to_string(st->eventsTime / 1000)
+      + " " + to_string(st->sentMessages) + " " + to_string(st->receivedMessages) + "\n";
+  }
   return s;
 }
 
@@ -12,8 +12,15 @@
 #include <string>
 
 #include "tDefs.h"
+#include "simulationContext.h"
+
+#define STATS_INDIVIDUAL_HOTSPOTS 10 //!< Number of modules listed in the hotspot report (see StatsIndividual::getHotspots)
 
 namespace BaseSimulator {
+
+class BuildingBlock;
+class StateSnapshot;
+
 namespace utils {
   
 //!< StatsIndividual class.
@@ -31,10 +38,22 @@ class StatsIndividual {
     uint64_t maxIncommingMessageQueueSize = 0;  //!< Maximum reached incomming message queue size
     uint64_t maxMessageQueueSize = 0; //!< Maximum reached message queue size
     
+    // Wireless medium access control
+    uint64_t macCollisions = 0; //!< Number of wireless messages lost in a collision while being received
+    uint64_t macRetries = 0; //!< Number of wireless retransmissions, for want of acknowledgment
+    uint64_t channelBusyTime = 0; //!< Cumulated time during which the wireless channel was busy for the module (us)
+
     // Motions
     uint64_t motions = 0; //!< Total number of perfomed motions
+
+    // Events
+    uint64_t events = 0; //!< Total number of processed events concerning the module
+    uint64_t eventsTime = 0; //!< Cumulated time spent processing the events concerning the module (ns)
 public:
-    static bool enable; //!< Activation flag: true if per module statistics are enable, false otherwise 
+    //!< @brief Activation flag: true if per module statistics are enabled for the simulation of the calling thread (option -i)
+    static inline bool isEnabled() { return SimulationContext::current().statsIndividual; };
+    //!< @brief Enables or disables per module statistics for the simulation of the calling thread
+    static void setEnabled(bool e) { SimulationContext::current().statsIndividual = e; };
     
     StatsIndividual() {}; //!< Default constructor
     StatsIndividual(StatsIndividual const&); //<! Copy constructor
@@ -52,11 +71,28 @@ class StatsIndividual {
     static void incIncommingMessageQueueSize(StatsIndividual *s);
     //!< Decrements incomming message queue size by 1
     static void decIncommingMessageQueueSize(StatsIndividual *s); 
+    //!< Increments wireless collision count by 1
+    static void incMacCollisionCount(StatsIndividual *s);
+    //!< Increments wireless retransmission count by 1
+    static void incMacRetryCount(StatsIndividual *s);
+    //!< Adds t us to the time during which the wireless channel was busy
+    static void addChannelBusyTime(StatsIndividual *s, uint64_t t);
     //!< Increments processed motion count by 1
     static void incMotionCount(StatsIndividual *s);
+    //!< Increments processed event count by 1, the event having been processed in ns nanoseconds
+    static void incEventCount(StatsIndividual *s, uint64_t ns);
+    //!< Saves the statistics before a speculative event (see BuildingBlock::saveState). The event counts are not
+    //!<  restored: they are incremented when the events are committed (see TimeWarpEngine::commit)
+    static void saveState(StatsIndividual *s, StateSnapshot &snapshot);
+
+    //!< Returns the number of processed events concerning the module
+    inline uint64_t getEventCount() const { return events; }
+
     
     //!< Returns a string that contains a summary of the module statistics
     static std::string getStats();
+    //!< Returns a string that lists the n modules having processed the most events (hotspots)
+    static std::string getHotspots(size_t n);
  private:
 
     //!< Updates queue size statistics
@@ -70,6 +106,8 @@ class StatsIndividual {
     static long double compute3(long double m, uint64_t v);
     //!< Returns a string that summarizes the module statistics for a specific parameter
     static std::string formatStat(std::string n, uint64_t s[3], long double m, long double sd, std::string f);
+    //!< Returns the channel busy time of the module bb, including the busy interval in progress
+    static uint64_t getChannelBusyTime(BuildingBlock *bb);
     
 }; // class StatsIndividual
 
@@ -0,0 +1,91 @@
+/*! @file statsTimeSeries.cpp
+ * @brief Periodic snapshots of the scheduler statistics, streamed to a CSV file during the simulation (see option -S)
+ * @date 17/10/2026
+ */
+
+#include "statsTimeSeries.h"
+
+#include <iostream>
+#include <iomanip>
+
+#include "statsCollector.h"
+#include "events.h"
+#include "network.h"
+#include "world.h"
+#include "buildingBlock.h"
+
+using namespace std;
+
+namespace BaseSimulator {
+namespace utils {
+
+StatsTimeSeries::StatsTimeSeries(Time p, const string &file) : period(p), path(file) {
+    out.open(path, ios::out | ios::trunc);
+    if (out.is_open()) {
+        out << "date,wall,events,messages,events_per_s,queue_size,living_events,messages_in_flight,"
+            << "queued_messages,max_interface_queue,mean_interface_queue" << endl;
+    }
+}
+
+void StatsTimeSeries::start(Time date) {
+    nextDate = (date + period - 1) / period * period;
+    origin = lastWall = chrono::steady_clock::now();
+    lastEvents = StatsCollector::getInstance().getEventsCount();
+    lastMessages = StatsCollector::getInstance().getMsgCount();
+}
+
+void StatsTimeSeries::write(Time date, uint64_t queueSize) {
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    uint64_t events = StatsCollector::getInstance().getEventsCount();
+    uint64_t messages = StatsCollector::getInstance().getMsgCount();
+    double seconds = chrono::duration<double>(now - lastWall).count();
+
+    // Depth of the outgoing queues of the interfaces
+    uint64_t queued = 0, maxQueue = 0, nbInterfaces = 0;
+    for (const auto &it : getWorld()->getMap()) {
+        BuildingBlock *bb = it.second;
+        for (P2PNetworkInterface *ni : bb->getP2PNetworkInterfaces()) {
+            uint64_t n = ni->outgoingQueue.size();
+            queued += n;
+            maxQueue = max(maxQueue, n);
+            nbInterfaces++;
+        }
+        if (bb->getWirelessNetworkInterface()) {
+            uint64_t n = bb->getWirelessNetworkInterface()->outgoingQueue.size();
+            queued += n;
+            maxQueue = max(maxQueue, n);
+            nbInterfaces++;
+        }
+    }
+
+    out << date << ','
+        << chrono::duration_cast<chrono::microseconds>(now - origin).count() << ','
+        << events - lastEvents << ','
+        << messages - lastMessages << ','
+        << fixed << setprecision(0) << (seconds > 0 ? (events - lastEvents) / seconds : 0) << ','
+        << queueSize << ','
+        << Event::getNbLivingEvents() << ','
+        << Message::getNbMessages() + WirelessMessage::getNbMessages() << ','
+        << queued << ','
+        << maxQueue << ','
+        << setprecision(3) << (nbInterfaces ? (double)queued / nbInterfaces : 0) << defaultfloat << endl;
+
+    lastWall = now;
+    lastEvents = events;
+    lastMessages = messages;
+    nbSnapshots++;
+}
+
+void StatsTimeSeries::finish(Time date, uint64_t queueSize) {
+    write(date, queueSize);
+    out.close();
+    if (!out) {
+        cerr << "error: cannot write statistics time series to " << path << endl;
+    } else {
+        cout << "\033[1;33m" << "Statistics time series: " << nbSnapshots << " snapshots written to " << path
+             << "\033[0m" << endl;
+    }
+}
+
+} // namespace BaseSimulator::utils
+} // namespace BaseSimulator
@@ -0,0 +1,92 @@
+/*! @file statsTimeSeries.h
+ * @brief Periodic snapshots of the scheduler statistics, streamed to a CSV file during the simulation (see option -S)
+ * @date 17/10/2026
+ */
+
+#ifndef STATSTIMESERIES_H__
+#define STATSTIMESERIES_H__
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <chrono>
+
+#include "tDefs.h"
+
+#define STATS_TIMESERIES_DEFAULT_FILE "stats.csv" //!< Time series file written by -S when none is specified
+
+namespace BaseSimulator {
+namespace utils {
+
+/**
+ * @brief Time series of the scheduler statistics, one snapshot every period of simulated time
+ *
+ *  Each snapshot is written to the file as soon as it is taken, so that memory does not grow with the duration of
+ *  the simulation, and the file can be watched while the simulation runs. A snapshot describes the state of the
+ *  simulation at a multiple of the period, before the events of that date are processed. Periods without events are
+ *  skipped: the state of the simulation has not changed since the previous snapshot. Columns:
+ *  - date: date of the snapshot (us)
+ *  - wall: wall-clock time since scheduler start (us)
+ *  - events, messages: events and messages processed since the previous snapshot
+ *  - events_per_s: events processed per second of wall-clock time since the previous snapshot
+ *  - queue_size: number of events in the scheduler's event list
+ *  - living_events: number of events in memory
+ *  - messages_in_flight: number of messages (point-to-point and wireless) in memory
+ *  - queued_messages, max_interface_queue, mean_interface_queue: total, largest and mean number of messages in
+ *    the outgoing queues of the network interfaces
+ *
+ *  The interface queues are read from every module for each snapshot: the period should be long enough relatively
+ *  to the size of the world.
+ */
+class StatsTimeSeries {
+    Time period; //!< Simulated time between two snapshots (us)
+    std::string path; //!< Output file
+    std::ofstream out; //!< Output stream, each snapshot is flushed to it
+
+    Time nextDate = 0; //!< Date of the next snapshot
+    uint64_t nbSnapshots = 0; //!< Number of snapshots written so far
+    uint64_t lastEvents = 0; //!< Number of events processed at the previous snapshot
+    uint64_t lastMessages = 0; //!< Number of messages processed at the previous snapshot
+    std::chrono::steady_clock::time_point origin; //!< Wall-clock time of scheduler start
+    std::chrono::steady_clock::time_point lastWall; //!< Wall-clock time of the previous snapshot
+
+    //!< @brief Writes the snapshot of date to the file
+    void write(Time date, uint64_t queueSize);
+public:
+    /**
+     * @brief Creates the output file and writes the header line
+     * @param period simulated time between two snapshots (us), strictly positive
+     * @param path output file, isOpen() returns false if it cannot be created
+     */
+    StatsTimeSeries(Time period, const std::string &path);
+
+    //!< @brief Returns false if the output file could not be created
+    inline bool isOpen() const { return out.is_open(); }
+
+    //!< @brief Starts the time series at scheduler start, at date: the first snapshot is at the next multiple of the period
+    void start(Time date);
+
+    //!< @brief Returns the date of the next snapshot
+    inline Time getNextDate() const { return nextDate; }
+
+    /**
+     * @brief Writes the snapshot of the last multiple of the period up to date, the date of the next events processed.
+     *  The multiples before it would repeat the same state, and are skipped
+     * @param queueSize number of events in the event list
+     */
+    inline void sample(Time date, uint64_t queueSize) {
+        if (nextDate <= date) {
+            Time last = date - (date - nextDate) % period;
+            write(last, queueSize);
+            nextDate = last + period;
+        }
+    }
+
+    //!< @brief Writes a last snapshot at scheduler end, at date, and closes the file
+    void finish(Time date, uint64_t queueSize);
+};
+
+} // namespace BaseSimulator::utils
+} // namespace BaseSimulator
+
+#endif // STATSTIMESERIES_H__
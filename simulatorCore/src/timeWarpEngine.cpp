@@ -0,0 +1,528 @@
+/*! @file timeWarpEngine.cpp
+ * @brief Optimistic parallel execution of the simulation events (Time Warp, D. Jefferson 1985)
+ * @date 17/10/2026
+ */
+
+#include <algorithm>
+
+#include "timeWarpEngine.h"
+#include "eventPool.h"
+#include "scheduler.h"
+#include "world.h"
+#include "trace.h"
+
+using namespace std;
+using namespace BaseSimulator::utils;
+
+namespace BaseSimulator {
+
+TimeWarpEngine::TimeWarpEngine(Scheduler *s, unsigned int n) : ParallelEngine(s, n), workers(n) {
+	for (unsigned int i = 0; i < n; i++) {
+		workers[i].index = i;
+	}
+}
+
+bool TimeWarpEngine::processedBefore(const OrderKey *a, const OrderKey *b) {
+	if (a->date != b->date) return a->date < b->date;
+	// Inherited events were in the event list before any other event was created
+	if (a->inherited != b->inherited) return a->inherited;
+	if (a->inherited) return a->rank < b->rank;
+	// Committed events form a prefix of the sequential order
+	if (a->committed != b->committed) return a->committed;
+	if (a->committed) return a->seq < b->seq;
+	if (a->parent != b->parent) return processedBefore(a->parent.get(), b->parent.get());
+	return a->rank < b->rank;
+}
+
+TimeWarpEngine::Record *TimeWarpEngine::topOf(vector<RecordPtr> &heap) {
+	// Cancelled events are left in the heaps, and discarded when they reach the top
+	while (!heap.empty() && heap.front()->status == CANCELLED) {
+		pop_heap(heap.begin(), heap.end(), later);
+		heap.pop_back();
+	}
+	return heap.empty() ? NULL : heap.front().get();
+}
+
+TimeWarpEngine::OrderKeyPtr TimeWarpEngine::newKey(Time d, uint64_t r, const OrderKeyPtr &p) {
+	return allocate_shared<OrderKey>(EventAllocator<OrderKey>(), d, r, p);
+}
+
+TimeWarpEngine::RecordPtr TimeWarpEngine::newRecord(vector<RecordPtr> &spares) {
+	if (spares.empty()) return allocate_shared<Record>(EventAllocator<Record>());
+	RecordPtr r = std::move(spares.back());
+	spares.pop_back();
+	return r;
+}
+
+void TimeWarpEngine::recycle(RecordPtr &r) {
+	if (r.use_count() > 1) return;
+
+	// Cleared without releasing the buffers, which are the costly part of a record (saved state in particular)
+	r->ev.reset();
+	r->key.reset();
+	r->lp = NULL;
+	r->status = PENDING;
+	r->delivered = false;
+	r->snapshot.clear();
+	r->children.clear();
+	r->cancels.clear();
+	r->nbMessages = 0;
+	r->nbMotions = 0;
+	r->ns = 0;
+	r->executions = 0;
+	r->traces.clear();
+	spares.push_back(std::move(r));
+}
+
+TimeWarpEngine::LogicalProcess *TimeWarpEngine::getLP(BuildingBlock *bb, bool create) {
+	auto it = lps.find(bb->blockId);
+	if (it != lps.end()) return &it->second;
+	if (!create) return NULL;
+
+	LogicalProcess &lp = lps[bb->blockId];
+	lp.block = bb;
+	lp.partition = partitionOf(bb);
+	return &lp;
+}
+
+bool TimeWarpEngine::canProcess() {
+	// Rollbacks require every module to be able to save its state
+	for (auto &it : getWorld()->getMap()) {
+		StateSnapshot probe;
+		if (!it.second->saveState(probe)) {
+			cerr << "warning: the optimistic parallel engine requires the block code to save its state "
+				 << "(see BlockCode::saveState), using the conservative engine" << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+void TimeWarpEngine::start() {
+	Time lookahead = computeLookahead();
+	if (lookahead == 0) {
+		window = OPTIMISTIC_DEFAULT_WINDOW;
+	} else {
+		window = lookahead > TIME_MAX / OPTIMISTIC_WINDOW_FACTOR ? TIME_MAX : lookahead * OPTIMISTIC_WINDOW_FACTOR;
+	}
+
+	for (auto &it : getWorld()->getMap()) {
+		getLP(it.second, true);
+	}
+
+	lastSync.reset();
+	nextRank = 0;
+	nextSeq = 0;
+	nbRounds = 0;
+	nbSyncEvents = 0;
+	pending = false;
+
+	cout << "\033[1;33m" << "Scheduler : " << getName() << " parallel engine, " << nbWorkers
+		 << " threads, optimism window " << window << " us" << "\033[0m" << endl;
+
+	ParallelEngine::start();
+}
+
+void TimeWarpEngine::stop() {
+	ParallelEngine::stop();
+
+	// Simulation interrupted: validate the processed events, and give the pending ones back to the scheduler
+	commit(NULL);
+	for (Worker &w : workers) {
+		for (RecordPtr &r : w.heap) {
+			if (r->status == PENDING) scheduler->insertEvent(std::move(r->ev));
+		}
+		w.heap.clear();
+	}
+	for (RecordPtr &r : syncHeap) {
+		if (r->status == PENDING) scheduler->insertEvent(std::move(r->ev));
+	}
+	syncHeap.clear();
+	for (Worker &w : workers) {
+		w.spares.clear();
+	}
+	spares.clear();
+	pending = false;
+
+	uint64_t nbRollbacks = 0, nbRolledBack = 0;
+	for (Worker &w : workers) {
+		nbRollbacks += w.nbRollbacks;
+		nbRolledBack += w.nbRolledBack;
+	}
+	cout << "\033[1;33m" << "Scheduler : " << nbRounds << " parallel rounds, " << nbRollbacks << " rollbacks ("
+		 << nbRolledBack << " events rolled back), " << nbSyncEvents << " sequential events" << "\033[0m" << endl;
+}
+
+bool TimeWarpEngine::hasPendingEvents() const {
+	return pending;
+}
+
+void TimeWarpEngine::acquireEvents() {
+	EventQueue *queue = scheduler->eventsQueue;
+
+	while (!queue->empty()) {
+		RecordPtr r = newRecord(spares);
+		r->ev = queue->pop();
+		scheduler->eventsMapSize--;
+
+		// Events of the initial list, or scheduled by the last event processed by the scheduler thread
+		r->key = newKey(r->ev->date, nextRank++, lastSync);
+		r->key->inherited = (lastSync == NULL);
+
+		BuildingBlock *owner = r->ev->getOwnerBlock();
+		r->lp = owner ? getLP(owner, true) : NULL;
+		r->delivered = true;
+		insert(r, NULL);
+	}
+}
+
+TimeWarpEngine::Record *TimeWarpEngine::earliestPending() {
+	Record *earliest = topOf(syncHeap);
+	for (Worker &w : workers) {
+		Record *r = topOf(w.heap);
+		if (r && (earliest == NULL || processedBefore(r->key.get(), earliest->key.get()))) {
+			earliest = r;
+		}
+	}
+	return earliest;
+}
+
+void TimeWarpEngine::step() {
+	acquireEvents();
+
+	// Global Virtual Time: no event can be rolled back by an event that follows the earliest pending one
+	Record *gvt = earliestPending();
+	if (gvt == NULL) {
+		commit(NULL);
+		pending = false;
+		return;
+	}
+	commit(gvt->key.get());
+
+	if (gvt->lp == NULL) {
+		processSyncEvent();
+	} else {
+		Record *sync = topOf(syncHeap);
+		barrier = sync ? sync->key : NULL;
+		Time start = gvt->ev->date;
+		horizon = window > TIME_MAX - start ? TIME_MAX : start + window;
+
+		unsigned int nbPartitions = 0, lastPartition = 0;
+		for (Worker &w : workers) {
+			w.roundEvents = 0;
+			while (w.spares.size() < OPTIMISTIC_SPARE_RECORDS && !spares.empty()) {
+				w.spares.push_back(std::move(spares.back()));
+				spares.pop_back();
+			}
+			if (topOf(w.heap)) {
+				nbPartitions++;
+				lastPartition = w.index;
+			}
+		}
+
+		scheduler->parallelSection = true;
+		if (nbPartitions == 1) {
+			processPartition(lastPartition);
+		} else {
+			runWorkers();
+		}
+		scheduler->parallelSection = false;
+		nbRounds++;
+		barrier.reset();
+
+		for (Worker &w : workers) {
+			w.nbEvents += w.roundEvents;
+		}
+
+		deliver();
+	}
+
+	pending = (earliestPending() != NULL);
+	if (!pending) {
+		commit(NULL);
+	}
+}
+
+void TimeWarpEngine::processSyncEvent() {
+	Record *s = topOf(syncHeap);
+
+	// The event can affect any module: speculative events that follow it are rolled back, the others are final
+	for (auto &it : lps) {
+		rollback(&it.second, s->key.get(), NULL);
+	}
+	commit(NULL);
+
+	pop_heap(syncHeap.begin(), syncHeap.end(), later);
+	RecordPtr r = std::move(syncHeap.back());
+	syncHeap.pop_back();
+
+	r->key->seq = nextSeq++;
+	r->key->committed = true;
+	r->key->parent.reset();
+	lastSync = r->key;
+	nextRank = 0;
+
+	if (r->ev->cancelled) return;
+
+	// Events scheduled by r are inserted into the event list, and acquired at the next step
+	scheduler->currentDate = r->ev->date;
+	consumeCounted(r->ev.get());
+	StatsCollector::getInstance().incEventsCount();
+	nbSyncEvents++;
+}
+
+void TimeWarpEngine::deliver() {
+	for (Worker &w : workers) {
+		for (RecordPtr &r : w.outbox) {
+			if (r->status == CANCELLED) continue;
+			BuildingBlock *owner = r->ev->getOwnerBlock();
+			r->lp = owner ? getLP(owner, true) : NULL;
+			r->delivered = true;
+			insert(r, NULL);
+		}
+		w.outbox.clear();
+	}
+
+	// Anti-messages are handled once all events have been delivered, cancelled events being in place
+	for (Worker &w : workers) {
+		for (RecordPtr &r : w.cancels) {
+			cancel(r, NULL);
+		}
+		w.cancels.clear();
+	}
+
+	// Then the cancellations of the block codes, unless the cancelling event has been rolled back meanwhile
+	for (Worker &w : workers) {
+		for (RemoteCancel &c : w.remoteCancels) {
+			if (c.parent->status == PROCESSED && c.parent->executions == c.execution) {
+				cancelFor(c.parent, c.ev, NULL);
+			}
+		}
+		w.remoteCancels.clear();
+	}
+}
+
+void TimeWarpEngine::insert(const RecordPtr &r, Worker *w) {
+	if (r->lp == NULL) {
+		syncHeap.push_back(r);
+		push_heap(syncHeap.begin(), syncHeap.end(), later);
+		return;
+	}
+
+	LogicalProcess *lp = r->lp;
+	if (!lp->processed.empty() && processedBefore(r->key.get(), lp->processed.back()->key.get())) {
+		// Straggler: lp has already processed events that follow r
+		rollback(lp, r->key.get(), w);
+	}
+
+	vector<RecordPtr> &heap = workers[lp->partition].heap;
+	heap.push_back(r);
+	push_heap(heap.begin(), heap.end(), later);
+}
+
+void TimeWarpEngine::rollback(LogicalProcess *lp, const OrderKey *k, Worker *w) {
+	Worker &owner = workers[lp->partition];
+	uint64_t n = 0;
+
+	while (!lp->processed.empty() && !processedBefore(lp->processed.back()->key.get(), k)) {
+		RecordPtr r = std::move(lp->processed.back());
+		lp->processed.pop_back();
+
+		// Anti-messages for the events scheduled by r
+		for (const RecordPtr &child : r->children) {
+			cancel(child, w);
+		}
+		r->children.clear();
+		// Events cancelled by r are pending again
+		for (const EventPtr &ev : r->cancels) {
+			ev->cancelled = false;
+		}
+		r->cancels.clear();
+		r->nbMessages = 0;
+		r->nbMotions = 0;
+		r->traces.clear();
+		r->ev->processed = false;
+		r->status = PENDING;
+
+		// Undone from the last event to the earliest: a variable is only saved by the first event that modified it
+		r->snapshot.restore();
+		r->snapshot.clear();
+		owner.heap.push_back(std::move(r));
+		push_heap(owner.heap.begin(), owner.heap.end(), later);
+		n++;
+	}
+
+	if (n > 0) {
+		owner.nbRollbacks++;
+		owner.nbRolledBack += n;
+	}
+}
+
+void TimeWarpEngine::cancel(const RecordPtr &r, Worker *w) {
+	if (w) {
+		if (!r->delivered) {
+			// Still in the outbox of w
+			r->status = CANCELLED;
+			return;
+		}
+		if (r->lp == NULL || r->lp->partition != w->index) {
+			w->cancels.push_back(r);
+			return;
+		}
+	}
+
+	if (r->status == PROCESSED) {
+		rollback(r->lp, r->key.get(), w);
+	}
+	r->status = CANCELLED;
+}
+
+void TimeWarpEngine::commit(const OrderKey *gvt) {
+	for (auto &it : lps) {
+		deque<RecordPtr> &processed = it.second.processed;
+		while (!processed.empty() && (gvt == NULL || processedBefore(processed.front()->key.get(), gvt))) {
+			commits.push_back(std::move(processed.front()));
+			processed.pop_front();
+		}
+	}
+	if (commits.empty()) return;
+
+	sort(commits.begin(), commits.end(), [](const RecordPtr &a, const RecordPtr &b) {
+			return processedBefore(a->key.get(), b->key.get());
+		});
+
+	uint64_t nbEvents = 0, nbMessages = 0, nbMotions = 0;
+	for (RecordPtr &r : commits) {
+		r->key->seq = nextSeq++;
+		r->key->committed = true;
+		// Cancelled events are processed as no-ops, to be undone like the others
+		if (!r->ev->cancelled) {
+			nbEvents++;
+			// Only the last execution of a rolled back event is counted
+			countEvent(r->ev.get(), r->ns);
+		}
+		if (!r->traces.empty()) {
+			scheduler->printTrace(r->traces);
+		}
+		nbMessages += r->nbMessages;
+		nbMotions += r->nbMotions;
+	}
+	// Committed keys are compared by commit rank, the keys of their ancestors are no longer needed, and committed
+	// events are no longer rolled back, nor their children
+	for (RecordPtr &r : commits) {
+		r->key->parent.reset();
+		r->children.clear();
+	}
+
+	scheduler->currentDate = max(scheduler->currentDate, commits.back()->ev->date);
+	StatsCollector::getInstance().incEventsCount(nbEvents);
+	StatsCollector::getInstance().incMsgCount(nbMessages);
+	StatsCollector::getInstance().incMotionCount(nbMotions);
+	for (RecordPtr &r : commits) {
+		recycle(r);
+	}
+	commits.clear();
+}
+
+void TimeWarpEngine::processPartition(unsigned int i) {
+	Worker &w = workers[i];
+
+	current = &w;
+	while (w.roundEvents < OPTIMISTIC_MAX_BATCH) {
+		Record *top = topOf(w.heap);
+		if (top == NULL || top->ev->date >= horizon) break;
+		if (barrier && !processedBefore(top->key.get(), barrier.get())) break;
+
+		pop_heap(w.heap.begin(), w.heap.end(), later);
+		RecordPtr r = std::move(w.heap.back());
+		w.heap.pop_back();
+
+		LogicalProcess *lp = r->lp;
+		lp->block->saveState(r->snapshot);
+
+		w.date = r->ev->date;
+		w.processing = r.get();
+		r->executions++;
+		uint64_t nbMessages = w.nbMessages, nbMotions = w.nbMotions;
+		if (!r->ev->cancelled) {
+			// Large variables of the module are saved by the event when it first modifies them
+			lp->block->undoLog = &r->snapshot;
+			r->ns = consumeTimed(r->ev.get());
+			lp->block->undoLog = NULL;
+		}
+		r->ev->processed = true;
+		r->nbMessages = w.nbMessages - nbMessages;
+		r->nbMotions = w.nbMotions - nbMotions;
+
+		r->status = PROCESSED;
+		lp->processed.push_back(std::move(r));
+		w.roundEvents++;
+	}
+	w.processing = NULL;
+	current = NULL;
+}
+
+bool TimeWarpEngine::schedule(EventPtr &pev) {
+	Worker *w = static_cast<Worker*>(current);
+	if (w == NULL) return false;
+
+	Record *parent = w->processing;
+	RecordPtr r = newRecord(w->spares);
+	r->ev = std::move(pev);
+	r->key = newKey(r->ev->date, parent->children.size(), parent->key);
+	parent->children.push_back(r);
+
+	BuildingBlock *owner = r->ev->getOwnerBlock();
+	LogicalProcess *lp = owner ? getLP(owner, false) : NULL;
+	if (lp && lp->partition == w->index) {
+		r->lp = lp;
+		r->delivered = true;
+		insert(r, w);
+	} else {
+		// Delivered by the scheduler thread at the end of the round
+		w->outbox.push_back(r);
+	}
+	return true;
+}
+
+bool TimeWarpEngine::holdTrace(const string &line) {
+	Worker *w = static_cast<Worker*>(current);
+	if (w == NULL || w->processing == NULL) return false;
+	w->processing->traces += line;
+	return true;
+}
+
+bool TimeWarpEngine::cancel(EventPtr &pev) {
+	Worker *w = static_cast<Worker*>(current);
+	if (w == NULL) {
+		// Event without owner being processed: the speculative events that follow it have been rolled back
+		if (pev->processed) return false;
+		pev->cancelled = true;
+		return true;
+	}
+
+	BuildingBlock *owner = pev->getOwnerBlock();
+	LogicalProcess *lp = owner ? getLP(owner, false) : NULL;
+	if (lp == NULL || lp->partition != w->index) {
+		// The module of the event may be processing it: the cancellation is applied at the end of the round
+		w->remoteCancels.push_back(RemoteCancel{w->processing, w->processing->executions, pev});
+		return true;
+	}
+	return cancelFor(w->processing, pev, w);
+}
+
+bool TimeWarpEngine::cancelFor(Record *parent, EventPtr &pev, Worker *w) {
+	// Another module may have processed the event speculatively, before the cancelling event in sequential order
+	BuildingBlock *owner = pev->getOwnerBlock();
+	LogicalProcess *lp = owner ? getLP(owner, false) : NULL;
+	if (lp && lp != parent->lp) {
+		rollback(lp, parent->key.get(), w);
+	}
+	if (pev->processed || pev->cancelled) return false;
+
+	pev->cancelled = true;
+	parent->cancels.push_back(pev);
+	return true;
+}
+
+} // BaseSimulator namespace
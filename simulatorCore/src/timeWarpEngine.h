@@ -0,0 +1,194 @@
+/*! @file timeWarpEngine.h
+ * @brief Optimistic parallel execution of the simulation events (Time Warp, D. Jefferson 1985)
+ * @date 17/10/2026
+ */
+
+#ifndef TIMEWARPENGINE_H_
+#define TIMEWARPENGINE_H_
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "parallelEngine.h"
+#include "stateSnapshot.h"
+
+#define OPTIMISTIC_WINDOW_FACTOR	8		//!< Optimism window of a round, in multiples of the lookahead
+#define OPTIMISTIC_DEFAULT_WINDOW	1000	//!< Optimism window of a round when the lookahead is null (us)
+#define OPTIMISTIC_MAX_BATCH		4096	//!< Maximum number of events processed by a worker during a round
+#define OPTIMISTIC_SPARE_RECORDS	4096	//!< Number of recycled records handed to each worker at the start of a round
+
+namespace BaseSimulator {
+
+/**
+ * @brief Optimistic parallel engine
+ *  Every module is a logical process, which processes its events speculatively, without waiting for the events that
+ *  other modules may still schedule for it. The state of the module is saved before each event (see
+ *  BuildingBlock::saveState). When a module receives an event that precedes events it has already processed (a
+ *  straggler), these events are rolled back: the state of the module is restored, and the events they scheduled are
+ *  cancelled (anti-messages), which can roll back other modules in turn.
+ *
+ *  Workers process their modules in rounds, bounded by an optimism window. Events exchanged between partitions, and
+ *  anti-messages, are delivered between rounds by the scheduler thread. The Global Virtual Time (GVT) is then the
+ *  earliest pending event: events before it can no longer be rolled back, and are committed (fossil collection).
+ *  Events without owner are processed alone by the scheduler thread when they reach the GVT, after all the
+ *  speculative events that follow them have been rolled back.
+ *
+ *  Events are ordered as in a sequential run (see OrderKey), so that the simulation produces the same results.
+ *  Keys and records are allocated from the event pools, and committed records are recycled with their buffers.
+ */
+class TimeWarpEngine : public ParallelEngine {
+	struct OrderKey;
+	struct Record;
+	struct LogicalProcess;
+	typedef std::shared_ptr<OrderKey> OrderKeyPtr;
+	typedef std::shared_ptr<Record> RecordPtr;
+
+	/**
+	 * @brief Position of an event in the sequential processing order
+	 *  Events are ordered by date. Events of the same date that were in the event list when the engine started come
+	 *  first, by rank in the list. Then come committed events, by commit order, and finally uncommitted events, by
+	 *  creation order: the position of their creator, then their rank among the events created by the same event.
+	 */
+	struct OrderKey {
+		Time date; //!< date of the event
+		uint64_t rank; //!< rank in the initial event list if inherited, rank among its siblings otherwise
+		OrderKeyPtr parent; //!< key of the event that created this one, NULL if inherited or committed
+		uint64_t seq = 0; //!< commit rank, valid if committed
+		bool inherited = false; //!< true if the event was in the event list when the engine started
+		bool committed = false; //!< true once the event has been committed
+
+		OrderKey(Time d, uint64_t r, const OrderKeyPtr &p) : date(d), rank(r), parent(p) {};
+	};
+
+	//!< Status of a Record
+	enum Status {PENDING, PROCESSED, CANCELLED};
+
+	//!< An event under the control of the engine
+	struct Record {
+		EventPtr ev; //!< the event
+		OrderKeyPtr key; //!< position of the event in the sequential order
+		LogicalProcess *lp = NULL; //!< logical process of the owner of the event, NULL for events without owner
+		Status status = PENDING; //!< processing status
+		bool delivered = false; //!< false while the event waits in the outbox of the worker that created it
+		StateSnapshot snapshot; //!< state of the owner before the event, PROCESSED only
+		std::vector<RecordPtr> children; //!< events scheduled by the event, PROCESSED only
+		std::vector<EventPtr> cancels; //!< events cancelled by the event, PROCESSED only (see Scheduler::cancel)
+		uint64_t nbMessages = 0; //!< messages sent by the event, PROCESSED only
+		uint64_t nbMotions = 0; //!< motions processed by the event, PROCESSED only
+		uint64_t ns = 0; //!< processing time of the event (ns) if the statistics of the modules are enabled, PROCESSED only
+		uint64_t executions = 0; //!< number of times the event has been processed, rolled back executions included
+		std::string traces; //!< trace lines emitted by the event, printed when it is committed, PROCESSED only
+	};
+
+	//!< Speculative state of a module
+	struct LogicalProcess {
+		BuildingBlock *block; //!< the module
+		unsigned int partition; //!< index of the worker that processes the events of the module
+		std::deque<RecordPtr> processed; //!< uncommitted processed events, in processing order
+	};
+
+	//!< Cancellation of the event of a module of another partition, applied at the end of the round
+	struct RemoteCancel {
+		Record *parent; //!< cancelling event
+		uint64_t execution; //!< execution of the cancelling event, ignored if it has been rolled back since
+		EventPtr ev; //!< cancelled event
+	};
+
+	//!< Per-worker state
+	struct Worker : public WorkerContext {
+		std::vector<RecordPtr> heap; //!< pending events of the modules of the partition, min-heap on OrderKey
+		std::vector<RecordPtr> outbox; //!< events scheduled for other partitions or without owner during the round
+		std::vector<RecordPtr> cancels; //!< anti-messages for events of other partitions, sent during the round
+		std::vector<RemoteCancel> remoteCancels; //!< events of other partitions cancelled by the block codes during the round
+		std::vector<RecordPtr> spares; //!< recycled records, for the events scheduled during the round
+		Record *processing = NULL; //!< event being processed
+		uint64_t roundEvents = 0; //!< number of events processed during the current round
+		uint64_t nbRollbacks = 0; //!< number of rollbacks caused by stragglers and anti-messages
+		uint64_t nbRolledBack = 0; //!< number of events rolled back
+	};
+
+	std::vector<Worker> workers; //!< state of the workers, indexed by partition
+	std::unordered_map<bID, LogicalProcess> lps; //!< logical processes, indexed by module id
+	std::vector<RecordPtr> syncHeap; //!< pending events without owner, min-heap on OrderKey
+	std::vector<RecordPtr> commits; //!< events being committed
+	std::vector<RecordPtr> spares; //!< committed records kept for reuse (see recycle)
+	OrderKeyPtr lastSync; //!< key of the last event processed by the scheduler thread, parent of the events it scheduled
+	uint64_t nextRank = 0; //!< rank of the next event transferred from the event list, among the events scheduled by lastSync
+	uint64_t nextSeq = 0; //!< commit rank of the next committed event
+	Time window = 0; //!< optimism window of a round
+	Time horizon = 0; //!< end date (excluded) of the current round
+	OrderKeyPtr barrier; //!< key of the earliest pending event without owner during the round, NULL if none
+	uint64_t nbRounds = 0; //!< number of rounds processed in parallel
+	uint64_t nbSyncEvents = 0; //!< number of events processed alone by the scheduler thread
+	bool pending = false; //!< true if the engine holds pending events, updated at the end of each step
+
+	//!< @brief Returns true if the event of key a is processed before the event of key b in a sequential run
+	static bool processedBefore(const OrderKey *a, const OrderKey *b);
+	//!< @brief Heap comparator, returns true if record a is processed after record b
+	static inline bool later(const RecordPtr &a, const RecordPtr &b) { return processedBefore(b->key.get(), a->key.get()); };
+	//!< @brief Returns the earliest pending record of heap, after discarding cancelled records, NULL if none
+	static Record *topOf(std::vector<RecordPtr> &heap);
+
+	//!< @brief Returns a new key, allocated from the event pool of the calling thread
+	static OrderKeyPtr newKey(Time d, uint64_t r, const OrderKeyPtr &p);
+	//!< @brief Returns a blank record, taken from spares if not empty
+	static RecordPtr newRecord(std::vector<RecordPtr> &spares);
+	//!< @brief Blanks committed record r and keeps it in spares, unless it is still referred to
+	void recycle(RecordPtr &r);
+
+	//!< @brief Returns the logical process of module bb, creating it if needed (scheduler thread only), NULL otherwise
+	LogicalProcess *getLP(BuildingBlock *bb, bool create);
+
+	//!< @brief Transfers the events of the event list of the scheduler into the engine
+	void acquireEvents();
+	//!< @brief Delivers the events, anti-messages and cancellations exchanged between partitions during the last round
+	void deliver();
+	//!< @brief Cancels event ev on behalf of the processed event parent, rolling back the module of ev if needed
+	bool cancelFor(Record *parent, EventPtr &ev, Worker *w);
+	/**
+	 * @brief Inserts record r into the pending events of its logical process, rolling it back if r is a straggler
+	 * @param r record to insert, for a module of partition w (or any partition if w is NULL)
+	 * @param w calling worker, NULL for the scheduler thread
+	 */
+	void insert(const RecordPtr &r, Worker *w);
+	/**
+	 * @brief Rolls back the events of logical process lp that are not processed before key k
+	 * @param w calling worker, NULL for the scheduler thread
+	 */
+	void rollback(LogicalProcess *lp, const OrderKey *k, Worker *w);
+	/**
+	 * @brief Cancels event r, sending an anti-message to its partition if it is not processed by w
+	 * @param w calling worker, NULL for the scheduler thread
+	 */
+	void cancel(const RecordPtr &r, Worker *w);
+	/**
+	 * @brief Commits the processed events that precede key gvt, all of them if gvt is NULL
+	 *  Committed events can no longer be rolled back: their saved states are released and their statistics counted
+	 */
+	void commit(const OrderKey *gvt);
+	//!< @brief Processes the earliest event without owner on the scheduler thread
+	void processSyncEvent();
+	//!< @brief Returns the earliest pending event, NULL if none
+	Record *earliestPending();
+
+	void processPartition(unsigned int i);
+public:
+	TimeWarpEngine(Scheduler *s, unsigned int n);
+	~TimeWarpEngine() {};
+
+	bool canProcess();
+	void start();
+	void stop();
+	void step();
+	bool schedule(EventPtr &pev);
+	bool cancel(EventPtr &pev);
+	bool holdTrace(const string &line);
+	bool hasPendingEvents() const;
+	const string getName() const { return "optimistic"; };
+};
+
+} // BaseSimulator namespace
+
+#endif /* TIMEWARPENGINE_H_ */
@@ -8,8 +8,6 @@
 #include "trace.h"
 #include "scheduler.h"
 
-std::ofstream log_file{};
-
 void ConsoleStream::flush() {
     scheduler->trace(stream.str(),blockId);
     stream.str("");
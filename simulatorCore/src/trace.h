@@ -14,13 +14,15 @@
 #include <cstring>
 
 #include "tDefs.h"
+#include "simulationContext.h"
 
 #define LOGFILE
 
 #ifdef LOGFILE
-	extern std::ofstream log_file;
-	#define OUTPUT log_file
-	#define ERRPUT log_file
+	//!< @brief Returns the log file of the simulation of the calling thread, closed unless option -l is given
+	inline std::ofstream& getLogFile() { return BaseSimulator::SimulationContext::current().logFile; }
+	#define OUTPUT getLogFile()
+	#define ERRPUT getLogFile()
 #else
 	#define OUTPUT cout
 	#define ERRPUT cerr
@@ -180,7 +180,7 @@ TranslationEndEvent::~TranslationEndEvent() {
 void TranslationEndEvent::consume() {
     EVENT_CONSUME_INFO();
     BuildingBlock *bb = concernedBlock;
-    concernedBlock->blockCode->processLocalEvent(EventPtr(new TranslationEndEvent(date + COM_DELAY,bb)));
+    concernedBlock->blockCode->processLocalEvent(makeEventPtr(new TranslationEndEvent(date + COM_DELAY,bb)));
     StatsCollector::getInstance().incMotionCount();
     StatsIndividual::incMotionCount(bb->stats);
 }
@@ -30,6 +30,8 @@ class TranslationStartEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -51,6 +53,8 @@ class TranslationStepEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -68,6 +72,8 @@ class TranslationStopEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 //===========================================================================================================
@@ -84,6 +90,8 @@ class TranslationEndEvent : public BlockEvent {
     void consumeBlockEvent() {};
     void consume();
     const virtual string getEventName();
+    // Moves the module in the world, which modifies its neighbors
+    BaseSimulator::BuildingBlock* getOwnerBlock() { return NULL; };
 };
 
 }
@@ -27,6 +27,9 @@
 #define EVENT_WNI_ENQUEUE_OUTGOING_MESSAGE 			17
 #define EVENT_WNI_CHANNEL_LISTENING			18
 #define EVENT_WNI_IDLE					19
+#define EVENT_NI_DELIVER							20
+#define EVENT_WNI_ACK_TIMEOUT						21
+#define EVENT_WNI_SEND_ACK							22
 
 #define EVENT_VM_START_COMPUTATION					1001
 #define EVENT_VM_END_COMPUTATION					1002
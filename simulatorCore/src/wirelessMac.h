@@ -0,0 +1,45 @@
+/*! @file wirelessMac.h
+ * @brief Parameters of the CSMA/CA medium access control of the wireless interfaces (see <wireless slotTime="..."/>
+ *  in the configuration file)
+ * @date 17/10/2026
+ */
+
+#ifndef WIRELESSMAC_H__
+#define WIRELESSMAC_H__
+
+#include "tDefs.h"
+
+#define WIRELESS_MAC_SLOT_TIME		20 //!< Default duration (us) of a backoff slot
+#define WIRELESS_MAC_SIFS			10 //!< Default short interframe space (us), between a message and its acknowledgment
+#define WIRELESS_MAC_DIFS			50 //!< Default interframe space (us) during which the channel must be idle before the backoff
+#define WIRELESS_MAC_CW_MIN			15 //!< Default initial contention window, in slots
+#define WIRELESS_MAC_CW_MAX			1023 //!< Default largest contention window, in slots
+#define WIRELESS_MAC_RETRY_LIMIT	7 //!< Default number of retransmissions of an unacknowledged message before it is dropped
+
+#define WIRELESS_MAC_ACK			0xFFFFFFFF //!< Type of the acknowledgment messages, which never reach the block codes
+#define WIRELESS_MAC_ACK_SIZE		4 //!< Size (bytes) of the acknowledgment messages, bare WirelessMessage instances
+
+namespace BaseSimulator {
+
+/**
+ * @brief Parameters of the CSMA/CA medium access control, shared by the wireless interfaces of a simulation
+ *
+ *  Before a transmission, an interface waits for the channel to be idle for difs, then for a backoff of a random
+ *  number of slots in [0, contention window], frozen while the channel is busy. With acknowledgments, a message sent
+ *  to a single module is acknowledged by the receiver after sifs; without acknowledgment before the timeout, the
+ *  contention window is doubled, up to cwMax, and the message is sent again, up to retryLimit times. The receiver
+ *  of a retransmission whose acknowledgment was lost acknowledges it again, and drops it (same sequence number).
+ */
+struct WirelessMacParameters {
+	Time slotTime = WIRELESS_MAC_SLOT_TIME; //!< Duration (us) of a backoff slot
+	Time sifs = WIRELESS_MAC_SIFS; //!< Short interframe space (us)
+	Time difs = WIRELESS_MAC_DIFS; //!< Interframe space (us) before the backoff
+	unsigned int cwMin = WIRELESS_MAC_CW_MIN; //!< Initial contention window (slots)
+	unsigned int cwMax = WIRELESS_MAC_CW_MAX; //!< Largest contention window (slots)
+	unsigned int retryLimit = WIRELESS_MAC_RETRY_LIMIT; //!< Retransmissions of a message before it is dropped
+	bool ack = false; //!< true if the messages sent to a single module are acknowledged
+};
+
+} // namespace BaseSimulator
+
+#endif // WIRELESSMAC_H__
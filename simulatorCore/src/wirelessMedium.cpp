@@ -0,0 +1,104 @@
+/*! @file wirelessMedium.cpp
+ * @brief Spatial index of the modules sharing the wireless medium, from which the receivers of a broadcast are
+ *  selected by their distance to the transmitter
+ * @date 17/10/2026
+ */
+
+#include "wirelessMedium.h"
+
+#include <algorithm>
+
+#include "network.h"
+
+using namespace std;
+
+namespace BaseSimulator {
+
+//!< @brief Orders modules by identifier
+static inline bool lowerId(const BuildingBlock *a, const BuildingBlock *b) {
+	return a->blockId < b->blockId;
+}
+
+WirelessMedium::WirelessMedium(const map<bID, BuildingBlock*> &blocks) {
+	minSensitivity = 0;
+	for (const auto &it : blocks) {
+		minSensitivity = min(minSensitivity, it.second->getWirelessNetworkInterface()->getReceptionSensitivity());
+	}
+	cellSize = WIRELESSMEDIUM_MIN_CELL_SIZE;
+	for (const auto &it : blocks) {
+		cellSize = max(cellSize, it.second->getWirelessNetworkInterface()->getMaxRange(minSensitivity));
+	}
+	// Blocks are visited by identifier, each one is appended at the end of its cell
+	for (const auto &it : blocks) {
+		uint64_t key = cellKey(it.second);
+		cells[key].push_back(it.second);
+		blockCells[it.first] = key;
+	}
+}
+
+void WirelessMedium::insert(uint64_t key, BuildingBlock *bb) {
+	vector<BuildingBlock*> &cell = cells[key];
+	cell.insert(lower_bound(cell.begin(), cell.end(), bb, lowerId), bb);
+}
+
+void WirelessMedium::remove(uint64_t key, BuildingBlock *bb) {
+	auto itCell = cells.find(key);
+	if (itCell == cells.end()) return;
+	vector<BuildingBlock*> &cell = itCell->second;
+	auto it = lower_bound(cell.begin(), cell.end(), bb, lowerId);
+	if (it != cell.end() && *it == bb) cell.erase(it);
+	if (cell.empty()) cells.erase(itCell);
+}
+
+void WirelessMedium::update(BuildingBlock *bb) {
+	uint64_t key = cellKey(bb);
+	auto it = blockCells.find(bb->blockId);
+	if (it == blockCells.end()) {
+		minSensitivity = min(minSensitivity, bb->getWirelessNetworkInterface()->getReceptionSensitivity());
+		blockCells[bb->blockId] = key;
+		insert(key, bb);
+	} else if (it->second != key) {
+		remove(it->second, bb);
+		it->second = key;
+		insert(key, bb);
+	}
+}
+
+void WirelessMedium::collect(const vector<BuildingBlock*> &cell, BuildingBlock *source, double x, double y,
+							 double range, vector<BuildingBlock*> &receivers) const {
+	double range2 = range * range;
+	for (BuildingBlock *bb : cell) {
+		double dx = bb->position[0] - x, dy = bb->position[1] - y;
+		if (bb != source && dx * dx + dy * dy <= range2) receivers.push_back(bb);
+	}
+}
+
+void WirelessMedium::getReceivers(BuildingBlock *source, vector<BuildingBlock*> &receivers) const {
+	double range = source->getWirelessNetworkInterface()->getMaxRange(minSensitivity);
+	double x = source->position[0], y = source->position[1];
+	receivers.clear();
+
+	// Cells around the source that the range covers, all the non-empty cells when they are fewer
+	double span = ceil(range / cellSize);
+	size_t nbCells = 0;
+	if ((2 * span + 1) * (2 * span + 1) >= (double)cells.size()) {
+		for (const auto &it : cells) {
+			collect(it.second, source, x, y, range, receivers);
+		}
+		nbCells = cells.size();
+	} else {
+		int32_t cx = cellCoordinate(x), cy = cellCoordinate(y), s = (int32_t)span;
+		for (int32_t i = cx - s; i <= cx + s; i++) {
+			for (int32_t j = cy - s; j <= cy + s; j++) {
+				auto it = cells.find(cellKey(i, j));
+				if (it == cells.end()) continue;
+				collect(it->second, source, x, y, range, receivers);
+				nbCells++;
+			}
+		}
+	}
+	// Receivers of a single cell are already sorted
+	if (nbCells > 1) sort(receivers.begin(), receivers.end(), lowerId);
+}
+
+} // namespace BaseSimulator
@@ -0,0 +1,77 @@
+/*! @file wirelessMedium.h
+ * @brief Spatial index of the modules sharing the wireless medium, from which the receivers of a broadcast are
+ *  selected by their distance to the transmitter
+ * @date 17/10/2026
+ */
+
+#ifndef WIRELESSMEDIUM_H__
+#define WIRELESSMEDIUM_H__
+
+#include <cstdint>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "tDefs.h"
+#include "buildingBlock.h"
+
+#define WIRELESSMEDIUM_MIN_CELL_SIZE	1.0 //!< Smallest side (in lattice cells) of a cell of the index
+
+namespace BaseSimulator {
+
+/**
+ * @brief Uniform grid over the positions of the modules in the plane (x, y), as seen by the wireless interfaces,
+ *  whose path loss only depends on the distance in the plane (see WirelessNetworkInterface::startReceive)
+ *
+ *  The side of the cells of the grid is the largest radio range of the modules when the index is built, so that
+ *  the receivers of a transmission are found in the 3x3 cells around the transmitter. Only the cells that hold
+ *  modules are stored. Modules are kept sorted by identifier in each cell, and receivers are returned sorted by
+ *  identifier, so that their reception events are scheduled in the same order as without the index.
+ *
+ *  The index follows the moves of the modules through update, called by BuildingBlock::setPosition.
+ */
+class WirelessMedium {
+	double cellSize; //!< Side of a cell of the grid, in lattice cells
+	std::unordered_map<uint64_t, std::vector<BuildingBlock*>> cells; //!< Modules of each non-empty cell, by key
+	std::unordered_map<bID, uint64_t> blockCells; //!< Key of the cell of each module of the index
+	float minSensitivity; //!< Lowest reception sensitivity (dBm) of the modules of the index
+
+	//!< @brief Returns the coordinate of the cell that holds the coordinate x of a position
+	inline int32_t cellCoordinate(double x) const { return (int32_t)floor(x / cellSize); }
+	//!< @brief Returns the key of the cell of coordinates (cx, cy)
+	static inline uint64_t cellKey(int32_t cx, int32_t cy) { return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy; }
+	//!< @brief Returns the key of the cell that holds the position of bb
+	inline uint64_t cellKey(BuildingBlock *bb) const {
+		return cellKey(cellCoordinate(bb->position[0]), cellCoordinate(bb->position[1]));
+	}
+	//!< @brief Inserts bb in the cell of key, at its rank by identifier
+	void insert(uint64_t key, BuildingBlock *bb);
+	//!< @brief Removes bb from the cell of key
+	void remove(uint64_t key, BuildingBlock *bb);
+	//!< @brief Appends the modules of cell to receivers that are within range of (x, y), except source
+	void collect(const std::vector<BuildingBlock*> &cell, BuildingBlock *source, double x, double y,
+				 double range, std::vector<BuildingBlock*> &receivers) const;
+public:
+	/**
+	 * @brief Builds the index of the modules of a world
+	 * @param blocks : the modules of the world, indexed by their identifiers
+	 */
+	WirelessMedium(const std::map<bID, BuildingBlock*> &blocks);
+
+	//!< @brief Moves bb to the cell of its current position, adds it to the index if it is not there yet
+	void update(BuildingBlock *bb);
+	//!< @brief Returns the number of modules of the index
+	size_t size() const { return blockCells.size(); }
+
+	/**
+	 * @brief Fills receivers with the modules that the transmissions of source can reach, sorted by identifier
+	 * @param source : the transmitting module
+	 * @param receivers : the modules within the radio range of source, source excepted
+	 */
+	void getReceivers(BuildingBlock *source, std::vector<BuildingBlock*> &receivers) const;
+};
+
+} // namespace BaseSimulator
+
+#endif // WIRELESSMEDIUM_H__
@@ -15,11 +15,6 @@ using namespace std;
 
 namespace BaseSimulator {
 
-World *World::world=NULL;
-map<bID, BuildingBlock*>World::buildingBlocksMap;
-vector <GlBlock*>World::tabGlBlocks;
-vector <GlObstacle*>World::tabGlObstacles;
-
 World::World(int argc, char *argv[]) {
 	OUTPUT << "World constructor" << endl;
 	selectedGlBlock = NULL;
@@ -27,10 +22,10 @@ World::World(int argc, char *argv[]) {
 	numSelectedGlBlock=0;
 	menuId = 0;
 
-	if (world == NULL) {
-		world = this;
+	if (SimulationContext::current().world == NULL) {
+		SimulationContext::current().world = this;
 
-		if (GlutContext::GUIisEnabled) {
+		if (GlutContext::isGUIEnabled()) {
 			GlutContext::init(argc,argv);
 			camera = new Camera(-M_PI/2.0,M_PI/3.0,750.0);
 			camera->setLightParameters(Vector3D(0,0,0),45.0,80.0,800.0,45.0,10.0,1500.0);
@@ -43,6 +38,8 @@ World::World(int argc, char *argv[]) {
 }
 
 World::~World() {
+	delete wirelessMedium;
+
 	// free building blocks
 	std::map<bID, BuildingBlock*>::iterator it;
 	for( it = buildingBlocksMap.begin() ; it != buildingBlocksMap.end() ; ++it) {
@@ -155,7 +152,9 @@ void World::disconnectBlock(BuildingBlock *block) {
 	    toBlock = fromBlock->connectedInterface;
 
 	    // Clear message queue
+	    fromBlock->hostBlock->willModify(fromBlock->outgoingQueue);
 	    fromBlock->outgoingQueue.clear();
+	    toBlock->hostBlock->willModify(toBlock->outgoingQueue);
 	    toBlock->outgoingQueue.clear();
 
 	    // Notify respective codeBlocks
@@ -198,6 +197,29 @@ void World::deleteBlock(BuildingBlock *bb) {
     delete bb->ptrGlBlock;
 }
 
+void World::updateWirelessMedium(BuildingBlock *bb) {
+	lock_guard<mutex> lock(mutex_wireless);
+	if (wirelessMedium) wirelessMedium->update(bb);
+}
+
+void World::broadcastWirelessMessage(WirelessMessagePtr msg) {
+	static thread_local vector<BuildingBlock*> receivers; // Reused by the broadcasts of the thread
+	{
+		lock_guard<mutex> lock(mutex_wireless);
+		// Blocks are placed through setPosition, which keeps the medium up to date once built
+		if (wirelessMedium == NULL || wirelessMedium->size() != buildingBlocksMap.size()) {
+			delete wirelessMedium;
+			wirelessMedium = new WirelessMedium(buildingBlocksMap);
+		}
+		wirelessMedium->getReceivers(msg->sourceInterface->hostBlock, receivers);
+	}
+
+	Time date = getScheduler()->now() + WirelessNetworkInterface::getPropagationDelay();
+	for (BuildingBlock *bb : receivers) {
+		getScheduler()->schedule(new WirelessNetworkInterfaceStartReceiveEvent(date, bb->getWirelessNetworkInterface(), msg));
+	}
+}
+
 void World::stopSimulation() {
 	map<bID, BuildingBlock*>::iterator it;
 	for( it = buildingBlocksMap.begin() ; it != buildingBlocksMap.end() ; it++) {
@@ -268,6 +290,10 @@ void World::addObstacle(const Cell3DPosition &firstPos, const Cell3DPosition &se
 	glObstacle->setSecondPosition(secondPosition);
 	glObstacle->setColor(col);
 	tabGlObstacles.push_back(glObstacle);
+	if (!obstacleGrid.addWall(firstPos, secondPos)) {
+		OUTPUT << "obstacle " << firstPos << " - " << secondPos << " is not between adjacent cells, "
+			   << "wireless signals go through it" << endl;
+	}
 }
 
 
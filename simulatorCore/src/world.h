@@ -22,6 +22,9 @@
 #include "lattice.h"
 #include "scheduler.h"
 #include "objLoader.h"
+#include "simulationContext.h"
+#include "wirelessMedium.h"
+#include "obstacleGrid.h"
 
 using namespace BaseSimulator::utils;
 using namespace std;
@@ -34,14 +37,16 @@ namespace BaseSimulator {
  */
 class World {
     std::mutex mutex_gl;
+    std::mutex mutex_wireless; //!< Protects the wireless medium, shared by the workers of the parallel engines
+    WirelessMedium *wirelessMedium = NULL; //!< Spatial index of the wireless interfaces, built by the first broadcast
 protected:
     /************************************************************
-     *   Global variable
+     *   Blocks
      ************************************************************/    
-    static World *world;        //!< Global variable to access the single simulation instance of World 
-    static vector<GlBlock*>tabGlBlocks; //!< A vector containing pointers to all graphical blocks
-    static vector<GlObstacle*>tabGlObstacles; //!< A vector containing pointers to all graphical obstacles
-    static map<bID, BuildingBlock*>buildingBlocksMap; //!< A map containing all BuildingBlocks in the world, indexed by their blockId
+    vector<GlBlock*>tabGlBlocks; //!< A vector containing pointers to all graphical blocks
+    vector<GlObstacle*>tabGlObstacles; //!< A vector containing pointers to all graphical obstacles
+    ObstacleGrid obstacleGrid; //!< Walls of the obstacles, crossed by the wireless signals
+    map<bID, BuildingBlock*>buildingBlocksMap; //!< A map containing all BuildingBlocks in the world, indexed by their blockId
 
     /************************************************************
      *   Graphical / UI Attributes
@@ -80,25 +85,28 @@ class World {
     Lattice *lattice;           //!< The lattice on which the blocks are placed, manages the blocks positions and neighborhoods
 
     /**
-     * @brief Returns the global instance of world, or raises an error if it has not been allocated
+     * @brief Returns the instance of world of the simulation of the calling thread, or raises an error if it has not
+     *  been allocated
      */    
     static World* getWorld() {
+        World *world = SimulationContext::current().world;
         assert(world != NULL);
         return(world);
     }
 
     /**
-     * @brief Sets the value of static world variable
+     * @brief Sets the instance of world of the simulation of the calling thread
      * @param _world pointer to a world instance
      */
     static void setWorld(World *_world) {
-        world = _world;
+        SimulationContext::current().world = _world;
     }
 
     /**
      * @brief Global function to call the world destructor
      */    
     static void deleteWorld() {
+        World *&world = SimulationContext::current().world;
         delete(world);
         world=NULL;
     }
@@ -151,6 +159,12 @@ class World {
      * @param p : Position to set to blc's glBlock
      */
     virtual void updateGlData(BuildingBlock*blc, Vector3D &p);
+    /**
+     * @brief Updates the position of block bb in the wireless medium, if a message has been broadcast already
+     *
+     * @param bb : Block that has been placed or moved
+     */
+    void updateWirelessMedium(BuildingBlock *bb);
     /**
      * @brief Creates a block and adds it to the simulation
      *
@@ -192,6 +206,10 @@ class World {
      * @param col : color of the obstacle
      */
     void addObstacle(const Cell3DPosition &firstPos, const Cell3DPosition &secondPos, const Color &col);
+    /**
+     * @brief Getter for the walls of the obstacles, as seen by the wireless interfaces
+     */
+    const ObstacleGrid& getObstacleGrid() { return obstacleGrid; };
 
     /**
      * @brief Getter for selectedGlBlock
@@ -347,15 +365,15 @@ class World {
      */
     void toggleBackground() { background = !background; }
     
-    void broadcastWirelessMessage(WirelessMessagePtr msg) {
-        std::map<bID, BuildingBlock*>::iterator itMap;
-        bID sourceID = msg->sourceInterface->hostBlock->blockId;
-        for (itMap = buildingBlocksMap.begin(); itMap != buildingBlocksMap.end(); itMap++) {
-            if (itMap->first != sourceID) {
-                BaseSimulator::getScheduler()->schedule(new WirelessNetworkInterfaceStartReceiveEvent(BaseSimulator::getScheduler()->now(), itMap->second->getWirelessNetworkInterface(), msg));
-            }
-        }
-    }
+    /**
+     * @brief Starts the reception of msg by the wireless interfaces within the radio range of its source
+     *
+     *  Receivers are selected through a spatial index of the blocks (see WirelessMedium), blocks out of range would
+     *  not sense the message. Reception events are scheduled by increasing block id.
+     *
+     * @param msg : message sent by msg->sourceInterface
+     */
+    void broadcastWirelessMessage(WirelessMessagePtr msg);
 
 };
 
@@ -2,8 +2,14 @@
 
 usage() {
     echo "Usage: $0 <test-ID> <path-to-blockCode-binary> <VisibleSim-arguments>"
+    echo "       $0 -e [-m <percent>] [-v] [-i] <test-ID> <path-to-blockCode-binary> <VisibleSim-arguments> -- <tested-arguments>"
     echo "Example: $0 bbCycle ../applicationsBin/bbCycle -c config123.xml -s 9000000"
+    echo "Example: $0 -e bbCycleP4 ../applicationsBin/bbCycle -a 1 -s 9000000 -- -P 4"
     echo "Test-ID can be used to distinguish between 2 control XML files from the same directory"
+    echo "With -e, the numbers of events and messages processed with the tested arguments are compared to the ones of"
+    echo "the sequential reference simulation (-q map). With -m, the peak memory usage of the tested simulation must not"
+    echo "exceed the one of the reference by more than percent %. With -v, the tested simulation must follow the event"
+    echo "trace of the reference (-Y, -V). With -i, the statistics per module (-i) must be the same, timings excluded"
     exit 1
 }
 
@@ -25,6 +31,80 @@ print_result() {
     exit 0
 }
 
+# Runs the BlockCode in test mode with the common arguments followed by $@, and reads from its output its numbers
+# of events and messages processed, its peak memory usage (kB) and its statistics per module, timings excluded.
+# Fails if the simulation fails or reports an error (a divergence from an event trace, for instance)
+simulate() {
+    output=$(cd "$bcDir" && ./"$bcName" "${common[@]}" -t "$@" 2>&1)
+    [ $? != 0 ] && return 1
+    echo "$output" | grep -q "^error:" && return 1
+    events=$(echo "$output" | sed -n 's/^Number of events processed: \([0-9]*\).*/\1/p')
+    messages=$(echo "$output" | sed -n 's/^Number of messages processed: \([0-9]*\).*/\1/p')
+    memory=$(echo "$output" | sed -n 's/^Peak memory usage: \([0-9]*\) kB.*/\1/p')
+    modules=$(echo "$output" | sed -n '/^=== STATISTICS PER MODULE ===/,/^=== HOTSPOT MODULES ===/p' | \
+        grep -v "processing time")
+    [ -n "$events" ]
+}
+
+# Event count mode: compare the tested arguments to the sequential reference
+if [ "$1" == "-e" ]; then
+    shift
+    memoryMargin=""
+    verify=false
+    stats=()
+    while [ $# -gt 0 ]; do
+        case "$1" in
+            -m ) memoryMargin="$2"; shift 2;;
+            -v ) verify=true; shift;;
+            -i ) stats=(-i); shift;;
+            * ) break;;
+        esac
+    done
+    [ $# -lt 2 ] && usage
+    if [ ! -x "$2" ]; then
+        echo "error: invalid BlockCode $2"
+        exit 1
+    fi
+
+    testID="$1"
+    bcDir="$(dirname $2)"
+    bcName="$(basename $2)"
+    shift 2
+
+    common=()
+    while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+        common+=("$1")
+        shift
+    done
+    [ "$1" == "--" ] && shift
+
+    record=()
+    check=()
+    if [ $verify == true ]; then
+        trace=".test_$testID.vstr"
+        record=(-Y "$trace")
+        check=(-V "$trace")
+    fi
+
+    simulate -q map "${stats[@]}" "${record[@]}" || print_result "$testID" false
+    refEvents=$events
+    refMessages=$messages
+    refMemory=$memory
+    refModules=$modules
+    simulate "$@" "${stats[@]}" "${check[@]}"
+    status=$?
+    [ $verify == true ] && rm -f "$bcDir/$trace"
+    [ $status != 0 ] && print_result "$testID" false
+
+    if [ "$refEvents" != "$events" ] || [ "$refMessages" != "$messages" ] || [ "$refModules" != "$modules" ]; then
+        print_result "$testID" false
+    fi
+    if [ -n "$memoryMargin" ] && [ "$memory" -gt $(( refMemory * (100 + memoryMargin) / 100 )) ]; then
+        print_result "$testID" false
+    fi
+    print_result "$testID" true
+fi
+
 # Check parameters and parse potential arguments
 [ $# -lt 2 ] && usage
 
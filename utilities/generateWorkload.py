@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Generates the configuration of a synthetic workload for the end-to-end benchmarks.
+
+The world is a cube of modules (bb: Blinky Blocks, c3d: Catoms3D), or a square of robots on the ground
+(mr: Multi Robots), of the requested number of modules. With a density of 1, the modules fill a compact
+cube (or square), as with generateCubicConfig.py. With a lower density, they are spread at random over a
+larger one, in which density is the fraction of occupied cells, so that modules have fewer neighbors.
+
+Robots move in a maze, generated as by applicationsBin/MRMaze/mazegen (a perfect maze over the cells of the
+square): its walls are the obstacles of the world, which attenuate the wireless signals that cross them.
+
+The workload element is read by the block codes of applicationsSrc/workload (bbWorkload, c3dWorkload and
+mrWorkload): every module emits rate messages per second of simulated time, and each message travels hops
+hops, to random neighbors (bb, c3d) or to random robots through the wireless interface (mr).
+
+Example: python3 generateWorkload.py bb 100000 -d 0.5 -r 10 -H 4 -o ../applicationsBin/bbWorkload/big.xml
+"""
+
+import argparse
+import math
+import random
+import sys
+
+MODULES = ('bb', 'c3d', 'mr')
+WALL_ATTENUATION = 12  # dB per wall crossed by a wireless signal, as in the worlds of mazegen
+
+
+def worldSize(module, n, density):
+    """Returns the size (x, y, z) of the grid holding n modules with the given density."""
+    cells = int(math.ceil(n / density))
+    if module == 'mr':
+        side = int(math.ceil(math.sqrt(cells)))
+        while side * side < n:
+            side += 1
+        return (side, side, 1)
+    side = int(math.ceil(round(cells ** (1.0 / 3), 6)))
+    while side ** 3 < n:
+        side += 1
+    return (side, side, side)
+
+
+def positions(size, n, density, seed):
+    """Returns the positions of the n modules, in the order of the grid cells (x, then y, then z)."""
+    sx, sy, sz = size
+    if density >= 1:
+        cells = range(n)
+    else:
+        cells = sorted(random.Random(seed).sample(range(sx * sy * sz), n))
+    for c in cells:
+        yield (c // (sy * sz), (c // sz) % sy, c % sz) if sz > 1 else (c // sy, c % sy, 0)
+
+
+def mazeWalls(size, seed):
+    """Returns the walls (pairs of adjacent cells) of a perfect maze over the cells of the square of the given size.
+
+    Same algorithm as pMaze::gen in mazegen: a depth-first walk from cell (0, 0), knocking down the wall towards
+    a random unvisited neighbor, or backtracking when there is none, until every cell has been visited.
+    """
+    sx, sy = size[0], size[1]
+    rnd = random.Random(seed)
+    walls = set()
+    for x in range(sx):
+        for y in range(sy):
+            if x + 1 < sx:
+                walls.add(((x, y), (x + 1, y)))
+            if y + 1 < sy:
+                walls.add(((x, y), (x, y + 1)))
+    visited = {(0, 0)}
+    stack = [(0, 0)]
+    while stack:
+        x, y = stack[-1]
+        unvisited = [c for c in ((x + 1, y), (x, y + 1), (x, y - 1), (x - 1, y))
+                     if 0 <= c[0] < sx and 0 <= c[1] < sy and c not in visited]
+        if not unvisited:
+            stack.pop()
+            continue
+        c = unvisited[rnd.randrange(len(unvisited))]
+        walls.discard((min((x, y), c), max((x, y), c)))
+        visited.add(c)
+        stack.append(c)
+    return sorted(walls)
+
+
+def generate(out, module, n, density=1.0, rate=1.0, hops=1, seed=1, maze=True):
+    """Writes the configuration of a workload to the file object out."""
+    size = worldSize(module, n, density)
+    out.write('<?xml version="1.0" standalone="no" ?>\n')
+    out.write('<world gridSize="%d,%d,%d" windowSize="1800,900">\n' % size)
+    out.write('\t<workload rate="%g" hops="%d"/>\n' % (rate, hops))
+    out.write('\t<blockList color="128,128,128" ids="ORDERED">\n')
+    for p in positions(size, n, density, seed):
+        out.write('\t\t<block position="%d,%d,%d"/>\n' % p)
+    out.write('\t</blockList>\n')
+    if module == 'mr' and maze:
+        out.write('\t<wireless wallAttenuation="%d"/>\n' % WALL_ATTENUATION)
+        out.write('\t<obstacleList color="255,0,0">\n')
+        for a, b in mazeWalls(size, seed):
+            out.write('\t\t<obstacle firstCell="%d,%d,0" secondCell="%d,%d,0"/>\n' % (a + b))
+        out.write('\t</obstacleList>\n')
+    out.write('</world>\n')
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Generates the configuration of a synthetic workload.')
+    parser.add_argument('module', choices=MODULES, help='module type: bb (Blinky Blocks), c3d (Catoms3D), '
+                        'mr (Multi Robots)')
+    parser.add_argument('blocks', type=int, help='number of modules')
+    parser.add_argument('-d', '--density', type=float, default=1.0,
+                        help='fraction of the cells of the world occupied by modules, in ]0, 1] (default 1)')
+    parser.add_argument('-r', '--rate', type=float, default=1.0,
+                        help='messages emitted per module and per second of simulated time (default 1)')
+    parser.add_argument('-H', '--hops', type=int, default=1, help='hops of each message (default 1)')
+    parser.add_argument('-s', '--seed', type=int, default=1,
+                        help='seed of the placement of the modules and of the maze (default 1)')
+    parser.add_argument('--no-maze', dest='maze', action='store_false',
+                        help='mr worlds without walls, in which every signal travels unobstructed')
+    parser.add_argument('-o', '--output', default='config.xml', help='output file (default config.xml)')
+    args = parser.parse_args(argv[1:])
+
+    if args.blocks < 1 or not 0 < args.density <= 1 or args.rate < 0 or args.hops < 1:
+        parser.error('expected at least one module, a density in ]0, 1], a positive rate and at least one hop')
+
+    with open(args.output, 'w') as out:
+        generate(out, args.module, args.blocks, args.density, args.rate, args.hops, args.seed, args.maze)
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Runs the synthetic workloads of the end-to-end benchmarks, and records their throughput and memory.
+
+For each module type and each size, generates a configuration with generateWorkload.py, runs the matching
+block code (applicationsBin/<module>Workload, built by make) in terminal mode for the requested simulated
+duration, and writes one line per run to a CSV file:
+- module, blocks, density, rate, hops, duration: parameters of the workload (duration in us)
+- events, messages: events and point-to-point messages processed, as reported by the simulator
+- run_s, events_per_s: wall-clock time of the scheduler, and events processed per second of it
+- total_s: wall-clock time of the whole process, including the loading of the configuration
+- peak_rss_mb: peak resident memory of the process (MB)
+- status: exit status of the process
+
+Build the simulator core and the workloads with the production flags (-O3 -DNDEBUG) for meaningful measures.
+
+Example: python3 runWorkloads.py -m bb c3d -n 1000 10000 100000 -d 0.5 -r 10 -H 4 -t 2000000 -o results.csv
+"""
+
+import argparse
+import csv
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+import generateWorkload
+
+BIN_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'applicationsBin')
+APPS = {'bb': 'bbWorkload', 'c3d': 'c3dWorkload', 'mr': 'mrWorkload'}
+FIELDS = ['module', 'blocks', 'density', 'rate', 'hops', 'duration', 'events', 'messages', 'run_s',
+          'events_per_s', 'total_s', 'peak_rss_mb', 'status']
+
+STATS = {
+    'events': re.compile(r'Number of events processed: (\d+)'),
+    'messages': re.compile(r'Number of messages processed: (\d+)'),
+    'run_us': re.compile(r'Real elapsed time: ([\d.]+) us'),
+}
+
+
+def run(module, config, duration, seed, extra):
+    """Runs the workload of config, returns the statistics of the run."""
+    app = os.path.join(BIN_DIR, APPS[module])
+    cmd = ['./' + APPS[module], '-t', '-s', str(duration), '-a', str(seed), '-c', config] + extra
+    start = time.time()
+    proc = subprocess.Popen(cmd, cwd=app, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    stats = {}
+    # The output of large worlds is long: only the statistics are kept
+    for line in proc.stdout:
+        for key, pattern in STATS.items():
+            m = pattern.search(line)
+            if m:
+                stats[key] = float(m.group(1))
+    # wait4 returns the resources used by this process only, ru_maxrss is in KB on Linux and in bytes on macOS
+    _, status, usage = os.wait4(proc.pid, 0)
+    proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+    rss = usage.ru_maxrss / (1024.0 * 1024 if sys.platform == 'darwin' else 1024.0)
+
+    runSeconds = stats.get('run_us', 0) / 1e6
+    return {
+        'events': int(stats.get('events', 0)),
+        'messages': int(stats.get('messages', 0)),
+        'run_s': '%.3f' % runSeconds,
+        'events_per_s': '%.0f' % (stats.get('events', 0) / runSeconds if runSeconds > 0 else 0),
+        'total_s': '%.3f' % (time.time() - start),
+        'peak_rss_mb': '%.1f' % rss,
+        'status': proc.returncode,
+    }
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Runs synthetic workloads and records events/s and peak RSS.',
+                                     epilog='Arguments after -- are passed to the simulator (e.g. -- -q calendar)')
+    parser.add_argument('-m', '--modules', nargs='+', choices=sorted(APPS), default=['bb'],
+                        help='module types (default bb)')
+    parser.add_argument('-n', '--blocks', nargs='+', type=int, default=[1000, 10000],
+                        help='numbers of modules (default 1000 10000)')
+    parser.add_argument('-d', '--density', type=float, default=1.0, help='density of the worlds (default 1)')
+    parser.add_argument('-r', '--rate', type=float, default=1.0,
+                        help='messages emitted per module and per second (default 1)')
+    parser.add_argument('-H', '--hops', type=int, default=1, help='hops of each message (default 1)')
+    parser.add_argument('-t', '--duration', type=int, default=10000000,
+                        help='simulated duration (us, default 10000000)')
+    parser.add_argument('-s', '--seed', type=int, default=1, help='seed of the worlds and simulations (default 1)')
+    parser.add_argument('-o', '--output', default='workloads.csv', help='results file (default workloads.csv)')
+    if '--' in argv:
+        extra = argv[argv.index('--') + 1:]
+        argv = argv[:argv.index('--')]
+    else:
+        extra = []
+    args = parser.parse_args(argv[1:])
+
+    for module in args.modules:
+        if not os.path.exists(os.path.join(BIN_DIR, APPS[module], APPS[module])):
+            parser.error('%s is not built, run make first' % APPS[module])
+
+    with open(args.output, 'w') as out:
+        writer = csv.DictWriter(out, fieldnames=FIELDS)
+        writer.writeheader()
+        for module in args.modules:
+            for n in args.blocks:
+                fd, config = tempfile.mkstemp(prefix='workload_', suffix='.xml')
+                try:
+                    with os.fdopen(fd, 'w') as f:
+                        generateWorkload.generate(f, module, n, args.density, args.rate, args.hops, args.seed)
+                    r = run(module, config, args.duration, args.seed, extra)
+                finally:
+                    os.remove(config)
+                r.update({'module': module, 'blocks': n, 'density': args.density, 'rate': args.rate,
+                          'hops': args.hops, 'duration': args.duration})
+                writer.writerow(r)
+                out.flush()
+                print('%-4s %8d blocks: %10d events, %10s events/s, peak RSS %8s MB%s'
+                      % (module, n, r['events'], r['events_per_s'], r['peak_rss_mb'],
+                         '' if r['status'] == 0 else ' (exit status %d)' % r['status']))
+
+
+if __name__ == '__main__':
+    main(sys.argv)